@@ -26,14 +26,22 @@
 #include <stdlib.h>
 #include <string.h>
 #include "filesystem.h"
+#include "shell_cmd_list.h"
+#include "kv_store.h"
 #include "watch.h"
 #include "lfs.h"
 #include "base64.h"
 #include "delay.h"
+#ifdef FILESYSTEM_EXTERNAL_FLASH
+#include "spiflash.h"
+#endif
 
 #ifndef min
 #define min(x, y) ((x) > (y) ? (y) : (x))
 #endif
+#ifndef max
+#define max(x, y) ((x) > (y) ? (x) : (y))
+#endif
 
 int lfs_storage_read(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size);
 int lfs_storage_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size);
@@ -60,7 +68,26 @@ int lfs_storage_sync(const struct lfs_config *cfg) {
     return !watch_storage_sync();
 }
 
-const struct lfs_config watch_lfs_cfg = {
+// littlefs tuning; utils/fs_benchmark measures other values against typical workloads.
+#ifndef FILESYSTEM_READ_SIZE
+#define FILESYSTEM_READ_SIZE 16
+#endif
+#ifndef FILESYSTEM_CACHE_SIZE
+#define FILESYSTEM_CACHE_SIZE NVMCTRL_PAGE_SIZE
+#endif
+#ifndef FILESYSTEM_LOOKAHEAD_SIZE
+#define FILESYSTEM_LOOKAHEAD_SIZE 16
+#endif
+#ifndef FILESYSTEM_BLOCK_CYCLES
+#define FILESYSTEM_BLOCK_CYCLES 100
+#endif
+
+// The last rows of the storage area hold the key/value store. Filesystems formatted before it existed span
+// all rows, and are mounted that way until they are formatted again.
+#define FILESYSTEM_BLOCK_COUNT (NVMCTRL_RWWEE_PAGES / 4 - KV_STORE_ROWS)
+#define FILESYSTEM_LEGACY_BLOCK_COUNT (NVMCTRL_RWWEE_PAGES / 4)
+
+struct lfs_config watch_lfs_cfg = {
     // block device operations
     .read  = lfs_storage_read,
     .prog  = lfs_storage_prog,
@@ -68,19 +95,119 @@ const struct lfs_config watch_lfs_cfg = {
     .sync  = lfs_storage_sync,
 
     // block device configuration
-    .read_size = 16,
+    .read_size = FILESYSTEM_READ_SIZE,
     .prog_size = NVMCTRL_PAGE_SIZE,
     .block_size = NVMCTRL_ROW_SIZE,
-    .block_count = NVMCTRL_RWWEE_PAGES / 4,
-    .cache_size = NVMCTRL_PAGE_SIZE,
-    .lookahead_size = 16,
-    .block_cycles = 100,
+    .block_count = FILESYSTEM_BLOCK_COUNT,
+    .cache_size = FILESYSTEM_CACHE_SIZE,
+    .lookahead_size = FILESYSTEM_LOOKAHEAD_SIZE,
+    .block_cycles = FILESYSTEM_BLOCK_CYCLES,
 };
 
 lfs_t eeprom_filesystem;
+
+#ifdef FILESYSTEM_EXTERNAL_FLASH
+
+// The SPI flash is erased in 4 KB sectors and programmed in pages of up to 256 bytes. Its caches are a page,
+// so that littlefs reads and programs whole pages in one transaction.
+#define FILESYSTEM_EXTERNAL_MOUNT "/ext"
+#define FILESYSTEM_EXTERNAL_BLOCK_SIZE 4096
+#define FILESYSTEM_EXTERNAL_PAGE_SIZE 256
+#define FILESYSTEM_EXTERNAL_CACHE_SIZE FILESYSTEM_EXTERNAL_PAGE_SIZE
+#define FILESYSTEM_EXTERNAL_HANDLE_CACHE_SIZE max(FILESYSTEM_CACHE_SIZE, FILESYSTEM_EXTERNAL_CACHE_SIZE)
+
+static int lfs_external_read(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size) {
+    return spi_flash_read_data(block * cfg->block_size + off, buffer, size) ? 0 : LFS_ERR_IO;
+}
+
+static int lfs_external_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size) {
+    uint32_t address = block * cfg->block_size + off;
+    const uint8_t *data = buffer;
+
+    // a page program wraps around at the end of its page, so programs that cross one are split.
+    while (size > 0) {
+        lfs_size_t length = min(size, FILESYSTEM_EXTERNAL_PAGE_SIZE - address % FILESYSTEM_EXTERNAL_PAGE_SIZE);
+        if (!spi_flash_command(CMD_ENABLE_WRITE) || !spi_flash_write_data(address, (uint8_t *)data, length) || !spi_flash_wait_until_ready()) {
+            return LFS_ERR_IO;
+        }
+        address += length;
+        data += length;
+        size -= length;
+    }
+    return 0;
+}
+
+static int lfs_external_erase(const struct lfs_config *cfg, lfs_block_t block) {
+    if (!spi_flash_command(CMD_ENABLE_WRITE) || !spi_flash_sector_command(CMD_SECTOR_ERASE, block * cfg->block_size)) return LFS_ERR_IO;
+    return spi_flash_wait_until_ready() ? 0 : LFS_ERR_IO;
+}
+
+static int lfs_external_sync(const struct lfs_config *cfg) {
+    (void) cfg;
+    return 0;
+}
+
+static struct lfs_config external_lfs_cfg = {
+    .read  = lfs_external_read,
+    .prog  = lfs_external_prog,
+    .erase = lfs_external_erase,
+    .sync  = lfs_external_sync,
+
+    .read_size = 16,
+    .prog_size = 16,
+    .block_size = FILESYSTEM_EXTERNAL_BLOCK_SIZE,
+    .block_count = 0,           // from the JEDEC ID when mounting
+    .cache_size = FILESYSTEM_EXTERNAL_CACHE_SIZE,
+    .lookahead_size = 32,
+    .block_cycles = 500,
+};
+
+static lfs_t external_filesystem;
+static bool external_mounted;
+
+#endif
+
 static lfs_file_t file;
 static struct lfs_info info;
 
+static void _filesystem_close_all(void);
+
+/// Returns the volume that a path is on, and advances the path past the mount point of the external one.
+static lfs_t *_filesystem_volume(const char **path) {
+#ifdef FILESYSTEM_EXTERNAL_FLASH
+    size_t length = strlen(FILESYSTEM_EXTERNAL_MOUNT);
+    if (external_mounted && strncmp(*path, FILESYSTEM_EXTERNAL_MOUNT, length) == 0 && ((*path)[length] == '/' || (*path)[length] == '\0')) {
+        *path = (*path)[length] ? *path + length : "/";
+        return &external_filesystem;
+    }
+#endif
+    return &eeprom_filesystem;
+}
+
+// Writes refuse to start when no more than this many bytes are free.
+#define FILESYSTEM_RESERVED_SPACE 256
+
+// Walking the filesystem for its block usage reads every metadata pair and file, so the count is kept
+// between calls. used_blocks is exact after a walk. Writes and appends only add their worst case to it
+// and clear used_blocks_exact, so that it stays an upper bound and the free space check before the next
+// write needs no walk until space runs low. Anything that may free or relocate blocks invalidates it.
+static uint32_t used_blocks;
+static bool used_blocks_known;
+static bool used_blocks_exact;
+
+// Small appends are collected here, one page per file, and written with a single program when the page fills,
+// on filesystem_sync, or as soon as the file is read, rewritten or removed. Appends that fail to write stay here.
+#define FILESYSTEM_WRITE_BEHIND_FILES 2
+#define FILESYSTEM_WRITE_BEHIND_NAME_MAX 23
+
+typedef struct {
+    char filename[FILESYSTEM_WRITE_BEHIND_NAME_MAX + 1];   // empty if the slot is free
+    uint8_t length;
+    uint8_t data[NVMCTRL_PAGE_SIZE];
+} filesystem_pending_append_t;
+
+static filesystem_pending_append_t pending_appends[FILESYSTEM_WRITE_BEHIND_FILES];
+
 static int _traverse_df_cb(void *p, lfs_block_t block) {
     (void) block;
 	uint32_t *nb = p;
@@ -88,16 +215,55 @@ static int _traverse_df_cb(void *p, lfs_block_t block) {
 	return 0;
 }
 
-int32_t filesystem_get_free_space(void) {
-	int err;
+static int _filesystem_count_used_blocks(void) {
+    if (used_blocks_known && used_blocks_exact) return 0;
 
-	uint32_t free_blocks = 0;
-	err = lfs_fs_traverse(&eeprom_filesystem, _traverse_df_cb, &free_blocks);
+    uint32_t blocks = 0;
+    int err = lfs_fs_traverse(&eeprom_filesystem, _traverse_df_cb, &blocks);
+    if (err < 0) return err;
+
+    used_blocks = blocks;
+    used_blocks_known = true;
+    used_blocks_exact = true;
+    return 0;
+}
+
+static void _filesystem_invalidate_free_space(void) {
+    used_blocks_known = false;
+}
+
+static void _filesystem_account_write(lfs_t *lfs, int32_t length) {
+    // only the internal volume is small enough to need the bookkeeping.
+    if (lfs != &eeprom_filesystem) return;
+
+    // new data blocks, plus one for the copy of a partially filled last block and one for the CTZ
+    // skip-list pointers. Metadata commits stay within their pair unless it is compacted or relocated,
+    // which at worst moves it to two new blocks and frees the old ones.
+    used_blocks += length / watch_lfs_cfg.block_size + 2;
+    used_blocks_exact = false;
+}
+
+static bool _filesystem_has_room(lfs_t *lfs) {
+    if (lfs != &eeprom_filesystem) return true;
+
+    // the upper bound on the usage is enough to let most writes through; count exactly before refusing one.
+    if (used_blocks_known && (watch_lfs_cfg.block_count - min(used_blocks, watch_lfs_cfg.block_count)) * watch_lfs_cfg.block_size > FILESYSTEM_RESERVED_SPACE) {
+        return true;
+    }
+    return filesystem_get_free_space() > FILESYSTEM_RESERVED_SPACE;
+}
+
+uint32_t filesystem_get_block_count(void) {
+    return watch_lfs_cfg.block_count;
+}
+
+int32_t filesystem_get_free_space(void) {
+	int err = _filesystem_count_used_blocks();
 	if(err < 0){
 		return err;
 	}
 
-	uint32_t available = watch_lfs_cfg.block_count * watch_lfs_cfg.block_size - free_blocks * watch_lfs_cfg.block_size;
+	uint32_t available = watch_lfs_cfg.block_count * watch_lfs_cfg.block_size - used_blocks * watch_lfs_cfg.block_size;
 
 	return (int32_t)available;
 }
@@ -139,8 +305,37 @@ static int filesystem_ls(lfs_t *lfs, const char *path) {
     return 0;
 }
 
+#ifdef FILESYSTEM_EXTERNAL_FLASH
+static void _filesystem_mount_external(void) {
+    uint8_t jedec_id[3] = {0};
+
+    spi_flash_init();
+    spi_flash_command(CMD_WAKE);
+    // without a chip, MISO reads all zeros or all ones; the third byte is the log2 of the capacity.
+    if (!spi_flash_read_command(CMD_READ_JEDEC_ID, jedec_id, sizeof(jedec_id)) ||
+        jedec_id[0] == 0x00 || jedec_id[0] == 0xFF || jedec_id[2] < 16 || jedec_id[2] > 24) {
+        return;
+    }
+
+    external_lfs_cfg.block_count = (1ul << jedec_id[2]) / FILESYSTEM_EXTERNAL_BLOCK_SIZE;
+    int err = lfs_mount(&external_filesystem, &external_lfs_cfg);
+    if (err < 0) {
+        printf("Formatting " FILESYSTEM_EXTERNAL_MOUNT "...\r\n");
+        err = lfs_format(&external_filesystem, &external_lfs_cfg);
+        if (err == LFS_ERR_OK) err = lfs_mount(&external_filesystem, &external_lfs_cfg);
+    }
+    external_mounted = (err == LFS_ERR_OK);
+}
+#endif
+
 bool filesystem_init(void) {
+    _filesystem_invalidate_free_space();
     int err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+    if (err < 0) {
+        watch_lfs_cfg.block_count = FILESYSTEM_LEGACY_BLOCK_COUNT;
+        err = lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+        if (err < 0) watch_lfs_cfg.block_count = FILESYSTEM_BLOCK_COUNT;
+    }
 
     // reformat if we can't mount the filesystem
     // this should only happen on the first boot
@@ -152,16 +347,24 @@ bool filesystem_init(void) {
         printf("Filesystem mounted with %ld bytes free.\r\n", filesystem_get_free_space());
     }
 
+#ifdef FILESYSTEM_EXTERNAL_FLASH
+    _filesystem_mount_external();
+#endif
+
     return err == LFS_ERR_OK;
 }
 
 int _filesystem_format(void);
 int _filesystem_format(void) {
+    _filesystem_invalidate_free_space();
+    _filesystem_close_all();
+    memset(pending_appends, 0, sizeof(pending_appends));
     int err = lfs_unmount(&eeprom_filesystem);
     if (err < 0) {
         printf("Couldn't unmount - continuing to format, but you should reboot afterwards!\r\n");
     }
 
+    watch_lfs_cfg.block_count = FILESYSTEM_BLOCK_COUNT;
     err = lfs_format(&eeprom_filesystem, &watch_lfs_cfg);
     if (err < 0) return err;
 
@@ -171,17 +374,74 @@ int _filesystem_format(void) {
     return 0;
 }
 
-bool filesystem_file_exists(char *filename) {
+static filesystem_pending_append_t *_filesystem_find_pending(const char *filename) {
+    for (uint8_t i = 0; i < FILESYSTEM_WRITE_BEHIND_FILES; i++) {
+        if (pending_appends[i].filename[0] && strcmp(pending_appends[i].filename, filename) == 0) return &pending_appends[i];
+    }
+    return NULL;
+}
+
+static bool _filesystem_append_now(char *filename, char *text, int32_t length);
+
+/// Writes out the buffered appends of a slot. If that fails, they stay buffered, so a later flush can retry.
+static bool _filesystem_flush_pending(filesystem_pending_append_t *pending) {
+    if (pending == NULL || !pending->filename[0]) return true;
+
+    if (!_filesystem_append_now(pending->filename, (char *)pending->data, pending->length)) return false;
+    pending->filename[0] = '\0';
+    pending->length = 0;
+    return true;
+}
+
+/// Drops buffered appends to a file that is about to be truncated or removed. Returns true if there were any.
+static bool _filesystem_discard_pending(const char *filename) {
+    filesystem_pending_append_t *pending = _filesystem_find_pending(filename);
+    if (pending == NULL) return false;
+
+    pending->filename[0] = '\0';
+    pending->length = 0;
+    return true;
+}
+
+bool filesystem_sync(void) {
+    bool success = true;
+    for (uint8_t i = 0; i < FILESYSTEM_WRITE_BEHIND_FILES; i++) {
+        success = _filesystem_flush_pending(&pending_appends[i]) && success;
+    }
+    return success;
+}
+
+bool filesystem_flush(char *filename) {
+    return _filesystem_flush_pending(_filesystem_find_pending(filename));
+}
+
+/// Writes out the buffered appends to a file and reads its metadata into info. Returns false if the file does
+/// not exist or its appends could not be written, so that callers never read a file without them.
+static bool _filesystem_stat(char *filename) {
+    if (!_filesystem_flush_pending(_filesystem_find_pending(filename))) return false;
+    const char *path = filename;
+    lfs_t *lfs = _filesystem_volume(&path);
     info.type = 0;
-    lfs_stat(&eeprom_filesystem, filename, &info);
+    lfs_stat(lfs, path, &info);
     return info.type == LFS_TYPE_REG;
 }
 
+bool filesystem_file_exists(char *filename) {
+    if (_filesystem_stat(filename)) return true;
+    // a file whose appends could not be written out yet still exists, at least in the buffer.
+    return _filesystem_find_pending(filename) != NULL;
+}
+
 bool filesystem_rm(char *filename) {
-    info.type = 0;
-    lfs_stat(&eeprom_filesystem, filename, &info);
+    bool was_buffered = _filesystem_discard_pending(filename);
     if (filesystem_file_exists(filename)) {
-        return lfs_remove(&eeprom_filesystem, filename) == LFS_ERR_OK;
+        const char *path = filename;
+        lfs_t *lfs = _filesystem_volume(&path);
+        _filesystem_invalidate_free_space();
+        return lfs_remove(lfs, path) == LFS_ERR_OK;
+    } else if (was_buffered) {
+        // the file only existed in the write-behind buffer.
+        return true;
     } else {
         printf("rm: %s: No such file\r\n", filename);
         return false;
@@ -189,8 +449,8 @@ bool filesystem_rm(char *filename) {
 }
 
 int32_t filesystem_get_file_size(char *filename) {
-    if (filesystem_file_exists(filename)) {
-        return info.size; // info struct was just populated by filesystem_file_exists
+    if (_filesystem_stat(filename)) {
+        return info.size; // info struct was just populated by _filesystem_stat
     }
 
     return -1;
@@ -200,11 +460,13 @@ bool filesystem_read_file(char *filename, char *buf, int32_t length) {
     memset(buf, 0, length);
     int32_t file_size = filesystem_get_file_size(filename);
     if (file_size > 0) {
-        int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_RDONLY);
+        const char *path = filename;
+        lfs_t *lfs = _filesystem_volume(&path);
+        int err = lfs_file_open(lfs, &file, path, LFS_O_RDONLY);
         if (err < 0) return false;
-        err = lfs_file_read(&eeprom_filesystem, &file, buf, min(length, file_size));
+        err = lfs_file_read(lfs, &file, buf, min(length, file_size));
         if (err < 0) return false;
-        return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK;
+        return lfs_file_close(lfs, &file) == LFS_ERR_OK;
     }
 
     return false;
@@ -214,11 +476,13 @@ bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t le
     memset(buf, 0, length + 1);
     int32_t file_size = filesystem_get_file_size(filename);
     if (file_size > 0) {
-        int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_RDONLY);
+        const char *path = filename;
+        lfs_t *lfs = _filesystem_volume(&path);
+        int err = lfs_file_open(lfs, &file, path, LFS_O_RDONLY);
         if (err < 0) return false;
-        err = lfs_file_seek(&eeprom_filesystem, &file, *offset, LFS_SEEK_SET);
+        err = lfs_file_seek(lfs, &file, *offset, LFS_SEEK_SET);
         if (err < 0) return false;
-        err = lfs_file_read(&eeprom_filesystem, &file, buf, min(length - 1, file_size - *offset));
+        err = lfs_file_read(lfs, &file, buf, min(length - 1, file_size - *offset));
         if (err < 0) return false;
         for(int i = 0; i < length; i++) {
             (*offset)++;
@@ -227,101 +491,316 @@ bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t le
                 break;
             }
         }
-        return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK;
+        return lfs_file_close(lfs, &file) == LFS_ERR_OK;
     }
 
     return false;
 }
 
-static void filesystem_cat(char *filename) {
-    info.type = 0;
-    lfs_stat(&eeprom_filesystem, filename, &info);
-    if (filesystem_file_exists(filename)) {
-        if (info.size > 0) {
-            char *buf = malloc(info.size + 1);
-            filesystem_read_file(filename, buf, info.size);
-            buf[info.size] = '\0';
-            printf("%s\r\n", buf);
-            free(buf);
-        } else {
-            printf("\r\n");
+#ifdef FILESYSTEM_EXTERNAL_FLASH
+#define FILESYSTEM_HANDLE_CACHE_SIZE FILESYSTEM_EXTERNAL_HANDLE_CACHE_SIZE
+#else
+#define FILESYSTEM_HANDLE_CACHE_SIZE FILESYSTEM_CACHE_SIZE
+#endif
+
+struct filesystem_file {
+    lfs_t *lfs;
+    lfs_file_t file;
+    struct lfs_file_config config;
+    uint8_t cache[FILESYSTEM_HANDLE_CACHE_SIZE];    // littlefs' file cache, so that opening a file does not allocate
+    uint8_t buffer[FILESYSTEM_READ_AHEAD];
+    int32_t position;                           // offset in the file of buffer[0]
+    uint8_t head;                               // next byte to return from buffer
+    uint8_t fill;                               // bytes in buffer
+    bool in_use;
+};
+
+static filesystem_file_t open_files[FILESYSTEM_MAX_OPEN_FILES];
+
+filesystem_file_t *filesystem_open(char *filename) {
+    if (!_filesystem_stat(filename)) return NULL;
+
+    for (uint8_t i = 0; i < FILESYSTEM_MAX_OPEN_FILES; i++) {
+        filesystem_file_t *file = &open_files[i];
+        if (file->in_use) continue;
+
+        const char *path = filename;
+        file->lfs = _filesystem_volume(&path);
+        memset(&file->config, 0, sizeof(file->config));
+        file->config.buffer = file->cache;
+        if (lfs_file_opencfg(file->lfs, &file->file, path, LFS_O_RDONLY, &file->config) < 0) return NULL;
+        file->position = 0;
+        file->head = 0;
+        file->fill = 0;
+        file->in_use = true;
+        return file;
+    }
+
+    printf("open: %s: Too many open files\r\n", filename);
+    return NULL;
+}
+
+static lfs_ssize_t _filesystem_read_ahead(filesystem_file_t *file) {
+    file->position += file->fill;
+    file->head = 0;
+    file->fill = 0;
+
+    lfs_ssize_t result = lfs_file_read(file->lfs, &file->file, file->buffer, sizeof(file->buffer));
+    if (result > 0) file->fill = result;
+    return result;
+}
+
+int32_t filesystem_read(filesystem_file_t *file, void *buf, int32_t length) {
+    uint8_t *out = buf;
+    int32_t done = 0;
+
+    while (done < length) {
+        if (file->head == file->fill) {
+            if (length - done >= FILESYSTEM_READ_AHEAD) {
+                // nothing to gain from the buffer, read straight into the caller's.
+                file->position += file->fill;
+                file->head = 0;
+                file->fill = 0;
+                lfs_ssize_t result = lfs_file_read(file->lfs, &file->file, out + done, length - done);
+                if (result < 0) return done ? done : result;
+                file->position += result;
+                done += result;
+                break;
+            }
+            lfs_ssize_t result = _filesystem_read_ahead(file);
+            if (result < 0) return done ? done : result;
+            if (result == 0) break;
         }
-    } else {
-        printf("cat: %s: No such file\r\n", filename);
+
+        int32_t count = min(file->fill - file->head, length - done);
+        memcpy(out + done, file->buffer + file->head, count);
+        file->head += count;
+        done += count;
     }
+
+    return done;
+}
+
+bool filesystem_seek(filesystem_file_t *file, int32_t offset) {
+    if (offset >= file->position && offset <= file->position + file->fill) {
+        file->head = offset - file->position;
+        return true;
+    }
+
+    if (lfs_file_seek(file->lfs, &file->file, offset, LFS_SEEK_SET) < 0) return false;
+    file->position = offset;
+    file->head = 0;
+    file->fill = 0;
+    return true;
+}
+
+int32_t filesystem_tell(filesystem_file_t *file) {
+    return file->position + file->head;
+}
+
+void filesystem_close(filesystem_file_t *file) {
+    if (file == NULL || !file->in_use) return;
+    lfs_file_close(file->lfs, &file->file);
+    file->in_use = false;
+}
+
+static void _filesystem_close_all(void) {
+    for (uint8_t i = 0; i < FILESYSTEM_MAX_OPEN_FILES; i++) filesystem_close(&open_files[i]);
+}
+
+bool filesystem_line_iter_open(filesystem_line_iter_t *iter, char *filename) {
+    iter->file = filesystem_open(filename);
+    iter->line_offset = 0;
+    return iter->file != NULL;
+}
+
+bool filesystem_line_iter_next(filesystem_line_iter_t *iter, char *buf, int32_t length) {
+    filesystem_file_t *file = iter->file;
+    int32_t line_length = 0;
+    bool found = false;
+
+    if (file == NULL || length < 1) return false;
+    iter->line_offset = filesystem_tell(file);
+
+    while (true) {
+        if (file->head == file->fill && _filesystem_read_ahead(file) <= 0) break;
+        found = true;
+
+        uint8_t *start = file->buffer + file->head;
+        uint8_t *newline = memchr(start, '\n', file->fill - file->head);
+        int32_t count = newline ? newline - start : file->fill - file->head;
+        int32_t copied = min(count, length - 1 - line_length);
+        memcpy(buf + line_length, start, copied);
+        line_length += copied;
+        file->head += count;
+
+        if (newline) {
+            file->head++;
+            break;
+        }
+    }
+
+    if (line_length > 0 && buf[line_length - 1] == '\r') line_length--;
+    buf[line_length] = '\0';
+    return found;
+}
+
+void filesystem_line_iter_close(filesystem_line_iter_t *iter) {
+    filesystem_close(iter->file);
+    iter->file = NULL;
 }
 
 bool filesystem_write_file(char *filename, char *text, int32_t length) {
-    if (filesystem_get_free_space() <= 256) {
+    // the file is truncated, so appends that are still buffered would be overwritten anyway.
+    _filesystem_discard_pending(filename);
+    const char *path = filename;
+    lfs_t *lfs = _filesystem_volume(&path);
+    if (!_filesystem_has_room(lfs)) {
         printf("No free space!\n");
         return false;    
     }
 
-    int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_RDWR | LFS_O_CREAT | LFS_O_TRUNC);
+    _filesystem_account_write(lfs, length);
+    int err = lfs_file_open(lfs, &file, path, LFS_O_RDWR | LFS_O_CREAT | LFS_O_TRUNC);
     if (err < 0) return false;
-    err = lfs_file_write(&eeprom_filesystem, &file, text, length);
+    err = lfs_file_write(lfs, &file, text, length);
     if (err < 0) return false;
-    return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK;
+    return lfs_file_close(lfs, &file) == LFS_ERR_OK;
 }
 
 bool filesystem_append_file(char *filename, char *text, int32_t length) {
-    if (filesystem_get_free_space() <= 256) {
+    filesystem_pending_append_t *pending = _filesystem_find_pending(filename);
+
+    if (pending && pending->length + length > NVMCTRL_PAGE_SIZE) {
+        if (!_filesystem_flush_pending(pending)) return false;
+        pending = NULL;
+    }
+
+    if (length >= NVMCTRL_PAGE_SIZE || strlen(filename) > FILESYSTEM_WRITE_BEHIND_NAME_MAX) {
+        // the buffered appends must go first, or the file would end up out of order.
+        if (!_filesystem_flush_pending(pending)) return false;
+        return _filesystem_append_now(filename, text, length);
+    }
+
+    const char *path = filename;
+    if (!_filesystem_has_room(_filesystem_volume(&path))) {
+        printf("No free space!\n");
+        return false;
+    }
+
+    if (pending == NULL) {
+        // take a free slot, or make room by writing out the first one.
+        pending = &pending_appends[0];
+        for (uint8_t i = 0; i < FILESYSTEM_WRITE_BEHIND_FILES; i++) {
+            if (!pending_appends[i].filename[0]) {
+                pending = &pending_appends[i];
+                break;
+            }
+        }
+        if (!_filesystem_flush_pending(pending)) return false;
+        strcpy(pending->filename, filename);
+    }
+
+    memcpy(pending->data + pending->length, text, length);
+    pending->length += length;
+    if (pending->length == NVMCTRL_PAGE_SIZE) return _filesystem_flush_pending(pending);
+
+    return true;
+}
+
+static bool _filesystem_append_now(char *filename, char *text, int32_t length) {
+    const char *path = filename;
+    lfs_t *lfs = _filesystem_volume(&path);
+    if (!_filesystem_has_room(lfs)) {
         printf("No free space!\n");
         return false;    
     }
 
-    int err = lfs_file_open(&eeprom_filesystem, &file, filename, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND);
-    if (err < 0) return false;
-    err = lfs_file_write(&eeprom_filesystem, &file, text, length);
+    _filesystem_account_write(lfs, length);
+    int err = lfs_file_open(lfs, &file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND);
     if (err < 0) return false;
-    return lfs_file_close(&eeprom_filesystem, &file) == LFS_ERR_OK;
+    err = lfs_file_write(lfs, &file, text, length);
+    if (err < 0) {
+        // littlefs does not commit a file after a failed write, so closing it leaves the file as it was, and the
+        // write-behind buffer can retry the same data later.
+        lfs_file_close(lfs, &file);
+        return false;
+    }
+    return lfs_file_close(lfs, &file) == LFS_ERR_OK;
 }
 
 int filesystem_cmd_ls(int argc, char *argv[]) {
-    if (argc >= 2) {
-        filesystem_ls(&eeprom_filesystem, argv[1]);
-    } else {
-        filesystem_ls(&eeprom_filesystem, "/");
+    filesystem_sync();
+    const char *path = argc >= 2 ? argv[1] : "/";
+    lfs_t *lfs = _filesystem_volume(&path);
+    filesystem_ls(lfs, path);
+    return 0;
+}
+
+// cat and b64encode stream their file over several passes of the app loop, see SHELL_CMD_CONTINUE.
+static filesystem_file_t *dump_file;
+
+static int _filesystem_dump_start(const char *command, char *filename) {
+    dump_file = filesystem_open(filename);
+    if (dump_file == NULL) {
+        printf("%s: %s: No such file\r\n", command, filename);
+        return 0;
     }
+    return SHELL_CMD_CONTINUE;
+}
+
+static int _filesystem_dump_finish(void) {
+    printf("\r\n");
+    filesystem_close(dump_file);
+    dump_file = NULL;
     return 0;
 }
 
 int filesystem_cmd_cat(int argc, char *argv[]) {
     (void) argc;
-    filesystem_cat(argv[1]);
-    return 0;
+    return _filesystem_dump_start("cat", argv[1]);
+}
+
+int filesystem_cmd_cat_resume(size_t budget) {
+    char buf[FILESYSTEM_READ_AHEAD];
+    while (budget > 0) {
+        int32_t count = filesystem_read(dump_file, buf, min(sizeof(buf), budget));
+        if (count <= 0) return _filesystem_dump_finish();
+        fwrite(buf, 1, count, stdout);
+        budget -= count;
+    }
+    return SHELL_CMD_CONTINUE;
 }
 
 int filesystem_cmd_b64encode(int argc, char *argv[]) {
     (void) argc;
-    info.type = 0;
-    lfs_stat(&eeprom_filesystem, argv[1], &info);
-    if (filesystem_file_exists(argv[1])) {
-        if (info.size > 0) {
-            char *buf = malloc(info.size + 1);
-            filesystem_read_file(argv[1], buf, info.size);
-            // print a base 64 encoding of the file, 12 bytes at a time
-            for (lfs_size_t i = 0; i < info.size; i += 12) {
-                lfs_size_t len = min(12, info.size - i);
-                char base64_line[17];
-                b64_encode((unsigned char *)buf + i, len, (unsigned char *)base64_line);
-                printf("%s\n", base64_line);
-                delay_ms(10);
-            }
-            free(buf);
-        } else {
-            printf("\r\n");
-        }
-    } else {
-        printf("b64encode: %s: No such file\r\n", argv[1]);
+    return _filesystem_dump_start("b64encode", argv[1]);
+}
+
+int filesystem_cmd_b64encode_resume(size_t budget) {
+    // print a base 64 encoding of the file, 12 bytes (16 characters and a newline) per line
+    unsigned char buf[12];
+    char base64_line[17];
+    for (; budget >= sizeof(base64_line); budget -= sizeof(base64_line)) {
+        int32_t count = filesystem_read(dump_file, buf, sizeof(buf));
+        if (count <= 0) return _filesystem_dump_finish();
+        b64_encode(buf, count, (unsigned char *)base64_line);
+        printf("%s\n", base64_line);
     }
-    return 0;
+    return SHELL_CMD_CONTINUE;
 }
 
 int filesystem_cmd_df(int argc, char *argv[]) {
     (void) argc;
     (void) argv;
+    filesystem_sync();
     printf("free space: %ld bytes\r\n", filesystem_get_free_space());
+#ifdef FILESYSTEM_EXTERNAL_FLASH
+    uint32_t blocks = 0;
+    if (external_mounted && lfs_fs_traverse(&external_filesystem, _traverse_df_cb, &blocks) == LFS_ERR_OK) {
+        printf(FILESYSTEM_EXTERNAL_MOUNT ": %lu bytes free\r\n", (external_lfs_cfg.block_count - blocks) * FILESYSTEM_EXTERNAL_BLOCK_SIZE);
+    }
+#endif
     return 0;
 }
 
@@ -352,18 +831,23 @@ int filesystem_cmd_echo(int argc, char *argv[]) {
         line[line_len] = '\0';
     }
 
-    if (strchr(argv[3], '/')) {
+    const char *path = argv[3];
+    _filesystem_volume(&path);
+    if (strchr(path + (path[0] == '/'), '/')) {
         printf("subdirectories are not supported\r\n");
         return -2;
     }
 
+    // the line ends where its argument did, so the newline can take the place of the terminator and go out
+    // with the text in one write.
+    line[line_len] = '\n';
     if (!strcmp(argv[2], ">")) {
-        filesystem_write_file(argv[3], line, line_len);
-        filesystem_append_file(argv[3], "\n", 1);
+        filesystem_write_file(argv[3], line, line_len + 1);
     } else if (!strcmp(argv[2], ">>")) {
-        filesystem_append_file(argv[3], line, line_len);
-        filesystem_append_file(argv[3], "\n", 1);
+        filesystem_append_file(argv[3], line, line_len + 1);
+        filesystem_sync();
     } else {
+        line[line_len] = '\0';
         return -2;
     }
 
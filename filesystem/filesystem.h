@@ -29,11 +29,22 @@
 #include "watch.h"
 
 /** @brief Initializes and mounts the tiny 8kb filesystem, formatting it if need be.
-  * @return true if the filesystem was mounted successfully.
+  * @details Firmware built with EXTERNAL_FLASH=1 also mounts the SPI flash, on boards that have one, as a
+  *          second volume. Paths under /ext (such as "/ext/accel.log") go to it, all others to the internal
+  *          filesystem. The free space functions cover the internal filesystem only.
+  * @return true if the internal filesystem was mounted successfully.
   */
 bool filesystem_init(void);
 
+/** @brief Gets the number of storage rows that the filesystem occupies, starting at row 0.
+  * @details This leaves the last rows to the key/value store, unless the filesystem was formatted before
+  *          the store existed; see kv_store.h.
+  */
+uint32_t filesystem_get_block_count(void);
+
 /** @brief Gets the space available on the filesystem.
+  * @details The block usage is cached, so this only walks the filesystem if files were written or
+  *          removed since the last call. Writes and appends check for space without a walk.
   * @return the free space in bytes
   */
 int32_t filesystem_get_free_space(void);
@@ -77,9 +88,82 @@ bool filesystem_read_file(char *filename, char *buf, int32_t length);
   *               to reflect the offset of the next line.
   * @param length The maximum number of bytes to read
   * @return true if the read was successful; false otherwise
+  * @note This opens the file and seeks to the offset on every call. To read a whole file line by
+  *       line, use filesystem_line_iter_open and filesystem_line_iter_next instead.
   */
 bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t length);
 
+/// Number of files that can be open with filesystem_open at the same time.
+#define FILESYSTEM_MAX_OPEN_FILES 3
+
+/// Size of the read-ahead buffer of an open file.
+#define FILESYSTEM_READ_AHEAD 64
+
+/// A file opened for reading with filesystem_open. Handles come from a small static pool.
+typedef struct filesystem_file filesystem_file_t;
+
+/** @brief Opens a file for reading.
+  * @param filename the file you wish to read
+  * @return a handle for the file, or NULL if the file does not exist or all handles are in use.
+  * @note Close the handle with filesystem_close when you are done. A face that keeps a file open
+  *       while it is active should close it in its resign function.
+  */
+filesystem_file_t *filesystem_open(char *filename);
+
+/** @brief Reads from an open file, continuing where the last read stopped.
+  * @param file the handle from filesystem_open
+  * @param buf A buffer of at least length bytes
+  * @param length The number of bytes to read
+  * @return the number of bytes read, which is less than length at the end of the file, or a
+  *         negative error code.
+  */
+int32_t filesystem_read(filesystem_file_t *file, void *buf, int32_t length);
+
+/** @brief Moves the read position of an open file.
+  * @param file the handle from filesystem_open
+  * @param offset The offset from the start of the file
+  * @return true if the seek was successful; false otherwise
+  */
+bool filesystem_seek(filesystem_file_t *file, int32_t offset);
+
+/** @brief Gets the read position of an open file.
+  * @param file the handle from filesystem_open
+  * @return the offset from the start of the file of the next byte that filesystem_read returns
+  */
+int32_t filesystem_tell(filesystem_file_t *file);
+
+/** @brief Closes a file and returns its handle to the pool.
+  * @param file the handle from filesystem_open; NULL is ignored.
+  */
+void filesystem_close(filesystem_file_t *file);
+
+/// Reads a file line by line in a single pass. See filesystem_line_iter_open.
+typedef struct {
+    filesystem_file_t *file;
+    int32_t line_offset;    ///< offset in the file of the line last returned by filesystem_line_iter_next
+} filesystem_line_iter_t;
+
+/** @brief Opens a file for reading it line by line.
+  * @param iter The iterator to set up
+  * @param filename the file you wish to read
+  * @return true if the file was opened; false otherwise
+  */
+bool filesystem_line_iter_open(filesystem_line_iter_t *iter, char *filename);
+
+/** @brief Reads the next line of a file.
+  * @param iter An iterator set up by filesystem_line_iter_open
+  * @param buf A buffer of length bytes. It receives the line without its line break, and is
+  *            always null terminated. A longer line is truncated, and the rest of it is skipped.
+  * @param length The size of buf
+  * @return true if a line was read; false at the end of the file or on an error.
+  */
+bool filesystem_line_iter_next(filesystem_line_iter_t *iter, char *buf, int32_t length);
+
+/** @brief Closes the file of a line iterator.
+  * @param iter An iterator set up by filesystem_line_iter_open
+  */
+void filesystem_line_iter_close(filesystem_line_iter_t *iter);
+
 /** @brief Writes file to the filesystem
   * @param filename the file you wish to write
   * @param text The contents of the file
@@ -93,13 +177,34 @@ bool filesystem_write_file(char *filename, char *text, int32_t length);
   * @param text The contents to write
   * @param length The number of bytes to write
   * @return true if the write was successful; false otherwise
+  * @note Appends shorter than a flash page are buffered in RAM, and appends to the same file are
+  *       written together once the page is full, the file is read or rewritten, or
+  *       filesystem_sync is called. A write error of a buffered append is only reported then:
+  *       the appends stay buffered, and reading the file fails until they could be written.
   */
 bool filesystem_append_file(char *filename, char *text, int32_t length);
 
+/** @brief Writes out all buffered appends.
+  * @details Movement calls this before it enters low energy mode. Call it before anything that
+  *          loses the contents of RAM, like watch_enter_backup_mode.
+  * @return true if all buffered appends were written; false otherwise
+  */
+bool filesystem_sync(void);
+
+/** @brief Writes out the buffered appends to one file.
+  * @param filename the file
+  * @return true if the file had nothing buffered or it was written; false otherwise
+  */
+bool filesystem_flush(char *filename);
+
 int filesystem_cmd_ls(int argc, char *argv[]);
 int filesystem_cmd_cat(int argc, char *argv[]);
+int filesystem_cmd_cat_resume(size_t budget);
 int filesystem_cmd_b64encode(int argc, char *argv[]);
+int filesystem_cmd_b64encode_resume(size_t budget);
 int filesystem_cmd_df(int argc, char *argv[]);
 int filesystem_cmd_rm(int argc, char *argv[]);
 int filesystem_cmd_format(int argc, char *argv[]);
 int filesystem_cmd_echo(int argc, char *argv[]);
+int filesystem_cmd_get(int argc, char *argv[]);
+int filesystem_cmd_put(int argc, char *argv[]);
@@ -0,0 +1,223 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "filesystem.h"
+#include "crc16.h"
+#include "delay.h"
+
+/*
+ * Binary file transfer over the serial shell, for utils/file_transfer/movement_xfer.py.
+ *
+ * Both directions use the same frame:
+ *
+ *     0xA5 0x5A  type  offset (u32)  length (u16)  payload  CRC-16 (u16)
+ *
+ * Numbers are little endian; the CRC (CRC-16/CCITT-FALSE) covers everything from the type to the end of
+ * the payload. The types are:
+ *
+ *     'D'  data at offset
+ *     'E'  end of the transfer; offset is the file size
+ *     'A'  put: ready for or received everything up to offset
+ *     'N'  put: rejected frame; resend from offset
+ *     'X'  error; the payload says why, offset is the size of the file on the watch if it exists
+ *
+ * get FILE [OFFSET] streams 'D' frames of up to TRANSFER_CHUNK_SIZE bytes from OFFSET on, then 'E'. The
+ * host checks every frame and restarts with the offset of the first bad one.
+ *
+ * put FILE SIZE [resume] truncates FILE, or with resume keeps what it already holds, and answers 'A' with
+ * the offset to send from. Every 'D' frame is then answered with 'A' once it is written, or with 'N'. The
+ * watch sends 'E' when it holds SIZE bytes.
+ *
+ * Chunks go straight between the serial buffers and littlefs, so files of any size move through a single
+ * chunk of RAM.
+ */
+
+#define TRANSFER_SYNC_0 0xA5
+#define TRANSFER_SYNC_1 0x5A
+#define TRANSFER_CHUNK_SIZE 256
+// A put gives up when the host sends nothing for this long.
+#define TRANSFER_TIMEOUT_MS 2000
+
+// Defined in movement.c; runs the USB stack while a transfer waits on the host.
+void yield(void);
+
+static uint8_t chunk[TRANSFER_CHUNK_SIZE];
+
+static void _transfer_send(char type, uint32_t offset, const void *payload, uint16_t length) {
+    uint8_t header[9] = { TRANSFER_SYNC_0, TRANSFER_SYNC_1, type,
+                          offset & 0xFF, (offset >> 8) & 0xFF, (offset >> 16) & 0xFF, offset >> 24,
+                          length & 0xFF, length >> 8 };
+    uint16_t crc = crc16_update(CRC16_INIT, header + 2, sizeof(header) - 2);
+    crc = crc16_update(crc, payload, length);
+    uint8_t trailer[2] = { crc & 0xFF, crc >> 8 };
+
+    fwrite(header, 1, sizeof(header), stdout);
+    if (length) fwrite(payload, 1, length, stdout);
+    fwrite(trailer, 1, sizeof(trailer), stdout);
+    fflush(stdout);
+}
+
+static void _transfer_error(uint32_t offset, const char *message) {
+    _transfer_send('X', offset, message, strlen(message));
+}
+
+/// Returns the next byte from the host, or -1 if none arrives in time.
+static int _transfer_getc(void) {
+    uint16_t idle_ms = 0;
+
+    while (true) {
+        int c = getchar();
+        if (c >= 0) return c;
+        clearerr(stdin);
+        if (idle_ms++ >= TRANSFER_TIMEOUT_MS) return -1;
+        yield();
+        delay_ms(1);
+    }
+}
+
+/// Reads bytes from the host into buf; false on timeout.
+static bool _transfer_read(uint8_t *buf, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        int c = _transfer_getc();
+        if (c < 0) return false;
+        buf[i] = c;
+    }
+    return true;
+}
+
+/// Receives the next frame into chunk. Returns 1 for a good frame, 0 for a damaged one and -1 on timeout.
+static int _transfer_receive(char *type, uint32_t *offset, uint16_t *length) {
+    uint8_t header[7];
+    int c = 0;
+
+    // skip anything before the sync bytes, such as the rest of the command line.
+    do {
+        while (c != TRANSFER_SYNC_0) {
+            if ((c = _transfer_getc()) < 0) return -1;
+        }
+        if ((c = _transfer_getc()) < 0) return -1;
+    } while (c != TRANSFER_SYNC_1);
+
+    if (!_transfer_read(header, sizeof(header))) return -1;
+    *type = header[0];
+    *offset = header[1] | header[2] << 8 | header[3] << 16 | (uint32_t)header[4] << 24;
+    *length = header[5] | header[6] << 8;
+    // an implausible length is most likely a damaged header; waiting for its payload would only time out.
+    if (*length > TRANSFER_CHUNK_SIZE) return 0;
+
+    uint8_t trailer[2];
+    if (!_transfer_read(chunk, *length) || !_transfer_read(trailer, sizeof(trailer))) return -1;
+    uint16_t crc = crc16_update(crc16_update(CRC16_INIT, header, sizeof(header)), chunk, *length);
+
+    return crc == (trailer[0] | trailer[1] << 8);
+}
+
+int filesystem_cmd_get(int argc, char *argv[]) {
+    uint32_t offset = argc >= 3 ? strtoul(argv[2], NULL, 10) : 0;
+    int32_t size = filesystem_get_file_size(argv[1]);
+
+    if (size < 0) {
+        _transfer_error(0, "no such file");
+        return 1;
+    }
+    if (offset > (uint32_t)size) {
+        _transfer_error(size, "offset beyond the end of the file");
+        return 1;
+    }
+
+    filesystem_file_t *file = filesystem_open(argv[1]);
+    if (file == NULL || !filesystem_seek(file, offset)) {
+        filesystem_close(file);
+        _transfer_error(size, "cannot open the file");
+        return 1;
+    }
+
+    while (offset < (uint32_t)size) {
+        int32_t length = filesystem_read(file, chunk, TRANSFER_CHUNK_SIZE);
+        if (length <= 0) {
+            filesystem_close(file);
+            _transfer_error(size, "read error");
+            return 1;
+        }
+        _transfer_send('D', offset, chunk, length);
+        offset += length;
+    }
+    filesystem_close(file);
+    _transfer_send('E', offset, NULL, 0);
+
+    return 0;
+}
+
+int filesystem_cmd_put(int argc, char *argv[]) {
+    char *filename = argv[1];
+    uint32_t size = strtoul(argv[2], NULL, 10);
+    uint32_t offset = 0;
+
+    if (argc >= 4 && strcmp(argv[3], "resume") == 0) {
+        int32_t existing = filesystem_get_file_size(filename);
+        if (existing > 0) offset = existing;
+        if (offset > size) {
+            _transfer_error(offset, "the file on the watch is larger");
+            return 1;
+        }
+    } else if (argc >= 4) {
+        return -2;
+    }
+    if (offset == 0 && !filesystem_write_file(filename, "", 0)) {
+        _transfer_error(0, "cannot create the file");
+        return 1;
+    }
+
+    _transfer_send('A', offset, NULL, 0);
+    while (offset < size) {
+        char type;
+        uint32_t frame_offset;
+        uint16_t length;
+        int result = _transfer_receive(&type, &frame_offset, &length);
+
+        if (result < 0) {
+            filesystem_sync();
+            _transfer_error(offset, "timeout");
+            return 1;
+        }
+        if (result == 0 || type != 'D' || frame_offset != offset || length == 0 || length > size - offset) {
+            _transfer_send('N', offset, NULL, 0);
+            continue;
+        }
+        if (!filesystem_append_file(filename, (char *)chunk, length)) {
+            filesystem_sync();
+            _transfer_error(offset, "write error");
+            return 1;
+        }
+        offset += length;
+        _transfer_send('A', offset, NULL, 0);
+    }
+    filesystem_sync();
+    _transfer_send('E', offset, NULL, 0);
+
+    return 0;
+}
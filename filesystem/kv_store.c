@@ -0,0 +1,256 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "kv_store.h"
+#include "filesystem.h"
+#include "watch.h"
+#include "crc16.h"
+
+#define KV_STORE_FIRST_ROW (NVMCTRL_RWWEE_PAGES / 4 - KV_STORE_ROWS)
+#define KV_STORE_PAGES_PER_ROW (NVMCTRL_ROW_SIZE / NVMCTRL_PAGE_SIZE)
+
+// A page starts with a 32 bit sequence number and a flags byte and ends with the CRC of everything before it.
+// Records in between are a key, a length and the value; an erased key byte ends them.
+#define KV_STORE_HEADER_SIZE 5
+#define KV_STORE_CRC_OFFSET (NVMCTRL_PAGE_SIZE - 2)
+#define KV_STORE_FLAG_SNAPSHOT_END 0x01
+
+typedef struct {
+    uint8_t key;
+    uint8_t length;
+    uint16_t offset;                // of the value, counted from the start of the store's first row
+} kv_store_entry_t;
+
+static kv_store_entry_t kv_index[KV_STORE_MAX_KEYS];
+static uint8_t num_keys;
+static uint8_t active_row;          // relative to KV_STORE_FIRST_ROW
+static uint8_t next_page;           // next erased page of the active row, KV_STORE_PAGES_PER_ROW if it is full
+static uint32_t sequence;           // of the newest page
+static bool available;
+
+static bool _kv_store_page_erased(const uint8_t *page) {
+    for (uint8_t i = 0; i < NVMCTRL_PAGE_SIZE; i++) {
+        if (page[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+static bool _kv_store_page_valid(const uint8_t *page) {
+    uint16_t crc = page[KV_STORE_CRC_OFFSET] | page[KV_STORE_CRC_OFFSET + 1] << 8;
+    return !_kv_store_page_erased(page) && crc == crc16_update(CRC16_INIT, page, KV_STORE_CRC_OFFSET);
+}
+
+static uint32_t _kv_store_page_sequence(const uint8_t *page) {
+    uint32_t page_sequence;
+    memcpy(&page_sequence, page, sizeof(page_sequence));
+    return page_sequence;
+}
+
+/// Numbers a page as the newest and adds its CRC.
+static void _kv_store_seal_page(uint8_t *page, uint8_t flags) {
+    sequence++;
+    memcpy(page, &sequence, sizeof(sequence));
+    page[4] = flags;
+    uint16_t crc = crc16_update(CRC16_INIT, page, KV_STORE_CRC_OFFSET);
+    page[KV_STORE_CRC_OFFSET] = crc & 0xFF;
+    page[KV_STORE_CRC_OFFSET + 1] = crc >> 8;
+}
+
+static kv_store_entry_t *_kv_store_find(uint8_t key) {
+    for (uint8_t i = 0; i < num_keys; i++) {
+        if (kv_index[i].key == key) return &kv_index[i];
+    }
+    return NULL;
+}
+
+static void _kv_store_index(uint8_t key, uint8_t length, uint16_t offset) {
+    kv_store_entry_t *entry = _kv_store_find(key);
+
+    if (length == 0) {
+        if (entry) *entry = kv_index[--num_keys];
+        return;
+    }
+    if (entry == NULL) {
+        if (num_keys == KV_STORE_MAX_KEYS) return;
+        entry = &kv_index[num_keys++];
+        entry->key = key;
+    }
+    entry->length = length;
+    entry->offset = offset;
+}
+
+/// Indexes the records of the valid pages of a row, in the order they were written.
+static void _kv_store_replay_row(const uint8_t *row, uint8_t row_index) {
+    for (uint8_t page = 0; page < KV_STORE_PAGES_PER_ROW; page++) {
+        const uint8_t *data = row + page * NVMCTRL_PAGE_SIZE;
+        if (!_kv_store_page_valid(data)) continue;
+
+        uint8_t pos = KV_STORE_HEADER_SIZE;
+        while (pos + 2 <= KV_STORE_CRC_OFFSET && data[pos] != KV_STORE_KEY_INVALID && pos + 2 + data[pos + 1] <= KV_STORE_CRC_OFFSET) {
+            _kv_store_index(data[pos], data[pos + 1], row_index * NVMCTRL_ROW_SIZE + page * NVMCTRL_PAGE_SIZE + pos + 2);
+            pos += 2 + data[pos + 1];
+        }
+    }
+}
+
+static bool _kv_store_read_value(const kv_store_entry_t *entry, uint8_t *value) {
+    return watch_storage_read(KV_STORE_FIRST_ROW + entry->offset / NVMCTRL_ROW_SIZE, entry->offset % NVMCTRL_ROW_SIZE, value, entry->length);
+}
+
+bool kv_store_init(void) {
+    uint8_t rows[KV_STORE_ROWS][NVMCTRL_ROW_SIZE];
+    uint32_t newest[KV_STORE_ROWS] = {0};
+    uint8_t used_pages[KV_STORE_ROWS] = {0};
+    bool has_snapshot[KV_STORE_ROWS] = {false};
+
+    num_keys = 0;
+    active_row = 0;
+    next_page = 0;
+    sequence = 0;
+    available = filesystem_get_block_count() <= KV_STORE_FIRST_ROW;
+    if (!available) return false;
+
+    for (uint8_t row = 0; row < KV_STORE_ROWS; row++) {
+        if (!watch_storage_read(KV_STORE_FIRST_ROW + row, 0, rows[row], NVMCTRL_ROW_SIZE)) {
+            available = false;
+            return false;
+        }
+        for (uint8_t page = 0; page < KV_STORE_PAGES_PER_ROW; page++) {
+            const uint8_t *data = rows[row] + page * NVMCTRL_PAGE_SIZE;
+            // a page that was torn by a reset is skipped, but it cannot be programmed again either.
+            if (!_kv_store_page_erased(data)) used_pages[row] = page + 1;
+            if (!_kv_store_page_valid(data)) continue;
+            if (_kv_store_page_sequence(data) > newest[row]) newest[row] = _kv_store_page_sequence(data);
+            if (data[4] & KV_STORE_FLAG_SNAPSHOT_END) has_snapshot[row] = true;
+        }
+    }
+
+    active_row = newest[1] > newest[0];
+    next_page = used_pages[active_row];
+    sequence = newest[active_row];
+
+    // a complete snapshot holds everything the other row did; otherwise a compaction was cut short, and the
+    // older row still has the values that are missing from the active one.
+    uint8_t older_row = 1 - active_row;
+    if (!has_snapshot[active_row] && newest[older_row]) _kv_store_replay_row(rows[older_row], older_row);
+    _kv_store_replay_row(rows[active_row], active_row);
+
+    return true;
+}
+
+bool kv_store_get(uint8_t key, void *value, uint8_t length) {
+    kv_store_entry_t *entry = _kv_store_find(key);
+    if (!available || entry == NULL || entry->length != length) return false;
+
+    return _kv_store_read_value(entry, value);
+}
+
+/// Writes all values into the other row, with key set to value, or removed if length is zero.
+static bool _kv_store_compact(uint8_t key, const uint8_t *value, uint8_t length) {
+    uint8_t row[NVMCTRL_ROW_SIZE];
+    kv_store_entry_t entries[KV_STORE_MAX_KEYS];
+    uint8_t count = 0;
+    uint8_t target = 1 - active_row;
+    uint8_t page = 0;
+    uint8_t pos = KV_STORE_HEADER_SIZE;
+
+    memset(row, 0xFF, sizeof(row));
+    // values are read before the erase, since after an interrupted compaction some may still be in the target row.
+    for (uint8_t i = 0; i <= num_keys; i++) {
+        bool is_new = (i == num_keys);
+        kv_store_entry_t entry = is_new ? (kv_store_entry_t){key, length, 0} : kv_index[i];
+        if (entry.length == 0 || (!is_new && entry.key == key)) continue;
+
+        if (pos + 2 + entry.length > KV_STORE_CRC_OFFSET) {
+            if (++page == KV_STORE_PAGES_PER_ROW) return false;
+            pos = KV_STORE_HEADER_SIZE;
+        }
+        uint8_t *data = row + page * NVMCTRL_PAGE_SIZE;
+        data[pos] = entry.key;
+        data[pos + 1] = entry.length;
+        if (is_new) {
+            memcpy(data + pos + 2, value, length);
+        } else if (!_kv_store_read_value(&entry, data + pos + 2)) {
+            return false;
+        }
+        entry.offset = target * NVMCTRL_ROW_SIZE + page * NVMCTRL_PAGE_SIZE + pos + 2;
+        entries[count++] = entry;
+        pos += 2 + entry.length;
+    }
+
+    for (uint8_t i = 0; i <= page; i++) {
+        _kv_store_seal_page(row + i * NVMCTRL_PAGE_SIZE, i == page ? KV_STORE_FLAG_SNAPSHOT_END : 0);
+    }
+
+    if (!watch_storage_erase(KV_STORE_FIRST_ROW + target)) return false;
+    active_row = target;
+    next_page = page + 1;
+    for (uint8_t i = 0; i <= page; i++) {
+        if (!watch_storage_write(KV_STORE_FIRST_ROW + target, i * NVMCTRL_PAGE_SIZE, row + i * NVMCTRL_PAGE_SIZE, NVMCTRL_PAGE_SIZE)) return false;
+    }
+    memcpy(kv_index, entries, count * sizeof(kv_store_entry_t));
+    num_keys = count;
+
+    return true;
+}
+
+static bool _kv_store_write(uint8_t key, const uint8_t *value, uint8_t length) {
+    if (next_page == KV_STORE_PAGES_PER_ROW) return _kv_store_compact(key, value, length);
+
+    uint8_t page[NVMCTRL_PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    page[KV_STORE_HEADER_SIZE] = key;
+    page[KV_STORE_HEADER_SIZE + 1] = length;
+    if (length) memcpy(page + KV_STORE_HEADER_SIZE + 2, value, length);
+    _kv_store_seal_page(page, 0);
+
+    uint16_t offset = active_row * NVMCTRL_ROW_SIZE + next_page * NVMCTRL_PAGE_SIZE;
+    // a failed program may still have cleared bits, so the page counts as used either way.
+    next_page++;
+    if (!watch_storage_write(KV_STORE_FIRST_ROW + active_row, offset % NVMCTRL_ROW_SIZE, page, NVMCTRL_PAGE_SIZE)) return false;
+    _kv_store_index(key, length, offset + KV_STORE_HEADER_SIZE + 2);
+
+    return true;
+}
+
+bool kv_store_set(uint8_t key, const void *value, uint8_t length) {
+    if (!available || key == KV_STORE_KEY_INVALID || length == 0 || length > KV_STORE_MAX_VALUE_SIZE) return false;
+
+    kv_store_entry_t *entry = _kv_store_find(key);
+    if (entry == NULL && num_keys == KV_STORE_MAX_KEYS) return false;
+    if (entry != NULL && entry->length == length) {
+        uint8_t stored[KV_STORE_MAX_VALUE_SIZE];
+        if (_kv_store_read_value(entry, stored) && memcmp(stored, value, length) == 0) return true;
+    }
+
+    return _kv_store_write(key, value, length);
+}
+
+bool kv_store_delete(uint8_t key) {
+    if (!available) return false;
+    if (_kv_store_find(key) == NULL) return true;
+
+    return _kv_store_write(key, NULL, 0);
+}
@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * The key/value store keeps small values such as the movement settings and face preferences in the last
+ * KV_STORE_ROWS rows of the storage area, next to the filesystem rather than in it.
+ *
+ * Every update programs one page into the active row: a 32 bit sequence number, a flags byte, the record
+ * (key, length, value) and a CRC-16 over the page. A record of length zero deletes its key. When the active
+ * row is full, the live values are compacted into the other row, which is erased first; the last page of
+ * such a snapshot is flagged, so that keys missing from it count as deleted. Compaction never erases the
+ * active row, so a reset in the middle of it loses nothing; the store then replays both rows, oldest first.
+ *
+ * kv_store_init reads both rows once and builds a RAM index of where each key's latest value is. Reads go
+ * straight to that location, and writes of a value that is already stored cost nothing.
+ */
+
+/// Rows at the end of the storage area that the store alternates between.
+#define KV_STORE_ROWS 2
+
+/// Most keys the store holds at a time.
+#define KV_STORE_MAX_KEYS 16
+
+/// Largest value.
+#define KV_STORE_MAX_VALUE_SIZE 32
+
+/// Keys of the values in the store. Faces that keep preferences add theirs here, so that keys stay unique.
+typedef enum {
+    KV_STORE_KEY_SETTINGS = 1,      // movement_settings_t
+    KV_STORE_KEY_INVALID = 0xFF,
+} kv_store_key_t;
+
+/** @brief Scans the store's rows and builds the index. Call it after filesystem_init.
+  * @return true if the store can be used; false if the filesystem still spans its rows, which is the case
+  *         for filesystems formatted before the store existed until they are formatted again.
+  */
+bool kv_store_init(void);
+
+/** @brief Reads a value.
+  * @param key The key of the value.
+  * @param value Receives the value.
+  * @param length The expected length of the value.
+  * @return true if the key was found with that length; false otherwise, in which case value is unchanged.
+  */
+bool kv_store_get(uint8_t key, void *value, uint8_t length);
+
+/** @brief Stores a value, unless it is already stored.
+  * @param key The key of the value.
+  * @param value The value.
+  * @param length The length of the value, from 1 to KV_STORE_MAX_VALUE_SIZE.
+  * @return true if the value is stored; false if the store is unavailable or full.
+  */
+bool kv_store_set(uint8_t key, const void *value, uint8_t length);
+
+/** @brief Removes a value.
+  * @param key The key of the value.
+  * @return true if the key is no longer stored; false if the removal could not be written.
+  */
+bool kv_store_delete(uint8_t key);
@@ -0,0 +1,216 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "ring_log.h"
+#include "filesystem.h"
+
+typedef struct {
+    uint32_t sequence;
+    uint8_t record_size;
+    uint8_t reserved[3];
+} ring_log_header_t;
+
+// An open segment, so that consecutive reads from the same segment do not open it again.
+typedef struct {
+    filesystem_file_t *file;
+    uint32_t sequence;
+} ring_log_cursor_t;
+
+static uint8_t _ring_log_record_length(const ring_log_t *log) {
+    return sizeof(uint32_t) + log->record_size;
+}
+
+static void _ring_log_filename(const ring_log_t *log, uint32_t sequence, char *filename) {
+    sprintf(filename, "%s.%u", log->name, (unsigned int)(sequence % log->num_segments));
+}
+
+/// Reads the header of the segment in slot, and returns its number of records, or -1 if it is not part of the log.
+static int16_t _ring_log_scan_segment(const ring_log_t *log, uint8_t slot, uint32_t *sequence) {
+    char filename[RING_LOG_MAX_NAME + 5];
+    ring_log_header_t header;
+
+    sprintf(filename, "%s.%u", log->name, (unsigned int)slot);
+    int32_t size = filesystem_get_file_size(filename);
+    if (size < (int32_t)sizeof(header)) return -1;
+
+    filesystem_file_t *file = filesystem_open(filename);
+    if (file == NULL) return -1;
+    int32_t read = filesystem_read(file, &header, sizeof(header));
+    filesystem_close(file);
+
+    if (read != sizeof(header) || header.record_size != log->record_size || header.sequence % log->num_segments != slot) return -1;
+    *sequence = header.sequence;
+    return (size - sizeof(header)) / _ring_log_record_length(log);
+}
+
+bool ring_log_open(ring_log_t *log, const char *name, uint8_t record_size, uint8_t records_per_segment, uint8_t num_segments) {
+    memset(log, 0, sizeof(ring_log_t));
+    if (strlen(name) > RING_LOG_MAX_NAME || record_size == 0 || record_size > RING_LOG_MAX_RECORD_SIZE ||
+        records_per_segment == 0 || num_segments < 2 || num_segments > RING_LOG_MAX_SEGMENTS) {
+        return false;
+    }
+    strcpy(log->name, name);
+    log->record_size = record_size;
+    log->records_per_segment = records_per_segment;
+    log->num_segments = num_segments;
+
+    uint32_t sequences[RING_LOG_MAX_SEGMENTS];
+    int16_t counts[RING_LOG_MAX_SEGMENTS];
+    bool found = false;
+    for (uint8_t slot = 0; slot < num_segments; slot++) {
+        counts[slot] = _ring_log_scan_segment(log, slot, &sequences[slot]);
+        if (counts[slot] < 0) continue;
+        if (!found || sequences[slot] > log->newest_sequence) log->newest_sequence = sequences[slot];
+        found = true;
+    }
+    if (!found) return true;
+
+    // the newest segment and every full segment right before it hold the log.
+    uint8_t newest_slot = log->newest_sequence % num_segments;
+    log->newest_count = counts[newest_slot] < records_per_segment ? counts[newest_slot] : records_per_segment;
+    log->live_segments = 1;
+    while (log->live_segments < num_segments && log->live_segments <= log->newest_sequence) {
+        uint32_t sequence = log->newest_sequence - log->live_segments;
+        uint8_t slot = sequence % num_segments;
+        if (counts[slot] < records_per_segment || sequences[slot] != sequence) break;
+        log->live_segments++;
+    }
+
+    return true;
+}
+
+bool ring_log_append(ring_log_t *log, uint32_t timestamp, const void *record) {
+    uint8_t buf[sizeof(ring_log_header_t) + sizeof(uint32_t) + RING_LOG_MAX_RECORD_SIZE];
+    uint8_t record_length = _ring_log_record_length(log);
+    char filename[RING_LOG_MAX_NAME + 5];
+
+    if (log->live_segments && log->newest_count < log->records_per_segment) {
+        // the common case: one record at the end of the newest segment.
+        memcpy(buf, &timestamp, sizeof(timestamp));
+        memcpy(buf + sizeof(timestamp), record, log->record_size);
+        _ring_log_filename(log, log->newest_sequence, filename);
+        if (!filesystem_append_file(filename, (char *)buf, record_length)) return false;
+        log->newest_count++;
+        return true;
+    }
+
+    // ring_log_open only counts full segments before the newest one, so the last record of the segment
+    // that is now complete must not stay in the write-behind buffer, where a reset would lose it.
+    if (log->live_segments) {
+        _ring_log_filename(log, log->newest_sequence, filename);
+        if (!filesystem_flush(filename)) return false;
+    }
+
+    // start a new segment in the slot of the oldest one, which is truncated and rewritten with the record.
+    ring_log_header_t header = { .sequence = log->newest_sequence + 1, .record_size = log->record_size };
+    memcpy(buf, &header, sizeof(header));
+    memcpy(buf + sizeof(header), &timestamp, sizeof(timestamp));
+    memcpy(buf + sizeof(header) + sizeof(timestamp), record, log->record_size);
+    _ring_log_filename(log, header.sequence, filename);
+    if (!filesystem_write_file(filename, (char *)buf, sizeof(header) + record_length)) return false;
+
+    log->newest_sequence = header.sequence;
+    log->newest_count = 1;
+    if (log->live_segments < log->num_segments) log->live_segments++;
+    return true;
+}
+
+uint32_t ring_log_count(const ring_log_t *log) {
+    if (log->live_segments == 0) return 0;
+    return (uint32_t)(log->live_segments - 1) * log->records_per_segment + log->newest_count;
+}
+
+static bool _ring_log_read_at(ring_log_t *log, ring_log_cursor_t *cursor, uint32_t index, uint32_t *timestamp, void *record) {
+    uint8_t buf[sizeof(uint32_t) + RING_LOG_MAX_RECORD_SIZE];
+    uint8_t record_length = _ring_log_record_length(log);
+
+    if (index >= ring_log_count(log)) return false;
+    uint32_t sequence = log->newest_sequence - (log->live_segments - 1) + index / log->records_per_segment;
+    uint32_t offset = sizeof(ring_log_header_t) + (index % log->records_per_segment) * record_length;
+
+    if (cursor->file == NULL || cursor->sequence != sequence) {
+        char filename[RING_LOG_MAX_NAME + 5];
+        filesystem_close(cursor->file);
+        _ring_log_filename(log, sequence, filename);
+        cursor->file = filesystem_open(filename);
+        cursor->sequence = sequence;
+        if (cursor->file == NULL) return false;
+    }
+
+    if (!filesystem_seek(cursor->file, offset) || filesystem_read(cursor->file, buf, record_length) != record_length) return false;
+    if (timestamp) memcpy(timestamp, buf, sizeof(uint32_t));
+    if (record) memcpy(record, buf + sizeof(uint32_t), log->record_size);
+    return true;
+}
+
+bool ring_log_read(ring_log_t *log, uint32_t index, uint32_t *timestamp, void *record) {
+    ring_log_cursor_t cursor = { 0 };
+    bool success = _ring_log_read_at(log, &cursor, index, timestamp, record);
+    filesystem_close(cursor.file);
+    return success;
+}
+
+uint32_t ring_log_read_records(ring_log_t *log, uint32_t index, uint32_t count, uint32_t *timestamps, void *records) {
+    ring_log_cursor_t cursor = { 0 };
+    uint32_t done;
+
+    for (done = 0; done < count; done++) {
+        if (!_ring_log_read_at(log, &cursor, index + done,
+                               timestamps ? &timestamps[done] : NULL,
+                               records ? (uint8_t *)records + done * log->record_size : NULL)) break;
+    }
+
+    filesystem_close(cursor.file);
+    return done;
+}
+
+uint32_t ring_log_find(ring_log_t *log, uint32_t timestamp) {
+    ring_log_cursor_t cursor = { 0 };
+    uint32_t low = 0;
+    uint32_t high = ring_log_count(log);
+
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        uint32_t middle_timestamp;
+        if (!_ring_log_read_at(log, &cursor, middle, &middle_timestamp, NULL)) break;
+        if (middle_timestamp < timestamp) low = middle + 1;
+        else high = middle;
+    }
+
+    filesystem_close(cursor.file);
+    return low;
+}
+
+void ring_log_clear(ring_log_t *log) {
+    char filename[RING_LOG_MAX_NAME + 5];
+
+    for (uint8_t slot = 0; slot < log->num_segments; slot++) {
+        _ring_log_filename(log, slot, filename);
+        if (filesystem_file_exists(filename)) filesystem_rm(filename);
+    }
+    log->live_segments = 0;
+    log->newest_count = 0;
+}
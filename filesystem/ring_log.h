@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Ring logs keep the most recent fixed-size, timestamped records of a face in the filesystem, so that they
+ * survive a reset.
+ *
+ * A log is split into num_segments files named "<name>.0", "<name>.1", ... Each file starts with an 8 byte
+ * header that holds the segment's sequence number and the record size, followed by up to
+ * records_per_segment records of a 32 bit timestamp and record_size bytes. Records are appended to the
+ * newest segment; once it is full, the segment with the oldest records is truncated and reused as the newest
+ * one. Appending thus never copies more than one segment, and a log never takes more than num_segments
+ * segments of flash. It holds at least (num_segments - 1) * records_per_segment records once it has wrapped
+ * around.
+ *
+ * A segment should fit into one block of the filesystem (256 bytes), since littlefs copies the last block
+ * of a file when appending to it. Timestamps are expected not to decrease, which lets ring_log_find
+ * locate records by time with a binary search.
+ */
+
+/// Longest base name of a log; segments append ".<n>".
+#define RING_LOG_MAX_NAME 8
+
+/// Largest record, not counting the timestamp.
+#define RING_LOG_MAX_RECORD_SIZE 32
+
+/// Most segments per log.
+#define RING_LOG_MAX_SEGMENTS 10
+
+typedef struct {
+    char name[RING_LOG_MAX_NAME + 1];
+    uint8_t record_size;            // bytes of data per record, not counting the timestamp
+    uint8_t num_segments;
+    uint8_t records_per_segment;
+    uint32_t newest_sequence;       // sequence number of the segment that is appended to
+    uint8_t newest_count;           // records in the newest segment
+    uint8_t live_segments;          // segments that hold records, including the newest
+} ring_log_t;
+
+/** @brief Opens a ring log, or creates it on the first append.
+  * @param log The log to set up.
+  * @param name The base name of the segment files, at most RING_LOG_MAX_NAME characters.
+  * @param record_size Bytes of data per record, at most RING_LOG_MAX_RECORD_SIZE.
+  * @param records_per_segment Records per segment file.
+  * @param num_segments Segment files of the log, from 2 to RING_LOG_MAX_SEGMENTS.
+  * @return true if the log was opened; false if the parameters are invalid.
+  * @note Opening reads the header of every segment, so faces should do it once, in setup. Segments
+  *       written with a different record size are ignored and overwritten.
+  */
+bool ring_log_open(ring_log_t *log, const char *name, uint8_t record_size, uint8_t records_per_segment, uint8_t num_segments);
+
+/** @brief Appends a record, dropping the oldest segment of records if the log is full.
+  * @param log An open log.
+  * @param timestamp The time of the record, usually a UTC UNIX timestamp.
+  * @param record record_size bytes of data.
+  * @return true if the record was written; false otherwise.
+  */
+bool ring_log_append(ring_log_t *log, uint32_t timestamp, const void *record);
+
+/** @brief Gets the number of records in a log.
+  * @param log An open log.
+  * @return the number of records that can be read with ring_log_read.
+  */
+uint32_t ring_log_count(const ring_log_t *log);
+
+/** @brief Reads a record by index.
+  * @param log An open log.
+  * @param index The index of the record, 0 being the oldest and ring_log_count() - 1 the newest.
+  * @param timestamp Receives the record's timestamp; may be NULL.
+  * @param record Receives record_size bytes of data; may be NULL.
+  * @return true if the record was read; false if the index is out of range or the read failed.
+  */
+bool ring_log_read(ring_log_t *log, uint32_t index, uint32_t *timestamp, void *record);
+
+/** @brief Reads consecutive records, e.g. to export a log piece by piece.
+  * @param log An open log.
+  * @param index The index of the first record, 0 being the oldest.
+  * @param count The most records to read.
+  * @param timestamps Receives a timestamp per record; may be NULL.
+  * @param records Receives record_size bytes per record, packed; may be NULL.
+  * @return the number of records read, less than count at the end of the log or if a read failed.
+  * @note Unlike repeated calls to ring_log_read, this opens each segment only once.
+  */
+uint32_t ring_log_read_records(ring_log_t *log, uint32_t index, uint32_t count, uint32_t *timestamps, void *records);
+
+/** @brief Finds the first record at or after a time.
+  * @param log An open log.
+  * @param timestamp The time to look for.
+  * @return the index of the oldest record whose timestamp is not less than timestamp, or
+  *         ring_log_count() if there is none. The records from ring_log_find(log, start) up to but
+  *         not including ring_log_find(log, end) are those in [start, end).
+  */
+uint32_t ring_log_find(ring_log_t *log, uint32_t timestamp);
+
+/** @brief Removes all records of a log.
+  * @param log An open log.
+  */
+void ring_log_clear(ring_log_t *log);
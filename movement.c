@@ -34,11 +34,15 @@
 #include "app.h"
 #include "watch.h"
 #include "watch_utility.h"
+#include "watch_calendar.h"
+#include "watch_trace.h"
 #include "usb.h"
 #include "watch_private.h"
 #include "movement.h"
 #include "filesystem.h"
+#include "kv_store.h"
 #include "shell.h"
+#include "timezone.h"
 #include "utz.h"
 #include "zones.h"
 #include "tc.h"
@@ -53,13 +57,50 @@
 #if __EMSCRIPTEN__
 #include <emscripten.h>
 void _wake_up_simulator(void);
+#elif defined(WATCH_NATIVE)
+#include "watch_native.h"
 #else
 #include "watch_usb_cdc.h"
 #endif
 
 volatile movement_state_t movement_state;
 void * watch_face_contexts[MOVEMENT_NUM_FACES];
-watch_date_time_t scheduled_tasks[MOVEMENT_NUM_FACES];
+
+/* Background tasks, kept in a binary min-heap ordered by due time. A single software timer is armed for
+   the earliest task, so the watch wakes up exactly when a task is due, also in low energy mode.
+*/
+#ifndef MOVEMENT_MAX_BACKGROUND_TASKS
+#define MOVEMENT_MAX_BACKGROUND_TASKS (MOVEMENT_NUM_FACES + 8)
+#endif
+
+typedef struct {
+    unix_timestamp_t timestamp;
+    uint8_t face_index;
+    uint8_t tag;
+} movement_background_task_t;
+
+// When each face wants to be advised at the top of the minute, @see movement_set_advisory_cadence.
+static uint8_t _movement_advisory_cadences[MOVEMENT_NUM_FACES];
+static unix_timestamp_t _movement_advisory_requests[MOVEMENT_NUM_FACES];
+static movement_advisory_stats_t _movement_advisory_stats;
+
+static movement_background_task_t _movement_background_tasks[MOVEMENT_MAX_BACKGROUND_TASKS];
+static uint8_t _movement_num_background_tasks;
+static uint8_t _movement_background_task_tag;
+static watch_rtc_timer_t _movement_background_task_timer;
+// Replaces the periodic tick while the face in the foreground is tickless, @see movement_set_next_display_change.
+static watch_rtc_timer_t _movement_display_change_timer;
+// Per-face CPU time accounting, @see movement_get_face_perf.
+static movement_face_perf_t _movement_face_perf[MOVEMENT_NUM_FACES];
+static rtc_counter_t _movement_perf_since;
+static uint32_t _movement_perf_face_switches;
+// ticks of the current wakeup that have already been booked to a particular face.
+static uint32_t _movement_perf_booked_ticks;
+
+// UTC and local date and time, advanced incrementally; @see movement_get_local_calendar.
+static watch_calendar_t _movement_utc_calendar;
+static watch_calendar_t _movement_local_calendar;
+
 const int32_t movement_le_inactivity_deadlines[8] = {INT_MAX, 600, 3600, 7200, 21600, 43200, 86400, 604800};
 const int16_t movement_timeout_inactivity_deadlines[4] = {60, 120, 300, 1800};
 
@@ -83,7 +124,7 @@ typedef struct {
    The interrupt writes state changes here, and it will be acted upon on the next app_loop invokation.
 */
 typedef struct {
-    volatile uint32_t pending_events;
+    volatile bool pending_activate;
     volatile bool turn_led_off;
     volatile bool has_pending_sequence;
     volatile bool enter_sleep_mode;
@@ -108,6 +149,33 @@ typedef struct {
 
 movement_volatile_state_t movement_volatile_state;
 
+/* Events raised by the interrupt callbacks, in the order in which they happened.
+   This is a single-producer/single-consumer ring: the interrupt callbacks are the only producers and
+   app_loop is the only consumer. The callbacks run at the same interrupt priority and never preempt each
+   other, so head is only ever written by the producer and tail only by the consumer, and no locking is
+   needed. Events raised while the ring is full are dropped and counted as overruns.
+*/
+#define MOVEMENT_EVENT_QUEUE_SIZE 32 // must be a power of two that divides 256
+
+#define MOVEMENT_CURRENT_FACE 0xFF
+
+typedef struct {
+    uint8_t event_type;
+    uint8_t subsecond;
+    uint8_t face_index; // the face to deliver the event to, or MOVEMENT_CURRENT_FACE
+    rtc_counter_t counter;
+} movement_queued_event_t;
+
+typedef struct {
+    movement_queued_event_t events[MOVEMENT_EVENT_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t tail;
+    uint8_t high_water;
+    uint16_t overruns;
+} movement_event_queue_t;
+
+static volatile movement_event_queue_t _movement_event_queue;
+
 // The last sequence that we have been asked to play while the watch was in deep sleep
 static int8_t *_pending_sequence;
 
@@ -125,9 +193,6 @@ int8_t alarm_tune[] = {
     0
 };
 
-int8_t _movement_dst_offset_cache[NUM_ZONE_NAMES] = {0};
-#define TIMEZONE_DOES_NOT_OBSERVE (-127)
-
 void cb_mode_btn_interrupt(void);
 void cb_light_btn_interrupt(void);
 void cb_alarm_btn_interrupt(void);
@@ -146,7 +211,7 @@ void cb_buzzer_stop(void);
 void cb_accelerometer_event(void);
 void cb_accelerometer_wake(void);
 
-#if __EMSCRIPTEN__
+#if __EMSCRIPTEN__ || defined(WATCH_NATIVE)
 void yield(void) {
 }
 #else
@@ -156,18 +221,6 @@ void yield(void) {
 }
 #endif
 
-static udatetime_t _movement_convert_date_time_to_udate(watch_date_time_t date_time) {
-    return (udatetime_t) {
-        .date.dayofmonth = date_time.unit.day,
-        .date.dayofweek = dayofweek(UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR), date_time.unit.month, date_time.unit.day),
-        .date.month = date_time.unit.month,
-        .date.year = UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR),
-        .time.hour = date_time.unit.hour,
-        .time.minute = date_time.unit.minute,
-        .time.second = date_time.unit.second
-    };
-}
-
 static watch_buzzer_volume_t _movement_get_buzzer_volume(movement_buzzer_priority_t priority) {
     switch (priority) {
         case BUZZER_PRIORITY_BUTTON:
@@ -216,35 +269,6 @@ static void _movement_set_top_of_minute_alarm() {
     movement_volatile_state.schedule_next_comp = true;
 }
 
-static bool _movement_update_dst_offset_cache(void) {
-    uzone_t local_zone;
-    udatetime_t udate_time;
-    bool dst_changed = false;
-    watch_date_time_t system_date_time = watch_rtc_get_date_time();
-
-    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
-        unpack_zone(&zone_defns[i], "", &local_zone);
-        watch_date_time_t date_time = watch_utility_date_time_convert_zone(system_date_time, 0, local_zone.offset.hours * 3600 + local_zone.offset.minutes * 60);
-
-        if (!!local_zone.rules_len) {
-            // if local zone has DST rules, we need to see if DST applies.
-            udate_time = _movement_convert_date_time_to_udate(date_time);
-            uoffset_t offset;
-            get_current_offset(&local_zone, &udate_time, &offset);
-            int8_t new_offset = (offset.hours * 60 + offset.minutes) / 15;
-            if (_movement_dst_offset_cache[i] != new_offset) {
-                _movement_dst_offset_cache[i] = new_offset;
-                dst_changed = true;
-            }
-        } else {
-            // otherwise set the cache to a constant value that indicates no DST check needs to be performed.
-            _movement_dst_offset_cache[i] = TIMEZONE_DOES_NOT_OBSERVE;
-        }
-    }
-
-    return dst_changed;
-}
-
 static inline void _movement_reset_inactivity_countdown(void) {
     rtc_counter_t counter = watch_rtc_get_counter();
     uint32_t freq = watch_rtc_get_frequency();
@@ -301,6 +325,85 @@ static uint32_t _movement_get_accelerometer_events() {
     return accelerometer_events;
 }
 
+static void _movement_queue_event_for_face(movement_event_type_t event_type, uint8_t face_index) {
+    // callbacks report EVENT_NONE when there is nothing to do, e.g. for a bounced button.
+    if (event_type == EVENT_NONE) return;
+
+    uint8_t head = _movement_event_queue.head;
+    uint8_t queued = head - _movement_event_queue.tail;
+
+    if (queued >= MOVEMENT_EVENT_QUEUE_SIZE) {
+        _movement_event_queue.overruns++;
+        return;
+    }
+
+    volatile movement_queued_event_t *slot = &_movement_event_queue.events[head & (MOVEMENT_EVENT_QUEUE_SIZE - 1)];
+    slot->event_type = event_type;
+    slot->subsecond = movement_volatile_state.subsecond;
+    slot->face_index = face_index;
+    slot->counter = watch_rtc_get_counter();
+
+    // only publish the slot once it has been written.
+    _movement_event_queue.head = head + 1;
+
+    if (queued + 1 > _movement_event_queue.high_water) {
+        _movement_event_queue.high_water = queued + 1;
+    }
+}
+
+static inline void _movement_queue_event(movement_event_type_t event_type) {
+    _movement_queue_event_for_face(event_type, MOVEMENT_CURRENT_FACE);
+}
+
+static bool _movement_dequeue_event(movement_queued_event_t *event) {
+    uint8_t tail = _movement_event_queue.tail;
+
+    if (tail == _movement_event_queue.head) return false;
+
+    volatile movement_queued_event_t *slot = &_movement_event_queue.events[tail & (MOVEMENT_EVENT_QUEUE_SIZE - 1)];
+    event->event_type = slot->event_type;
+    event->subsecond = slot->subsecond;
+    event->face_index = slot->face_index;
+    event->counter = slot->counter;
+
+    // only release the slot once it has been read.
+    _movement_event_queue.tail = tail + 1;
+
+    return true;
+}
+
+static inline bool _movement_has_queued_events(void) {
+    return _movement_event_queue.tail != _movement_event_queue.head;
+}
+
+static inline bool _movement_loop_face(uint8_t face_index, movement_event_t event) {
+    _movement_face_perf[face_index].events++;
+    WATCH_TRACE_SET_FACE(face_index);
+    WATCH_TRACE_EVENT(WATCH_TRACE_FACE_LOOP, event.event_type);
+    bool can_sleep = watch_faces[face_index].loop(event, watch_face_contexts[face_index]);
+    WATCH_TRACE_EVENT(WATCH_TRACE_FACE_LOOP_DONE, can_sleep);
+    // records logged from interrupts belong to the face in the foreground.
+    WATCH_TRACE_SET_FACE(movement_state.current_face_idx);
+    return can_sleep;
+}
+
+// Books the ticks since start to a face. Reading the counter is all it costs, so this stays enabled.
+static void _movement_perf_book(uint8_t face_index, rtc_counter_t start, bool background) {
+    uint32_t ticks = watch_rtc_get_counter() - start;
+
+    if (background) _movement_face_perf[face_index].background_ticks += ticks;
+    else _movement_face_perf[face_index].awake_ticks += ticks;
+    _movement_perf_booked_ticks += ticks;
+}
+
+// Books whatever part of a wakeup that began at start has not been booked to another face yet.
+static void _movement_perf_book_wakeup(uint8_t face_index, rtc_counter_t start) {
+    uint32_t ticks = watch_rtc_get_counter() - start;
+
+    _movement_face_perf[face_index].awake_ticks += ticks - _movement_perf_booked_ticks;
+    _movement_perf_booked_ticks = 0;
+}
+
 static void _movement_handle_button_presses(uint32_t pending_events) {
     bool any_up = false;
     bool any_down = false;
@@ -369,57 +472,162 @@ static void _movement_handle_button_presses(uint32_t pending_events) {
     }
 }
 
-static void _movement_handle_top_of_minute(void) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
+static bool _movement_advisory_is_due(uint8_t face_index, unix_timestamp_t now, watch_date_time_t local_date_time) {
+    if (_movement_advisory_requests[face_index] && _movement_advisory_requests[face_index] <= now) {
+        _movement_advisory_requests[face_index] = 0;
+        return true;
+    }
 
-    // update the DST offset cache every 30 minutes, since someplace in the world could change.
-    if (date_time.unit.minute % 30 == 0) {
-        _movement_update_dst_offset_cache();
+    switch (_movement_advisory_cadences[face_index]) {
+        case MOVEMENT_ADVISE_EVERY_MINUTE:
+            return true;
+        case MOVEMENT_ADVISE_HOURLY:
+            return local_date_time.unit.minute == 0;
+        case MOVEMENT_ADVISE_DAILY:
+            return local_date_time.unit.hour == 0 && local_date_time.unit.minute == 0;
+        default:
+            return false;
     }
+}
+
+static void _movement_handle_top_of_minute(void) {
+    unix_timestamp_t now = watch_rtc_get_unix_time();
+    watch_date_time_t local_date_time = movement_get_local_date_time();
 
     for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
         // For each face that offers an advisory...
         if (watch_faces[i].advise != NULL) {
+            // ...unless it told us it has nothing to say right now...
+            if (!_movement_advisory_is_due(i, now, local_date_time)) {
+                _movement_advisory_stats.skipped++;
+                continue;
+            }
+
             // ...we ask for one.
+            rtc_counter_t start = watch_rtc_get_counter();
+            _movement_advisory_stats.advised++;
             movement_watch_face_advisory_t advisory = watch_faces[i].advise(watch_face_contexts[i]);
 
             // If it wants a background task...
             if (advisory.wants_background_task) {
                 // we give it one. pretty straightforward!
                 movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
+                _movement_loop_face(i, background_event);
             }
 
             // TODO: handle other advisory types
+
+            _movement_perf_book(i, start, true);
         }
     }
 }
 
-static void _movement_handle_scheduled_tasks(void) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
-    uint8_t num_active_tasks = 0;
+static void _movement_background_task_timer_expired(watch_rtc_timer_t *timer) {
+    _movement_queue_event(EVENT_BACKGROUND_TASK);
+}
 
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg) {
-            if (scheduled_tasks[i].reg <= date_time.reg) {
-                scheduled_tasks[i].reg = 0;
-                movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, watch_face_contexts[i]);
-                // check if loop scheduled a new task
-                if (scheduled_tasks[i].reg) {
-                    num_active_tasks++;
-                }
-            } else {
-                num_active_tasks++;
-            }
+// Returns the counter value at which the given second begins. Timestamps more than a day away are clamped to a
+// day from now, to keep the deadline well within the counter's range.
+static rtc_counter_t _movement_counter_for_timestamp(unix_timestamp_t timestamp) {
+    // The second changes when the subsecond counter passes half of a second, see watch_rtc_set_unix_time.
+    rtc_counter_t counter = watch_rtc_get_counter();
+    unix_timestamp_t now = watch_rtc_get_unix_time();
+    uint32_t freq = watch_rtc_get_frequency();
+    rtc_counter_t start_of_second = counter - ((counter - (freq >> 1)) & (freq - 1));
+
+    uint32_t seconds = timestamp > now ? timestamp - now : 0;
+    if (seconds > 86400) seconds = 86400;
+
+    return start_of_second + seconds * freq;
+}
+
+static void _movement_arm_background_task_timer(void) {
+    movement_state.has_scheduled_background_task = _movement_num_background_tasks > 0;
+
+    if (_movement_num_background_tasks == 0) {
+        watch_rtc_timer_stop(&_movement_background_task_timer);
+        return;
+    }
+
+    // Far away tasks are approached in steps of a day; the timer just fires again if nothing is due yet.
+    rtc_counter_t deadline = _movement_counter_for_timestamp(_movement_background_tasks[0].timestamp);
+    watch_rtc_timer_start(&_movement_background_task_timer, _movement_background_task_timer_expired, NULL, deadline, 0);
+}
+
+static inline bool _movement_background_task_before(uint8_t a, uint8_t b) {
+    return _movement_background_tasks[a].timestamp < _movement_background_tasks[b].timestamp;
+}
+
+static void _movement_background_task_swap(uint8_t a, uint8_t b) {
+    movement_background_task_t tmp = _movement_background_tasks[a];
+    _movement_background_tasks[a] = _movement_background_tasks[b];
+    _movement_background_tasks[b] = tmp;
+}
+
+static void _movement_background_task_sift_up(uint8_t i) {
+    while (i > 0 && _movement_background_task_before(i, (i - 1) / 2)) {
+        _movement_background_task_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void _movement_background_task_sift_down(uint8_t i) {
+    while (true) {
+        uint8_t smallest = i;
+        uint8_t left = 2 * i + 1;
+        uint8_t right = 2 * i + 2;
+        if (left < _movement_num_background_tasks && _movement_background_task_before(left, smallest)) smallest = left;
+        if (right < _movement_num_background_tasks && _movement_background_task_before(right, smallest)) smallest = right;
+        if (smallest == i) return;
+        _movement_background_task_swap(i, smallest);
+        i = smallest;
+    }
+}
+
+static void _movement_background_task_remove_at(uint8_t i) {
+    _movement_num_background_tasks--;
+    if (i == _movement_num_background_tasks) return;
+
+    _movement_background_tasks[i] = _movement_background_tasks[_movement_num_background_tasks];
+    _movement_background_task_sift_up(i);
+    _movement_background_task_sift_down(i);
+}
+
+// Removes the tasks of a face that match the tag, or all of them if all_tags is set. Returns true if the earliest task was removed.
+static bool _movement_background_task_remove(uint8_t watch_face_index, uint8_t tag, bool all_tags) {
+    bool removed_first = false;
+
+    for (int16_t i = 0; i < _movement_num_background_tasks; i++) {
+        movement_background_task_t *task = &_movement_background_tasks[i];
+        if (task->face_index == watch_face_index && (all_tags || task->tag == tag)) {
+            removed_first = removed_first || i == 0;
+            _movement_background_task_remove_at(i);
+            if (!all_tags) break;
+            // removing reorders the heap, so start over. There are only a few tasks.
+            i = -1;
         }
     }
 
-    if (num_active_tasks == 0) {
-        movement_state.has_scheduled_background_task = false;
-    } else {
-        _movement_reset_inactivity_countdown();
+    return removed_first;
+}
+
+static void _movement_handle_scheduled_tasks(void) {
+    unix_timestamp_t now = watch_rtc_get_unix_time();
+
+    while (_movement_num_background_tasks > 0 && _movement_background_tasks[0].timestamp <= now) {
+        movement_background_task_t task = _movement_background_tasks[0];
+        _movement_background_task_remove_at(0);
+
+        // the face may schedule new tasks from here, including one for the same tag.
+        rtc_counter_t start = watch_rtc_get_counter();
+        _movement_background_task_tag = task.tag;
+        movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
+        _movement_loop_face(task.face_index, background_event);
+        _movement_background_task_tag = 0;
+        _movement_perf_book(task.face_index, start, true);
     }
+
+    _movement_arm_background_task_timer();
 }
 
 void movement_request_tick_frequency(uint8_t freq) {
@@ -427,6 +635,9 @@ void movement_request_tick_frequency(uint8_t freq) {
     // If we are asked for an invalid frequency, default back to 1 Hz.
     if (freq == 0 || __builtin_popcount(freq) != 1) freq = 1;
 
+    // leave tickless mode, if the face was in it
+    watch_rtc_timer_stop(&_movement_display_change_timer);
+
     // disable all periodic callbacks
     watch_rtc_disable_matching_periodic_callbacks(0xFF);
 
@@ -442,6 +653,111 @@ void movement_request_tick_frequency(uint8_t freq) {
     watch_rtc_register_periodic_callback(cb_tick, freq);
 }
 
+static void _movement_display_change_timer_expired(watch_rtc_timer_t *timer) {
+    (void) timer;
+    movement_volatile_state.subsecond = 0;
+    _movement_queue_event(EVENT_TICK);
+}
+
+void movement_set_next_display_change(uint32_t timestamp) {
+    // the periodic tick is not needed while the face tells us when to wake it.
+    if (movement_state.tick_frequency != 0) {
+        watch_rtc_disable_matching_periodic_callbacks(0xFF);
+        movement_state.tick_frequency = 0;
+    }
+
+    watch_rtc_timer_start(&_movement_display_change_timer, _movement_display_change_timer_expired, NULL, _movement_counter_for_timestamp(timestamp), 0);
+}
+
+static void _movement_timer_expired(watch_rtc_timer_t *rtc_timer) {
+    movement_timer_t *timer = (movement_timer_t *)rtc_timer->context;
+
+    // only the interrupt writes fired and only the main loop writes handled, so no locking is needed.
+    if ((uint8_t)(timer->fired + 1) != timer->handled) timer->fired++;
+    _movement_queue_event_for_face(EVENT_TIMER, timer->face_index);
+}
+
+static rtc_counter_t _movement_ms_to_ticks(uint32_t ms) {
+    uint32_t freq = watch_rtc_get_frequency();
+    // round up, so that a timer never expires early.
+    return (ms / 1000) * freq + ((ms % 1000) * freq + 999) / 1000;
+}
+
+void movement_timer_start(movement_timer_t *timer, uint32_t delay_ms, uint32_t period_ms) {
+    watch_rtc_timer_stop(&timer->rtc_timer);
+    timer->face_index = movement_state.current_face_idx;
+    timer->handled = timer->fired;
+
+    rtc_counter_t deadline = watch_rtc_get_counter() + _movement_ms_to_ticks(delay_ms);
+    rtc_counter_t period = _movement_ms_to_ticks(period_ms);
+    watch_rtc_timer_start(&timer->rtc_timer, _movement_timer_expired, timer, deadline, period);
+}
+
+void movement_timer_stop(movement_timer_t *timer) {
+    watch_rtc_timer_stop(&timer->rtc_timer);
+    timer->handled = timer->fired;
+}
+
+bool movement_timer_is_running(movement_timer_t *timer) {
+    return watch_rtc_timer_is_active(&timer->rtc_timer);
+}
+
+bool movement_timer_fired(movement_timer_t *timer) {
+    if (timer->handled == timer->fired) return false;
+    timer->handled++;
+
+    return true;
+}
+
+void movement_set_advisory_cadence(movement_advisory_cadence_t cadence) {
+    movement_set_advisory_cadence_for_face(movement_state.current_face_idx, cadence);
+}
+
+void movement_set_advisory_cadence_for_face(uint8_t watch_face_index, movement_advisory_cadence_t cadence) {
+    _movement_advisory_cadences[watch_face_index] = cadence;
+}
+
+void movement_request_advisory_at(uint8_t watch_face_index, uint32_t timestamp) {
+    _movement_advisory_requests[watch_face_index] = timestamp;
+}
+
+movement_advisory_stats_t movement_get_advisory_stats(void) {
+    return _movement_advisory_stats;
+}
+
+movement_event_queue_stats_t movement_get_event_queue_stats(void) {
+    movement_event_queue_stats_t stats;
+    stats.queued = _movement_event_queue.head - _movement_event_queue.tail;
+    stats.high_water = _movement_event_queue.high_water;
+    stats.overruns = _movement_event_queue.overruns;
+
+    return stats;
+}
+
+movement_perf_stats_t movement_get_perf_stats(void) {
+    movement_perf_stats_t stats = {0};
+    stats.elapsed_ticks = watch_rtc_get_counter() - _movement_perf_since;
+    stats.face_switches = _movement_perf_face_switches;
+    for (uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        stats.awake_ticks += _movement_face_perf[i].awake_ticks + _movement_face_perf[i].background_ticks;
+    }
+
+    return stats;
+}
+
+bool movement_get_face_perf(uint8_t watch_face_index, movement_face_perf_t *perf) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return false;
+    *perf = _movement_face_perf[watch_face_index];
+
+    return true;
+}
+
+void movement_reset_perf(void) {
+    memset(_movement_face_perf, 0, sizeof(_movement_face_perf));
+    _movement_perf_face_switches = 0;
+    _movement_perf_since = watch_rtc_get_counter();
+}
+
 void movement_illuminate_led(void) {
     if (movement_state.settings.bit.led_duration != 0b111) {
         movement_state.light_on = true;
@@ -533,23 +849,46 @@ void movement_cancel_background_task(void) {
 }
 
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time) {
-    watch_date_time_t now = watch_rtc_get_date_time();
-    if (date_time.reg > now.reg) {
-        movement_state.has_scheduled_background_task = true;
-        scheduled_tasks[watch_face_index].reg = date_time.reg;
-    }
+    movement_schedule_background_task_at(watch_face_index, watch_utility_date_time_to_unix_time(date_time, 0), 0);
 }
 
 void movement_cancel_background_task_for_face(uint8_t watch_face_index) {
-    scheduled_tasks[watch_face_index].reg = 0;
-    bool other_tasks_scheduled = false;
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg != 0) {
-            other_tasks_scheduled = true;
-            break;
-        }
+    if (_movement_background_task_remove(watch_face_index, 0, true)) {
+        _movement_arm_background_task_timer();
+    }
+}
+
+bool movement_schedule_background_task_at(uint8_t watch_face_index, uint32_t timestamp, uint8_t tag) {
+    if (timestamp <= watch_rtc_get_unix_time()) return false;
+
+    bool removed_first = _movement_background_task_remove(watch_face_index, tag, false);
+
+    if (_movement_num_background_tasks == MOVEMENT_MAX_BACKGROUND_TASKS) {
+        if (removed_first) _movement_arm_background_task_timer();
+        return false;
+    }
+
+    uint8_t i = _movement_num_background_tasks++;
+    _movement_background_tasks[i].timestamp = timestamp;
+    _movement_background_tasks[i].face_index = watch_face_index;
+    _movement_background_tasks[i].tag = tag;
+    _movement_background_task_sift_up(i);
+
+    if (removed_first || _movement_background_tasks[0].timestamp == timestamp) {
+        _movement_arm_background_task_timer();
+    }
+
+    return true;
+}
+
+void movement_cancel_background_task_with_tag(uint8_t watch_face_index, uint8_t tag) {
+    if (_movement_background_task_remove(watch_face_index, tag, false)) {
+        _movement_arm_background_task_timer();
     }
-    movement_state.has_scheduled_background_task = other_tasks_scheduled;
+}
+
+uint8_t movement_get_background_task_tag(void) {
+    return _movement_background_task_tag;
 }
 
 void movement_request_sleep(void) {
@@ -649,15 +988,8 @@ uint8_t movement_claim_backup_register(void) {
 }
 
 int32_t movement_get_current_timezone_offset_for_zone(uint8_t zone_index) {
-    int8_t cached_dst_offset = _movement_dst_offset_cache[zone_index];
-
-    if (cached_dst_offset == TIMEZONE_DOES_NOT_OBSERVE) {
-        // if time zone doesn't observe DST, we can just return the standard time offset from the zone definition.
-        return (int32_t)zone_defns[zone_index].offset_inc_minutes * OFFSET_INCREMENT * 60;
-    } else {
-        // otherwise, we've precalculated the offset for this zone and can return it.
-        return (int32_t)cached_dst_offset * OFFSET_INCREMENT * 60;
-    }
+    // the offset is cached until the zone's next DST transition, so this is cheap.
+    return timezone_get_offset(zone_index, watch_rtc_get_unix_time());
 }
 
 int32_t movement_get_current_timezone_offset(void) {
@@ -665,19 +997,9 @@ int32_t movement_get_current_timezone_offset(void) {
 }
 
 int32_t movement_get_timezone_offset_for_date_in_zone(watch_date_time_t date_time, uint8_t zone_index) {
-    int8_t cached_dst_offset = _movement_dst_offset_cache[zone_index];
-
-    if (cached_dst_offset == TIMEZONE_DOES_NOT_OBSERVE) {
-        return (int32_t)zone_defns[zone_index].offset_inc_minutes * OFFSET_INCREMENT * 60;
-    }
-
-    // Compute the offset for the given date using the zone's DST rules
-    uzone_t local_zone;
-    unpack_zone(&zone_defns[zone_index], "", &local_zone);
-    udatetime_t udt = _movement_convert_date_time_to_udate(date_time);
-    uoffset_t offset;
-    get_current_offset(&local_zone, &udt, &offset);
-    return (int32_t)(offset.hours * 60 + offset.minutes) * 60;
+    // the date is taken to be in the zone's standard time, which is what the DST rules are written in.
+    uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, timezone_get_standard_offset(zone_index));
+    return timezone_get_offset(zone_index, timestamp);
 }
 
 int32_t movement_get_timezone_offset_for_date(watch_date_time_t date_time) {
@@ -692,30 +1014,34 @@ void movement_set_timezone_index(uint8_t value) {
     movement_state.settings.bit.time_zone = value;
 }
 
-watch_date_time_t movement_get_utc_date_time(void) {
-    return watch_rtc_get_date_time();
+const watch_calendar_t *movement_get_utc_calendar(void) {
+    watch_calendar_update(&_movement_utc_calendar, watch_rtc_get_unix_time(), 0);
+    return &_movement_utc_calendar;
 }
 
-watch_date_time_t movement_get_date_time_in_zone(uint8_t zone_index) {
-    int32_t offset = movement_get_current_timezone_offset_for_zone(zone_index);
+const watch_calendar_t *movement_get_local_calendar(void) {
+    // the offset is cached by the time zone module and the calendar only advances by the elapsed seconds,
+    // so calling this on every tick is cheap.
     unix_timestamp_t timestamp = watch_rtc_get_unix_time();
-    return watch_utility_date_time_from_unix_time(timestamp, offset);
+    watch_calendar_update(&_movement_local_calendar, timestamp, movement_get_current_timezone_offset());
+    return &_movement_local_calendar;
 }
 
-watch_date_time_t movement_get_local_date_time(void) {
-    static struct {
-        unix_timestamp_t timestamp;
-        rtc_date_time_t datetime;
-    } cached_date_time = {.datetime.reg=0, .timestamp=0};
+watch_date_time_t movement_get_utc_date_time(void) {
+    return movement_get_utc_calendar()->date_time;
+}
 
-    unix_timestamp_t timestamp = watch_rtc_get_unix_time();
+watch_date_time_t movement_get_date_time_in_zone(uint8_t zone_index) {
+    if (zone_index == movement_state.settings.bit.time_zone) return movement_get_local_date_time();
 
-    if (timestamp != cached_date_time.timestamp) {
-        cached_date_time.timestamp = timestamp;
-        cached_date_time.datetime = watch_utility_date_time_from_unix_time(timestamp, movement_get_current_timezone_offset());
-    }
+    // shift a copy of the UTC calendar by the zone's offset; at most a day, so no full conversion.
+    watch_calendar_t calendar = *movement_get_utc_calendar();
+    watch_calendar_update(&calendar, calendar.timestamp, movement_get_current_timezone_offset_for_zone(zone_index));
+    return calendar.date_time;
+}
 
-    return cached_date_time.datetime;
+watch_date_time_t movement_get_local_date_time(void) {
+    return movement_get_local_calendar()->date_time;
 }
 
 uint32_t movement_get_utc_timestamp(void) {
@@ -734,13 +1060,15 @@ void movement_set_local_date_time(watch_date_time_t date_time) {
 void movement_set_utc_timestamp(uint32_t timestamp) {
     watch_rtc_set_unix_time(timestamp);
 
+    // setting the time is the one place where the calendars do a full conversion.
+    watch_calendar_set(&_movement_utc_calendar, timestamp, 0);
+    watch_calendar_set(&_movement_local_calendar, timestamp, movement_get_current_timezone_offset());
+
     // If the time was changed, the top of the minute alarm needs to be reset accordingly
     _movement_set_top_of_minute_alarm();
 
-    // this may seem wasteful, but if the user's local time is in a zone that observes DST,
-    // they may have just crossed a DST boundary, which means the next call to this function
-    // could require a different offset to force local time back to UTC. Quelle horreur!
-    _movement_update_dst_offset_cache();
+    // and so does the timer for the next background task.
+    _movement_arm_background_task_timer();
 }
 
 
@@ -830,6 +1158,9 @@ void movement_set_backlight_dwell(uint8_t value) {
 }
 
 void movement_store_settings(void) {
+    // the store skips unchanged values itself; settings.u32 remains for filesystems that still span its rows.
+    if (kv_store_set(KV_STORE_KEY_SETTINGS, (char *)&movement_state.settings, sizeof(movement_settings_t))) return;
+
     movement_settings_t old_settings;
     filesystem_read_file("settings.u32", (char *)&old_settings, sizeof(movement_settings_t));
     if (movement_state.settings.reg != old_settings.reg) {
@@ -934,6 +1265,8 @@ float movement_get_temperature(void) {
     temperature_c = EM_ASM_DOUBLE({
         return temp_c || 25.0;
     });
+#elif defined(WATCH_NATIVE)
+    temperature_c = 25.0;
 #else
 
     if (movement_state.has_thermistor) {
@@ -954,6 +1287,7 @@ void app_init(void) {
     _watch_init();
 
     filesystem_init();
+    kv_store_init();
 
     // check if we are plugged into USB power.
     HAL_GPIO_VBUS_DET_in();
@@ -967,7 +1301,8 @@ void app_init(void) {
 
     memset((void *)&movement_state, 0, sizeof(movement_state));
 
-    movement_volatile_state.pending_events = 0;
+    _movement_event_queue.head = 0;
+    _movement_event_queue.tail = 0;
     movement_volatile_state.turn_led_off = false;
 
     movement_volatile_state.minute_alarm_fired = false;
@@ -1002,14 +1337,18 @@ void app_init(void) {
 
     movement_state.has_thermistor = thermistor_driver_init();
 
-    bool settings_file_exists = filesystem_file_exists("settings.u32");
     movement_settings_t maybe_settings;
-    if (settings_file_exists && maybe_settings.bit.version == 0) {
-        filesystem_read_file("settings.u32", (char *) &maybe_settings, sizeof(movement_settings_t));
+    bool settings_exist = kv_store_get(KV_STORE_KEY_SETTINGS, &maybe_settings, sizeof(movement_settings_t));
+    if (!settings_exist && filesystem_file_exists("settings.u32")) {
+        // settings from before the key/value store move there, unless the filesystem still spans its rows.
+        settings_exist = filesystem_read_file("settings.u32", (char *) &maybe_settings, sizeof(movement_settings_t));
+        if (settings_exist && kv_store_set(KV_STORE_KEY_SETTINGS, &maybe_settings, sizeof(movement_settings_t))) {
+            filesystem_rm("settings.u32");
+        }
     }
 
-    if (settings_file_exists && maybe_settings.bit.version == 0) {
-        // If settings file exists and has a valid version, restore it!
+    if (settings_exist && maybe_settings.bit.version == 0) {
+        // If settings exist and have a valid version, restore them!
         movement_state.settings.reg = maybe_settings.reg;
     } else {
         // Otherwise set default values.
@@ -1059,9 +1398,6 @@ void app_init(void) {
     // this is so movement can be notified even when triggered by a face bypassing movement
     watch_buzzer_register_global_callbacks(cb_buzzer_start, cb_buzzer_stop);
 
-    // populate the DST offset cache
-    _movement_update_dst_offset_cache();
-
     if (movement_state.accelerometer_motion_threshold == 0) movement_state.accelerometer_motion_threshold = 32;
 
     movement_state.signal_volume = MOVEMENT_DEFAULT_SIGNAL_VOLUME;
@@ -1089,14 +1425,17 @@ void app_setup(void) {
 
         for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
             watch_face_contexts[i] = NULL;
-            scheduled_tasks[i].reg = 0;
             is_first_launch = false;
         }
 
+#if __EMSCRIPTEN__ || defined(WATCH_NATIVE)
 #if __EMSCRIPTEN__
         int32_t time_zone_offset = EM_ASM_INT({
             return -new Date().getTimezoneOffset();
         });
+#else
+        int32_t time_zone_offset = watch_native_get_utc_offset() / 60;
+#endif
         for (int i = 0; i < NUM_ZONE_NAMES; i++) {
             if (movement_get_current_timezone_offset_for_zone(i) == time_zone_offset * 60) {
                 movement_state.settings.bit.time_zone = i;
@@ -1183,7 +1522,7 @@ void app_setup(void) {
         }
 
         watch_faces[movement_state.current_face_idx].activate(watch_face_contexts[movement_state.current_face_idx]);
-        movement_volatile_state.pending_events |=  1 << EVENT_ACTIVATE;
+        movement_volatile_state.pending_activate = true;
     }
 }
 
@@ -1200,17 +1539,43 @@ static void _sleep_mode_app_loop(void) {
             return;
         }
 
+        rtc_counter_t wakeup_start = watch_rtc_get_counter();
+        _movement_face_perf[movement_state.current_face_idx].wakes++;
+        bool handled_tasks = false;
+
         // we also have to handle top-of-the-minute tasks here in the mini-runloop
         if (movement_volatile_state.minute_alarm_fired) {
             movement_volatile_state.minute_alarm_fired = false;
+            handled_tasks = true;
             _movement_renew_top_of_minute_alarm();
             _movement_handle_top_of_minute();
         }
 
         movement_event_t event;
-        event.event_type = EVENT_LOW_ENERGY_UPDATE;
         event.subsecond = 0;
-        watch_faces[movement_state.current_face_idx].loop(event, watch_face_contexts[movement_state.current_face_idx]);
+
+        // timers and background tasks keep running in low energy mode. Anything else in the queue was raised before we fell asleep
+        // and has no one left to receive it.
+        movement_queued_event_t queued;
+        while (_movement_dequeue_event(&queued)) {
+            handled_tasks = true;
+            if (queued.event_type == EVENT_TIMER) {
+                rtc_counter_t start = watch_rtc_get_counter();
+                event.event_type = EVENT_TIMER;
+                _movement_loop_face(queued.face_index, event);
+                _movement_perf_book(queued.face_index, start, queued.face_index != movement_state.current_face_idx);
+            } else if (queued.event_type == EVENT_BACKGROUND_TASK) {
+                _movement_handle_scheduled_tasks();
+            }
+        }
+
+        event.event_type = EVENT_LOW_ENERGY_UPDATE;
+        _movement_loop_face(movement_state.current_face_idx, event);
+
+        // background tasks may have logged something, and we may not wake again for a while.
+        if (handled_tasks) filesystem_sync();
+
+        _movement_perf_book_wakeup(movement_state.current_face_idx, wakeup_start);
 
         // If any of the previous loops requested to wake up, do it!
         if (movement_volatile_state.exit_sleep_mode) {
@@ -1235,11 +1600,16 @@ static void _sleep_mode_app_loop(void) {
 
 static bool _switch_face(void) {
     const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
+    rtc_counter_t start = watch_rtc_get_counter();
 
     wf->resign(watch_face_contexts[movement_state.current_face_idx]);
+    _movement_perf_book(movement_state.current_face_idx, start, false);
+    _movement_perf_face_switches++;
+    start = watch_rtc_get_counter();
     movement_state.current_face_idx = movement_state.next_face_idx;
     // we have just updated the face idx, so we must recache the watch face pointer.
     wf = &watch_faces[movement_state.current_face_idx];
+    watch_stop_animation();
     watch_clear_display();
     movement_request_tick_frequency(1);
 
@@ -1254,7 +1624,8 @@ static bool _switch_face(void) {
     event.subsecond = 0;
     event.event_type = EVENT_ACTIVATE;
     movement_state.watch_face_changed = false;
-    bool can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]);
+    bool can_sleep = _movement_loop_face(movement_state.current_face_idx, event);
+    _movement_perf_book(movement_state.current_face_idx, start, false);
 
     // Button events that follow a down event that happened on the previous face should not be forwarded to the new face
     movement_volatile_state.passthrough_events = _movement_button_events_mask;
@@ -1262,20 +1633,38 @@ static bool _switch_face(void) {
     return can_sleep;
 }
 
+// Checks if an interrupt left anything for app_loop to do.
+static bool _movement_has_pending_work(void) {
+    return movement_volatile_state.pending_activate ||
+           movement_volatile_state.turn_led_off ||
+           movement_volatile_state.has_pending_accelerometer ||
+           movement_volatile_state.minute_alarm_fired ||
+           movement_volatile_state.enter_sleep_mode ||
+           movement_volatile_state.schedule_next_comp ||
+           movement_state.watch_face_changed ||
+           _movement_has_queued_events() ||
+           usb_is_enabled();
+}
+
 bool app_loop(void) {
-    const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
+    // the wakeup is booked to the face that was in the foreground when it began.
+    uint8_t wakeup_face_idx = movement_state.current_face_idx;
+    rtc_counter_t wakeup_start = watch_rtc_get_counter();
+    _movement_face_perf[wakeup_face_idx].wakes++;
+
+    // the SLCD interrupt has already written the animation frame. If that was all that woke us, sleep again.
+    if (watch_animation_take_wake() && !_movement_has_pending_work()) {
+        _movement_perf_book_wakeup(wakeup_face_idx, wakeup_start);
+        return true;
+    }
 
     // default to being allowed to sleep by the face.
     bool can_sleep = true;
-
-    // Any events that have been added by the various interrupts in between app_loop invokations
-    uint32_t pending_events = movement_volatile_state.pending_events;
-    movement_volatile_state.pending_events = 0;
+    bool resign_timeout = false;
 
     movement_event_t event;
     event.event_type = EVENT_NONE;
-    // Subsecond is determined by the TICK event, if concurrent events have happened,
-    // they will all have the same subsecond as they should to keep backward compatibility.
+    // Events other than ticks carry the subsecond of the most recent tick, to keep backward compatibility.
     event.subsecond = movement_volatile_state.subsecond;
 
     // if the LED should be off, turn it off
@@ -1288,49 +1677,60 @@ bool app_loop(void) {
         }
     }
 
+    // app_setup asks for an activate event after boot and after waking from low energy mode.
+    if (movement_volatile_state.pending_activate) {
+        movement_volatile_state.pending_activate = false;
+        event.event_type = EVENT_ACTIVATE;
+        can_sleep = _movement_loop_face(movement_state.current_face_idx, event) && can_sleep;
+    }
+
+    // accelerometer events are read out here in the loop, so they do not go through the queue.
     if (movement_volatile_state.has_pending_accelerometer) {
         movement_volatile_state.has_pending_accelerometer = false;
-        pending_events |= _movement_get_accelerometer_events();
+        uint32_t accelerometer_events = _movement_get_accelerometer_events();
+        while (accelerometer_events) {
+            event.event_type = __builtin_ctz(accelerometer_events);
+            accelerometer_events &= accelerometer_events - 1;
+            can_sleep = _movement_loop_face(movement_state.current_face_idx, event) && can_sleep;
+        }
     }
 
-    // handle any button up/down events that occurred, e.g. schedule longpress timeouts, reset inactivity, etc.
-    _movement_handle_button_presses(pending_events);
-
-    // if we have a scheduled background task, handle that here:
-    if (
-        (pending_events & (1 << EVENT_TICK))
-        && event.subsecond == 0
-        && movement_state.has_scheduled_background_task
-    ) {
-        _movement_handle_scheduled_tasks();
-    }
+    // Consume the events queued by the various interrupts in between app_loop invocations, in order.
+    // Once the face asks to be switched, the remaining events are left for the next face.
+    movement_queued_event_t queued;
+    while (!movement_state.watch_face_changed && _movement_dequeue_event(&queued)) {
+        uint32_t event_mask = 1 << queued.event_type;
+        event.event_type = queued.event_type;
+        event.subsecond = queued.subsecond;
+
+        // handle button up/down events, e.g. schedule longpress timeouts, reset inactivity, etc.
+        _movement_handle_button_presses(event_mask);
+
+        // the background task timer has expired, run the tasks that are due.
+        if (queued.event_type == EVENT_BACKGROUND_TASK) {
+            _movement_handle_scheduled_tasks();
+            continue;
+        }
 
-    // Pop the EVENT_TIMEOUT out of the pending_events so it can be handled separately
-    bool resign_timeout = (pending_events & (1 << EVENT_TIMEOUT)) != 0;
-    if (resign_timeout) {
-        pending_events &= ~(1 << EVENT_TIMEOUT);
-    }
+        // EVENT_TIMEOUT is handled separately, after the top-of-minute tasks
+        if (queued.event_type == EVENT_TIMEOUT) {
+            resign_timeout = true;
+            continue;
+        }
 
-    // Consume all the pending events
-    uint32_t passthrough_pending_events = pending_events & movement_volatile_state.passthrough_events;
-    pending_events = pending_events & ~movement_volatile_state.passthrough_events;
-
-    movement_event_type_t event_type = 0;
-    while (passthrough_pending_events) {
-        uint8_t next_event = __builtin_ctz(passthrough_pending_events);
-        event.event_type = event_type + next_event;
-        can_sleep = movement_default_loop_handler(event) && can_sleep;
-        passthrough_pending_events = passthrough_pending_events >> (next_event + 1);
-        event_type = event_type + next_event + 1;
-    }
+        // timers may belong to a face in the background
+        if (queued.face_index != MOVEMENT_CURRENT_FACE && queued.face_index != movement_state.current_face_idx) {
+            rtc_counter_t start = watch_rtc_get_counter();
+            _movement_loop_face(queued.face_index, event);
+            _movement_perf_book(queued.face_index, start, true);
+            continue;
+        }
 
-    event_type = 0;
-    while (pending_events) {
-        uint8_t next_event = __builtin_ctz(pending_events);
-        event.event_type = event_type + next_event;
-        can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]) && can_sleep;
-        pending_events = pending_events >> (next_event + 1);
-        event_type = event_type + next_event + 1;
+        if (event_mask & movement_volatile_state.passthrough_events) {
+            can_sleep = movement_default_loop_handler(event) && can_sleep;
+        } else {
+            can_sleep = _movement_loop_face(movement_state.current_face_idx, event) && can_sleep;
+        }
     }
 
     // handle top-of-minute tasks, if the alarm handler told us we need to
@@ -1343,7 +1743,7 @@ bool app_loop(void) {
     // Now handle the EVENT_TIMEOUT
     if (resign_timeout && movement_state.current_face_idx != 0) {
         event.event_type = EVENT_TIMEOUT;
-        can_sleep = wf->loop(event, watch_face_contexts[movement_state.current_face_idx]) && can_sleep;
+        can_sleep = _movement_loop_face(movement_state.current_face_idx, event) && can_sleep;
     }
 
     // The watch_face_changed flag might be set again by the face loop, so check it again
@@ -1360,11 +1760,22 @@ bool app_loop(void) {
         // No need to fire resign and sleep interrupts while in sleep mode
         _movement_disable_inactivity_countdown();
 
+        // nor to wake a tickless face; it gets the low energy update at the top of the minute instead.
+        watch_rtc_timer_stop(&_movement_display_change_timer);
+        // animations would keep waking the CPU; the face draws its low energy display instead.
+        watch_stop_animation();
+        // the watch may stay asleep for days, so buffered log entries go to flash now. The sleep loop writes out
+        // whatever its own tasks log.
+        filesystem_sync();
+
         watch_register_extwake_callback(HAL_GPIO_BTN_ALARM_pin(), cb_alarm_btn_extwake, true);
 
         // _sleep_mode_app_loop takes over at this point and loops until exit_sleep_mode is set by the extwake handler,
-        // or wake is requested using the movement_request_wake function.
+        // or wake is requested using the movement_request_wake function. It does its own accounting.
+        _movement_perf_book_wakeup(wakeup_face_idx, wakeup_start);
         _sleep_mode_app_loop();
+        wakeup_face_idx = movement_state.current_face_idx;
+        wakeup_start = watch_rtc_get_counter();
         // as soon as _sleep_mode_app_loop returns, we prepare to reactivate
 
         // // this is a hack tho: waking from sleep mode, app_setup does get called, but it happens before we have reset our ticks.
@@ -1407,12 +1818,24 @@ bool app_loop(void) {
         can_sleep = false;
     }
 
+    // events left in the queue, e.g. after a face change or raised while we were busy, must be handled before sleeping.
+    if (_movement_has_queued_events()) {
+        can_sleep = false;
+    }
+
+    // everything that was drawn during this loop goes to the LCD at once.
+    watch_display_commit();
+
+    _movement_perf_book_wakeup(wakeup_face_idx, wakeup_start);
+
     return can_sleep;
 }
 
 static movement_event_type_t _process_button_event(bool pin_level, movement_button_t* button) {
     movement_event_type_t event_type = EVENT_NONE;
 
+    WATCH_TRACE_EVENT(WATCH_TRACE_BUTTON_EDGE, pin_level);
+
     // This shouldn't happen normally
     if (pin_level == button->is_down) {
         return event_type;
@@ -1448,25 +1871,26 @@ static movement_event_type_t _process_button_event(bool pin_level, movement_butt
         }
     }
 
+    WATCH_TRACE_EVENT(WATCH_TRACE_BUTTON_EVENT, event_type);
     return event_type;
 }
 
 void cb_light_btn_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_LIGHT_read();
 
-    movement_volatile_state.pending_events |= 1 << _process_button_event(pin_level, &movement_volatile_state.light_button);
+    _movement_queue_event(_process_button_event(pin_level, &movement_volatile_state.light_button));
 }
 
 void cb_mode_btn_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_MODE_read();
 
-    movement_volatile_state.pending_events |= 1 << _process_button_event(pin_level, &movement_volatile_state.mode_button);
+    _movement_queue_event(_process_button_event(pin_level, &movement_volatile_state.mode_button));
 }
 
 void cb_alarm_btn_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_ALARM_read();
 
-    movement_volatile_state.pending_events |= 1 << _process_button_event(pin_level, &movement_volatile_state.alarm_button);
+    _movement_queue_event(_process_button_event(pin_level, &movement_volatile_state.alarm_button));
 }
 
 static movement_event_type_t _process_button_longpress_timeout(bool pin_level, movement_button_t* button) {
@@ -1508,21 +1932,21 @@ void cb_light_btn_timeout_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_LIGHT_read();
     movement_button_t* button = &movement_volatile_state.light_button;
 
-    movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
+    _movement_queue_event(_process_button_longpress_timeout(pin_level, button));
 }
 
 void cb_mode_btn_timeout_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_MODE_read();
     movement_button_t* button = &movement_volatile_state.mode_button;
 
-    movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
+    _movement_queue_event(_process_button_longpress_timeout(pin_level, button));
 }
 
 void cb_alarm_btn_timeout_interrupt(void) {
     bool pin_level = HAL_GPIO_BTN_ALARM_read();
     movement_button_t* button = &movement_volatile_state.alarm_button;
 
-    movement_volatile_state.pending_events |= 1 << _process_button_longpress_timeout(pin_level, button);
+    _movement_queue_event(_process_button_longpress_timeout(pin_level, button));
 }
 
 void cb_led_timeout_interrupt(void) {
@@ -1530,7 +1954,7 @@ void cb_led_timeout_interrupt(void) {
 }
 
 void cb_resign_timeout_interrupt(void) {
-    movement_volatile_state.pending_events |= 1 << EVENT_TIMEOUT;
+    _movement_queue_event(EVENT_TIMEOUT);
 }
 
 void cb_sleep_timeout_interrupt(void) {
@@ -1555,8 +1979,9 @@ void cb_tick(void) {
     uint32_t freq = watch_rtc_get_frequency();
     uint32_t half_freq = freq >> 1;
     uint32_t subsecond_mask = freq - 1;
-    movement_volatile_state.pending_events |= 1 << EVENT_TICK;
     movement_volatile_state.subsecond = ((counter + half_freq) & subsecond_mask) >> movement_state.tick_pern;
+    WATCH_TRACE_EVENT(WATCH_TRACE_TICK, movement_state.tick_frequency);
+    _movement_queue_event(EVENT_TICK);
 }
 
 void cb_accelerometer_event(void) {
@@ -1564,7 +1989,7 @@ void cb_accelerometer_event(void) {
 }
 
 void cb_accelerometer_wake(void) {
-    movement_volatile_state.pending_events |= 1 << EVENT_ACCELEROMETER_WAKE;
+    _movement_queue_event(EVENT_ACCELEROMETER_WAKE);
     // also: wake up!
     _movement_reset_inactivity_countdown();
 }
@@ -28,6 +28,7 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include "watch.h"
+#include "watch_calendar.h"
 #include "utz.h"
 #include "lis2dw.h"
 
@@ -139,9 +140,11 @@ typedef enum {
     EVENT_ACCELEROMETER_WAKE,   // The accelerometer has detected motion and woken up.
     EVENT_SINGLE_TAP,           // Accelerometer detected a single tap. This event is not yet implemented.
     EVENT_DOUBLE_TAP,           // Accelerometer detected a double tap. This event is not yet implemented.
+    EVENT_TIMER,                // One of your movement_timer_t timers has expired. Use movement_timer_fired to find out which one. You may not be in the foreground.
 } movement_event_type_t;
 
 // Each different timeout type will use a different index when invoking watch_rtc_register_comp_callback
+// Index 7 (WATCH_RTC_TIMER_COMP_INDEX) is used by the software timers behind movement_timer_t.
 typedef enum {
     LIGHT_BUTTON_TIMEOUT = 0,   // Light button longpress timeout
     MODE_BUTTON_TIMEOUT,        // Mode button longpress timeout
@@ -163,6 +166,51 @@ typedef struct {
     uint8_t subsecond;
 } movement_event_t;
 
+// How often a face wants Movement to call its advise function at the top of the minute.
+typedef enum {
+    MOVEMENT_ADVISE_EVERY_MINUTE = 0,   // At the top of every minute. This is the default.
+    MOVEMENT_ADVISE_HOURLY,             // At the top of every hour, in local time.
+    MOVEMENT_ADVISE_DAILY,              // At midnight, in local time.
+    MOVEMENT_ADVISE_NEVER,              // Only when requested with movement_request_advisory_at.
+} movement_advisory_cadence_t;
+
+// Counts of the advise calls made and avoided at the top of the minute.
+typedef struct {
+    uint32_t advised;       // Number of times a face's advise function was called.
+    uint32_t skipped;       // Number of times a face was skipped because its cadence did not match.
+} movement_advisory_stats_t;
+
+// A timer for watch faces, @see movement_timer_start. Keep it in your watch face's context; a zeroed timer is stopped.
+typedef struct {
+    watch_rtc_timer_t rtc_timer;
+    uint8_t face_index;
+    volatile uint8_t fired;     // expirations counted by the interrupt
+    uint8_t handled;            // expirations consumed by movement_timer_fired
+} movement_timer_t;
+
+// Statistics of the queue that carries events from the interrupt callbacks to the active watch face.
+typedef struct {
+    uint8_t queued;         // Number of events currently waiting to be handled.
+    uint8_t high_water;     // Largest number of events that have been waiting at the same time.
+    uint16_t overruns;      // Number of events dropped because the queue was full.
+} movement_event_queue_stats_t;
+
+// Per-face accounting of the time the CPU is awake, in RTC counter ticks of 1/128 second. Most dispatches take far
+// less than a tick, so individual readings are coarse, but the sums over many wakeups show which face keeps the
+// watch busy. Time spent on a face's behalf in the background is booked to background_ticks, not awake_ticks.
+typedef struct {
+    uint32_t awake_ticks;       // Ticks spent awake while the face was in the foreground.
+    uint32_t background_ticks;  // Ticks spent in the face's advisories, background tasks and background timers.
+    uint32_t wakes;             // Number of app loop invocations while the face was in the foreground.
+    uint32_t events;            // Number of events delivered to the face's loop function.
+} movement_face_perf_t;
+
+typedef struct {
+    uint32_t elapsed_ticks;     // Ticks since the counters were last reset.
+    uint32_t awake_ticks;       // Ticks spent awake in total, i.e. the sum over all faces.
+    uint32_t face_switches;     // Number of times the foreground face changed.
+} movement_perf_stats_t;
+
 extern const int16_t movement_timezone_offsets[];
 
 /** @brief Perform setup for your watch face.
@@ -189,7 +237,10 @@ typedef void (*watch_face_setup)(uint8_t watch_face_index, void ** context_ptr);
   *          segments or text that is always displayed, you may want to set that here. In addition, if your
   *          watch face depends on data from a peripheral (like an I2C sensor), you will likely want to enable
   *          that peripheral here. In addition, if your watch face requires an update frequncy other than 1 Hz,
-  *          you may want to request that here using the movement_request_tick_frequency function.
+  *          you may want to request that here using the movement_request_tick_frequency function. For purely
+  *          cosmetic effects like blinking a value, a spinner or scrolling text, use the animations in
+  *          watch_slcd.h instead (e.g. watch_start_text_blink); they run without waking your face, and
+  *          Movement stops them when your face resigns.
   * @param context A pointer to your watch face's context. @see watch_face_setup.
   *
   */
@@ -198,7 +249,8 @@ typedef void (*watch_face_activate)(void *context);
 /** @brief Handle events and update the display.
   * @details This function is called in response to an event. You should set up a switch statement that handles,
   *          at the very least, the EVENT_TICK and EVENT_MODE_BUTTON_UP event types. The tick event happens once
-  *          per second (or more frequently if you asked for a faster tick with movement_request_tick_frequency).
+  *          per second (or more frequently if you asked for a faster tick with movement_request_tick_frequency,
+  *          or only when your display changes if you are tickless, @see movement_set_next_display_change).
   *          The mode button up event occurs when the user presses the MODE button. **Your loop function SHOULD
   *          call the movement_move_to_next_face function in response to this event.** If you have a good reason
   *          to override this behavior (e.g. your user interface requires all three buttons), your watch face MUST
@@ -316,6 +368,38 @@ void movement_force_led_off(void);
 
 void movement_request_tick_frequency(uint8_t freq);
 
+// Tickless mode for faces whose display changes rarely, e.g. once a minute or once a day. Call this with the UTC
+// timestamp of the next change instead of receiving a tick every second: the periodic tick is stopped and the face
+// gets a single EVENT_TICK at the start of that second, or right away if it has passed. Call it again from every
+// EVENT_ACTIVATE and EVENT_TICK to stay tickless; calling movement_request_tick_frequency returns to periodic ticks.
+// Timestamps more than a day away get an extra tick after a day. Movement returns to 1 Hz ticks on a face change.
+void movement_set_next_display_change(uint32_t timestamp);
+
+movement_event_queue_stats_t movement_get_event_queue_stats(void);
+
+movement_perf_stats_t movement_get_perf_stats(void);
+bool movement_get_face_perf(uint8_t watch_face_index, movement_face_perf_t *perf);  // false past the last face
+void movement_reset_perf(void);
+
+// Faces with an advise function are asked for an advisory every minute, which costs a wakeup of every such
+// face even when the answer is "no". Faces that only need to act at certain times should register a cadence,
+// e.g. in their setup function, and/or request a one-time advisory at a UTC timestamp. The advise function is
+// then called at the first top of the minute at which the cadence matches or the requested time has passed.
+void movement_set_advisory_cadence(movement_advisory_cadence_t cadence);
+void movement_set_advisory_cadence_for_face(uint8_t watch_face_index, movement_advisory_cadence_t cadence);
+void movement_request_advisory_at(uint8_t watch_face_index, uint32_t timestamp);
+movement_advisory_stats_t movement_get_advisory_stats(void);
+
+// Starts a timer that expires after delay_ms and then every period_ms, or only once if period_ms is 0.
+// Timers have a resolution of 1/128 second and wake the watch exactly when they expire, even in low energy mode.
+// On expiration the face that started the timer receives an EVENT_TIMER, whether or not it is in the foreground.
+// Any number of timers can run at the same time; restarting a running timer reschedules it.
+void movement_timer_start(movement_timer_t *timer, uint32_t delay_ms, uint32_t period_ms);
+void movement_timer_stop(movement_timer_t *timer);
+bool movement_timer_is_running(movement_timer_t *timer);
+// Returns true once for every expiration of the timer since it was started. Call it on EVENT_TIMER.
+bool movement_timer_fired(movement_timer_t *timer);
+
 // note: watch faces can only schedule a background task when in the foreground, since
 // movement will associate the scheduled task with the currently active face.
 void movement_schedule_background_task(watch_date_time_t date_time);
@@ -325,9 +409,18 @@ void movement_schedule_background_task(watch_date_time_t date_time);
 void movement_cancel_background_task(void);
 
 // these functions should work around the limitation of the above functions, which will be deprecated.
+// note: scheduling replaces the face's previous task with tag 0, cancelling removes all of the face's tasks.
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time_t date_time);
 void movement_cancel_background_task_for_face(uint8_t watch_face_index);
 
+// schedules a background task at a UTC unix timestamp. A face can have several tasks with different tags;
+// scheduling a task with a tag that is already scheduled moves it. Returns false if the timestamp is not
+// in the future or if too many tasks are scheduled. Tasks run at the exact second, also in low energy mode.
+bool movement_schedule_background_task_at(uint8_t watch_face_index, uint32_t timestamp, uint8_t tag);
+void movement_cancel_background_task_with_tag(uint8_t watch_face_index, uint8_t tag);
+// during an EVENT_BACKGROUND_TASK, returns the tag of the task that is due, or 0 for other background tasks.
+uint8_t movement_get_background_task_tag(void);
+
 void movement_request_sleep(void);
 void movement_request_wake(void);
 
@@ -347,6 +440,12 @@ int32_t movement_get_timezone_offset_for_date(watch_date_time_t date_time);
 int32_t movement_get_timezone_index(void);
 void movement_set_timezone_index(uint8_t value);
 
+// The calendars keep a broken-down date and time that is advanced incrementally as the RTC ticks, along with
+// derived fields such as the weekday, day of the year and ISO week. Faces should read these instead of
+// converting timestamps themselves. The returned pointers stay valid; the contents are current as of the call.
+const watch_calendar_t *movement_get_utc_calendar(void);
+const watch_calendar_t *movement_get_local_calendar(void);
+
 watch_date_time_t movement_get_utc_date_time(void);
 watch_date_time_t movement_get_local_date_time(void);
 watch_date_time_t movement_get_date_time_in_zone(uint8_t zone_index);
@@ -46,6 +46,10 @@
 #include "watch.h"
 #include "shell_cmd_list.h"
 
+#if !__EMSCRIPTEN__ && !defined(WATCH_NATIVE)
+#include "watch_usb_cdc.h"
+#endif
+
 extern shell_command_t g_shell_commands[];
 extern const size_t g_num_shell_commands;
 
@@ -54,11 +58,20 @@ extern const size_t g_num_shell_commands;
 #define SHELL_BUF_SZ  (256)
 #define SHELL_MAX_ARGS  (16)
 #define SHELL_PROMPT  "swsh> "
+// Most a resumed command may print in one pass of the app loop.
+#define SHELL_OUTPUT_PER_PASS  (256)
+// A resumed command only runs once this much output fits, so every pass makes progress.
+#define SHELL_OUTPUT_MIN  (64)
 
 static char s_buf[SHELL_BUF_SZ] = {0};
 static size_t s_buf_len = 0;
 // Pointer to the first invalid byte after the end of input.
 static char *const s_buf_end = s_buf + SHELL_BUF_SZ;
+// Commands added by faces at runtime, after the built-in ones.
+static const shell_command_t *s_registered_cmds[SHELL_MAX_REGISTERED_COMMANDS] = {0};
+static size_t s_num_registered_cmds = 0;
+// Command that returned SHELL_CMD_CONTINUE and has not finished yet. Input waits until it is done.
+static const shell_command_t *s_pending_cmd = NULL;
 
 static char *prv_skip_whitespace(char *c) {
     while (c >= s_buf && c < s_buf_end) {
@@ -99,6 +112,36 @@ static char *prv_skip_non_whitespace(char *c) {
     return NULL;
 }
 
+static const shell_command_t *prv_find_command(const char *name) {
+    for (size_t i = 0; i < g_num_shell_commands; i++) {
+        if (!strcasecmp(g_shell_commands[i].name, name)) {
+            return &g_shell_commands[i];
+        }
+    }
+    for (size_t i = 0; i < s_num_registered_cmds; i++) {
+        if (!strcasecmp(s_registered_cmds[i]->name, name)) {
+            return s_registered_cmds[i];
+        }
+    }
+    return NULL;
+}
+
+bool shell_register_command(const shell_command_t *command) {
+    const shell_command_t *existing = prv_find_command(command->name);
+    if (existing != NULL) {
+        return existing == command;
+    }
+    if (s_num_registered_cmds >= SHELL_MAX_REGISTERED_COMMANDS) {
+        return false;
+    }
+    s_registered_cmds[s_num_registered_cmds++] = command;
+    return true;
+}
+
+const shell_command_t *shell_get_registered_command(size_t index) {
+    return index < s_num_registered_cmds ? s_registered_cmds[index] : NULL;
+}
+
 static int prv_handle_command() {
     char *argv[SHELL_MAX_ARGS] = {0};
     int argc = 0;
@@ -132,33 +175,71 @@ static int prv_handle_command() {
         return -1;
     }
 
-    // Match against the command list
-    for (size_t i = 0; i < g_num_shell_commands; i++) {
-        if (!strcasecmp(g_shell_commands[i].name, argv[0])) {
-            // If argc isn't valid for this command, display its help instead.
-            if (((argc - 1) < g_shell_commands[i].min_args) ||
-                ((argc - 1) > g_shell_commands[i].max_args)) {
-                if (g_shell_commands[i].help != NULL) {
-                    printf(NEWLINE "%s" NEWLINE, g_shell_commands[i].help);
-                }
-                return -2;
-            }
-            // Call the command's callback
-            if (g_shell_commands[i].cb != NULL) {
-                printf(NEWLINE);
-                int ret = g_shell_commands[i].cb(argc, argv);
-                if (ret == -2) {
-                    printf(NEWLINE "%s" NEWLINE, g_shell_commands[i].help);
-                }
-                return ret;
-            }
+    const shell_command_t *cmd = prv_find_command(argv[0]);
+    if (cmd == NULL) {
+        return -1;
+    }
+
+    // If argc isn't valid for this command, display its help instead.
+    if (((argc - 1) < cmd->min_args) ||
+        ((argc - 1) > cmd->max_args)) {
+        if (cmd->help != NULL) {
+            printf(NEWLINE "%s" NEWLINE, cmd->help);
         }
+        return -2;
+    }
+    // Call the command's callback
+    if (cmd->cb == NULL) {
+        return -1;
+    }
+    printf(NEWLINE);
+    int ret = cmd->cb(argc, argv);
+    if (ret == SHELL_CMD_CONTINUE && cmd->resume != NULL) {
+        s_pending_cmd = cmd;
+        return ret;
+    }
+    if (ret == -2) {
+        printf(NEWLINE "%s" NEWLINE, cmd->help);
+    }
+    return ret;
+}
+
+static size_t prv_output_budget(void) {
+#if __EMSCRIPTEN__ || defined(WATCH_NATIVE)
+    return SHELL_OUTPUT_PER_PASS;
+#else
+    // only take what the USB transmit buffer can hold, so that printing never waits for the host.
+    size_t space = cdc_write_space();
+    return space < SHELL_OUTPUT_PER_PASS ? space : SHELL_OUTPUT_PER_PASS;
+#endif
+}
+
+static void prv_resume_pending(void) {
+    size_t budget = prv_output_budget();
+    if (budget < SHELL_OUTPUT_MIN) {
+        // the host has yet to read what we printed in earlier passes.
+        return;
     }
 
-    return -1;
+    int ret = s_pending_cmd->resume(budget);
+    if (ret == SHELL_CMD_CONTINUE) {
+        return;
+    }
+    if (ret == -2) {
+        printf(NEWLINE "%s" NEWLINE, s_pending_cmd->help);
+    }
+    s_pending_cmd = NULL;
+#if !__EMSCRIPTEN__
+    printf(NEWLINE SHELL_PROMPT);
+#endif
 }
 
 void shell_task(void) {
+    if (s_pending_cmd != NULL) {
+        prv_resume_pending();
+        return;
+    }
+
 #if __EMSCRIPTEN__
     // This is a terrible hack; ideally this should be handled deeper in the watch library.
     // Alas, emscripten treats read() as something that should pop up an input box, so I
@@ -218,7 +299,9 @@ void shell_task(void) {
             s_buf[s_buf_len+1] = '\0';
             (void) prv_handle_command();
             s_buf_len = 0;
-            printf(NEWLINE SHELL_PROMPT);
+            if (s_pending_cmd == NULL) {
+                printf(NEWLINE SHELL_PROMPT);
+            }
             break;
         } else {
             s_buf_len++;
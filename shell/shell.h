@@ -25,10 +25,34 @@
 #ifndef SHELL_H_
 #define SHELL_H_
 
+#include <stdbool.h>
+#include <stddef.h>
+#include "shell_cmd_list.h"
+
 /** @brief Called periodically from the app loop to handle shell commands.
  *         When a full command is complete, parses and executes its matching
- *         callback.
+ *         callback. A command that returned SHELL_CMD_CONTINUE is resumed
+ *         instead, one bounded step per call, until it is done.
  */
 void shell_task(void);
 
+/// Most commands that faces can add to the built-in ones.
+#define SHELL_MAX_REGISTERED_COMMANDS 8
+
+/** @brief Adds a command to the shell, e.g. to export a face's data.
+  * @param command The command; it must stay valid, so it should be static. A callback can stream
+  *                long output by returning SHELL_CMD_CONTINUE, see shell_command_t.
+  * @return true if the command is available; false if there is no room or another command has
+  *         the same name.
+  * @note Faces should call this from setup, which runs again after every wake from deep sleep;
+  *       registering the same command again does nothing.
+  */
+bool shell_register_command(const shell_command_t *command);
+
+/** @brief Gets a command that was added with shell_register_command.
+  * @param index The index of the command, starting at 0.
+  * @return the command, or NULL if there are no more.
+  */
+const shell_command_t *shell_get_registered_command(size_t index);
+
 #endif
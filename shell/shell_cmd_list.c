@@ -29,12 +29,24 @@
 #include <stdlib.h>
 
 #include "filesystem.h"
+#include "shell.h"
+#include "movement.h"
 #include "watch.h"
 #include "delay.h"
+#include "watch_trace.h"
+#if !__EMSCRIPTEN__ && !defined(WATCH_NATIVE)
+#include "watch_usb_cdc.h"
+#endif
 
 static int help_cmd(int argc, char *argv[]);
 static int flash_cmd(int argc, char *argv[]);
 static int stress_cmd(int argc, char *argv[]);
+static int perf_cmd(int argc, char *argv[]);
+static unsigned long perf_ticks_to_ms(uint32_t ticks);
+#ifdef WATCH_TRACE
+static int trace_cmd(int argc, char *argv[]);
+static int trace_resume(size_t budget);
+#endif
 
 shell_command_t g_shell_commands[] = {
     {
@@ -71,6 +83,7 @@ shell_command_t g_shell_commands[] = {
         .min_args = 1,
         .max_args = 1,
         .cb = filesystem_cmd_cat,
+        .resume = filesystem_cmd_cat_resume,
     },
     {
         .name = "b64encode",
@@ -78,6 +91,7 @@ shell_command_t g_shell_commands[] = {
         .min_args = 1,
         .max_args = 1,
         .cb = filesystem_cmd_b64encode,
+        .resume = filesystem_cmd_b64encode_resume,
     },
     {
         .name = "df",
@@ -107,13 +121,44 @@ shell_command_t g_shell_commands[] = {
         .max_args = 3,
         .cb = filesystem_cmd_echo,
     },
+    {
+        .name = "get",
+        .help = "send a file in binary frames; usage: get FILE [OFFSET]",
+        .min_args = 1,
+        .max_args = 2,
+        .cb = filesystem_cmd_get,
+    },
+    {
+        .name = "put",
+        .help = "receive a file in binary frames; usage: put FILE SIZE [resume]",
+        .min_args = 2,
+        .max_args = 3,
+        .cb = filesystem_cmd_put,
+    },
     {
         .name = "stress",
-        .help = "test CDC write; usage: stress [LEN] [DELAY_MS]",
+        .help = "measure CDC write throughput; usage: stress [LEN] [DELAY_MS]",
         .min_args = 0,
         .max_args = 2,
         .cb = stress_cmd,
     },
+    {
+        .name = "perf",
+        .help = "print and reset per-face CPU time",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = perf_cmd,
+    },
+#ifdef WATCH_TRACE
+    {
+        .name = "trace",
+        .help = "stream binary trace records; usage: trace [SECONDS]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = trace_cmd,
+        .resume = trace_resume,
+    },
+#endif
 };
 
 const size_t g_num_shell_commands = sizeof(g_shell_commands) / sizeof(shell_command_t);
@@ -129,6 +174,10 @@ static int help_cmd(int argc, char *argv[]) {
                 (g_shell_commands[i].help) ? g_shell_commands[i].help : ""
         );
     }
+    const shell_command_t *command;
+    for (size_t i = 0; (command = shell_get_registered_command(i)) != NULL; i++) {
+        printf(" %s\t%s\r\n", command->name, (command->help) ? command->help : "");
+    }
 
     return 0;
 }
@@ -142,6 +191,7 @@ static int flash_cmd(int argc, char *argv[]) {
 }
 
 #define STRESS_CMD_MAX_LEN  (512)
+
 static int stress_cmd(int argc, char *argv[]) {
     char test_str[STRESS_CMD_MAX_LEN+1] = {0};
 
@@ -161,13 +211,123 @@ static int stress_cmd(int argc, char *argv[]) {
         delay = atoi(argv[2]);
     }
 
+#if !__EMSCRIPTEN__ && !defined(WATCH_NATIVE)
+    cdc_stats_t before = cdc_get_stats();
+#endif
+    rtc_counter_t start = watch_rtc_get_counter();
+    unsigned long bytes = 0;
+
     for (int i = 0; i < max_len; i++) {
         snprintf(&test_str[i], 2, "%u", (i+1)%10);
-        printf("%u:\t%s\r\n", (i+1), test_str);
+        int count = printf("%u:\t%s\r\n", (i+1), test_str);
+        if (count > 0) {
+            bytes += count;
+        }
         if (delay > 0) {
             delay_ms(delay);
         }
     }
 
+    // count until the last byte has left the buffer, not just until it was queued.
+    fflush(stdout);
+    unsigned long dropped = 0;
+    unsigned long waits = 0;
+#if !__EMSCRIPTEN__ && !defined(WATCH_NATIVE)
+    cdc_flush();
+    cdc_stats_t after = cdc_get_stats();
+    // the CDC counters see exactly what stdio passed on, so they replace the printf count.
+    bytes = after.written - before.written;
+    dropped = after.dropped - before.dropped;
+    waits = after.waits - before.waits;
+#endif
+    unsigned long ms = perf_ticks_to_ms(watch_rtc_get_counter() - start);
+
+    // the throughput only counts the bytes that reached the host.
+    printf("%lu bytes in %lu ms", bytes, ms);
+    if (ms > 0) {
+        printf(", %lu bytes/s", (unsigned long)(((uint64_t)(bytes - dropped) * 1000) / ms));
+    }
+    printf(", %lu dropped, %lu waits for the host\r\n", dropped, waits);
+
+    return dropped ? 1 : 0;
+}
+
+static unsigned long perf_ticks_to_ms(uint32_t ticks) {
+    return (unsigned long)(((uint64_t)ticks * 1000) / watch_rtc_get_frequency());
+}
+
+static int perf_cmd(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    movement_perf_stats_t stats = movement_get_perf_stats();
+    // awake time in hundredths of a percent, to avoid floating point formatting.
+    unsigned long duty = stats.elapsed_ticks ? (unsigned long)(((uint64_t)stats.awake_ticks * 10000) / stats.elapsed_ticks) : 0;
+
+    printf("%lu ms elapsed, %lu ms awake (%lu.%02lu%%), %lu face switches\r\n",
+           perf_ticks_to_ms(stats.elapsed_ticks), perf_ticks_to_ms(stats.awake_ticks),
+           duty / 100, duty % 100, (unsigned long)stats.face_switches);
+    printf("face\tawake ms\tbg ms\twakes\tevents\r\n");
+    movement_face_perf_t perf;
+    for (uint8_t i = 0; movement_get_face_perf(i, &perf); i++) {
+        if (perf.wakes == 0 && perf.events == 0) continue;
+        printf("%u\t%lu\t\t%lu\t%lu\t%lu\r\n", i,
+               perf_ticks_to_ms(perf.awake_ticks), perf_ticks_to_ms(perf.background_ticks),
+               (unsigned long)perf.wakes, (unsigned long)perf.events);
+    }
+
+    movement_reset_perf();
+
+    return 0;
+}
+
+#ifdef WATCH_TRACE
+
+#define TRACE_CMD_DEFAULT_SECONDS  (10)
+#define TRACE_CMD_BATCH  (16)
+
+static rtc_counter_t trace_cmd_deadline;
+
+static int trace_cmd(int argc, char *argv[]) {
+    int seconds = TRACE_CMD_DEFAULT_SECONDS;
+
+    if (argc >= 2 && (seconds = atoi(argv[1])) <= 0) {
+        return -2;
+    }
+
+    uint16_t ticks_per_second = watch_rtc_get_frequency();
+    trace_cmd_deadline = watch_rtc_get_counter() + (rtc_counter_t)seconds * ticks_per_second;
+
+    // the stream starts with "WTRC", the format version, a reserved byte and the RTC ticks per second.
+    uint8_t header[8] = { 'W', 'T', 'R', 'C', 1, 0, ticks_per_second & 0xFF, ticks_per_second >> 8 };
+    fwrite(header, 1, sizeof(header), stdout);
+
+    return SHELL_CMD_CONTINUE;
+}
+
+static int trace_resume(size_t budget) {
+    watch_trace_record_t records[TRACE_CMD_BATCH];
+    uint16_t max = budget / sizeof(watch_trace_record_t);
+    if (max > TRACE_CMD_BATCH) {
+        max = TRACE_CMD_BATCH;
+    }
+
+    // check the deadline first, so that the records logged until then are all sent.
+    bool done = (int32_t)(watch_rtc_get_counter() - trace_cmd_deadline) >= 0;
+    uint16_t count = watch_trace_take(records, max);
+    fwrite(records, sizeof(watch_trace_record_t), count, stdout);
+    if (!done || count == max) {
+        return SHELL_CMD_CONTINUE;
+    }
+
+    watch_trace_record_t end = {
+        .counter = watch_rtc_get_counter(),
+        .type = WATCH_TRACE_END,
+        .face = WATCH_TRACE_NO_FACE,
+    };
+    fwrite(&end, sizeof(end), 1, stdout);
+
     return 0;
 }
+
+#endif
@@ -25,14 +25,20 @@
 #ifndef SHELL_CMD_LIST_H_
 #define SHELL_CMD_LIST_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+/// Returned by a callback that has more output to come. The shell then calls the command's resume
+/// function once per pass of the app loop, so that faces keep running while a long dump is printed.
+#define SHELL_CMD_CONTINUE (-3)
+
 typedef struct {
     const char *name; // Name used to invoke the command
     const char *help; // Help string
     int8_t min_args;  // Minimum number of arguments (_excluding_ the command name)
     int8_t max_args;  // Maximum number of arguments (_excluding_ the command name)
     int (*cb)(int argc, char *argv[]); // Callback for the command
+    int (*resume)(size_t budget); // Continues a command that returned SHELL_CMD_CONTINUE; prints at most budget bytes
 } shell_command_t;
 
 #endif
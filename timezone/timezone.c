@@ -0,0 +1,212 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+
+#include "timezone.h"
+#include "watch_utility.h"
+#include "utz.h"
+#include "zones.h"
+
+#define TIMEZONE_PROBE_STEP (7 * 86400)
+#define TIMEZONE_SEARCH_HORIZON (366 * 86400)
+// Zones change their offset at most twice a year, so two transitions cover a year of lookups.
+#define TIMEZONE_MAX_TRANSITIONS 2
+
+// The transitions of a zone within [valid_from, valid_until) of UTC time. offsets[i] is the offset, in
+// OFFSET_INCREMENT units, before transitions[i], and offsets[num_transitions] the one after the last.
+typedef struct {
+    uint32_t valid_from;
+    uint32_t valid_until;
+    uint32_t transitions[TIMEZONE_MAX_TRANSITIONS];
+    int8_t offsets[TIMEZONE_MAX_TRANSITIONS + 1];
+    uint8_t num_transitions;
+} timezone_table_t;
+
+// valid_until is 0 for zones that have not been looked up yet, so the first lookup misses.
+static timezone_table_t _timezone_tables[NUM_ZONE_NAMES];
+
+static udatetime_t _timezone_convert_date_time_to_udate(watch_date_time_t date_time) {
+    return (udatetime_t) {
+        .date.dayofmonth = date_time.unit.day,
+        .date.dayofweek = dayofweek(UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR), date_time.unit.month, date_time.unit.day),
+        .date.month = date_time.unit.month,
+        .date.year = UYEAR_FROM_YEAR(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR),
+        .time.hour = date_time.unit.hour,
+        .time.minute = date_time.unit.minute,
+        .time.second = date_time.unit.second
+    };
+}
+
+// Evaluates the rules of the zone, in OFFSET_INCREMENT units.
+static int8_t _timezone_compute_offset(uint8_t zone_index, uint32_t timestamp) {
+    uzone_t zone;
+    unpack_zone(&zone_defns[zone_index], "", &zone);
+
+    if (!zone.rules_len) return zone_defns[zone_index].offset_inc_minutes;
+
+    // utz expects the standard local time of the zone.
+    watch_date_time_t date_time = watch_utility_date_time_from_unix_time(timestamp, zone.offset.hours * 3600 + zone.offset.minutes * 60);
+    udatetime_t udate_time = _timezone_convert_date_time_to_udate(date_time);
+    uoffset_t offset;
+    get_current_offset(&zone, &udate_time, &offset);
+
+    return (offset.hours * 60 + offset.minutes) / OFFSET_INCREMENT;
+}
+
+// Finds the first minute after timestamp at which the offset is no longer the given one.
+static uint32_t _timezone_find_transition(uint8_t zone_index, uint32_t timestamp, int8_t offset) {
+    // transitions happen on the minute, so we only need to look at whole minutes.
+    uint32_t lo = timestamp - timestamp % 60;
+    uint32_t limit = lo + TIMEZONE_SEARCH_HORIZON;
+
+    // an overflow of the search horizon means we are at the end of the range anyway.
+    if (limit < lo) return UINT32_MAX;
+
+    while (lo < limit) {
+        uint32_t hi = lo + TIMEZONE_PROBE_STEP;
+        if (_timezone_compute_offset(zone_index, hi) != offset) {
+            // the offset is still valid at lo and has changed by hi, so bisect down to the minute.
+            while (hi - lo > 60) {
+                uint32_t mid = lo + ((hi - lo) / 120) * 60;
+                if (_timezone_compute_offset(zone_index, mid) == offset) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            return hi;
+        }
+        lo = hi;
+    }
+
+    return UINT32_MAX;
+}
+
+// Fills the table of a zone with its transitions in the UTC year of timestamp, so that lookups throughout the
+// year hit, also when they alternate across a transition.
+static void _timezone_build_table(uint8_t zone_index, timezone_table_t *table, uint32_t timestamp) {
+    table->num_transitions = 0;
+
+    if (!timezone_observes_dst(zone_index)) {
+        table->valid_from = 0;
+        table->valid_until = UINT32_MAX;
+        table->offsets[0] = _timezone_compute_offset(zone_index, timestamp);
+        return;
+    }
+
+    watch_date_time_t date_time = watch_utility_date_time_from_unix_time(timestamp, 0);
+    uint16_t year = date_time.unit.year + WATCH_RTC_REFERENCE_YEAR;
+    uint32_t start = watch_utility_convert_to_unix_time(year, 1, 1, 0, 0, 0, 0);
+    uint32_t end = watch_utility_convert_to_unix_time(year + 1, 1, 1, 0, 0, 0, 0);
+    if (timestamp < start || timestamp >= end) {
+        // outside the range of the RTC, so fall back to the minute-aligned year around the timestamp.
+        start = timestamp - timestamp % 60;
+        start = start > TIMEZONE_SEARCH_HORIZON / 2 ? start - TIMEZONE_SEARCH_HORIZON / 2 : 0;
+        end = start + TIMEZONE_SEARCH_HORIZON;
+        if (end < start) end = UINT32_MAX;
+    }
+
+    table->valid_from = start;
+    int8_t offset = _timezone_compute_offset(zone_index, start);
+    table->offsets[0] = offset;
+
+    while (start < end) {
+        uint32_t transition = _timezone_find_transition(zone_index, start, offset);
+        if (transition >= end) break;
+        if (table->num_transitions == TIMEZONE_MAX_TRANSITIONS) {
+            // no room for this one, so the table ends where it begins.
+            end = transition;
+            break;
+        }
+        offset = _timezone_compute_offset(zone_index, transition);
+        table->transitions[table->num_transitions++] = transition;
+        table->offsets[table->num_transitions] = offset;
+        start = transition;
+    }
+
+    table->valid_until = end;
+}
+
+static timezone_table_t *_timezone_get_table(uint8_t zone_index, uint32_t timestamp) {
+    timezone_table_t *table = &_timezone_tables[zone_index];
+
+    if (timestamp < table->valid_from || timestamp >= table->valid_until) {
+        _timezone_build_table(zone_index, table, timestamp);
+    }
+
+    return table;
+}
+
+// Returns the index of the first transition after timestamp in a table that covers it.
+static uint8_t _timezone_table_index(const timezone_table_t *table, uint32_t timestamp) {
+    uint8_t i = 0;
+    while (i < table->num_transitions && timestamp >= table->transitions[i]) i++;
+    return i;
+}
+
+int32_t timezone_get_offset(uint8_t zone_index, uint32_t timestamp) {
+    timezone_table_t *table = _timezone_get_table(zone_index, timestamp);
+
+    return (int32_t)table->offsets[_timezone_table_index(table, timestamp)] * OFFSET_INCREMENT * 60;
+}
+
+int32_t timezone_compute_offset(uint8_t zone_index, uint32_t timestamp) {
+    return (int32_t)_timezone_compute_offset(zone_index, timestamp) * OFFSET_INCREMENT * 60;
+}
+
+int32_t timezone_get_standard_offset(uint8_t zone_index) {
+    return (int32_t)zone_defns[zone_index].offset_inc_minutes * OFFSET_INCREMENT * 60;
+}
+
+bool timezone_observes_dst(uint8_t zone_index) {
+    uzone_t zone;
+    unpack_zone(&zone_defns[zone_index], "", &zone);
+
+    return zone.rules_len != 0;
+}
+
+uint32_t timezone_get_next_transition(uint8_t zone_index, uint32_t timestamp) {
+    if (!timezone_observes_dst(zone_index)) return UINT32_MAX;
+
+    timezone_table_t *table = _timezone_get_table(zone_index, timestamp);
+    uint8_t i = _timezone_table_index(table, timestamp);
+    if (i < table->num_transitions) return table->transitions[i];
+
+    // the table ends before the horizon. If it was full, it ends at a transition; otherwise search on from its
+    // end, without caching.
+    if (table->valid_until == UINT32_MAX) return UINT32_MAX;
+    uint32_t transition = table->valid_until;
+    if (_timezone_compute_offset(zone_index, transition) == table->offsets[i]) {
+        transition = _timezone_find_transition(zone_index, transition, table->offsets[i]);
+    }
+    return transition - timestamp <= TIMEZONE_SEARCH_HORIZON ? transition : UINT32_MAX;
+}
+
+void timezone_invalidate_cache(void) {
+    for (uint8_t i = 0; i < NUM_ZONE_NAMES; i++) {
+        _timezone_tables[i].valid_from = 0;
+        _timezone_tables[i].valid_until = 0;
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Time zone offsets with cached DST transitions.
+  * @details Evaluating the DST rules of a zone with utz is expensive: the zone has to be unpacked, the date
+  *          broken down and every rule checked. This module keeps for each zone a small table of its DST
+  *          transitions in the current UTC year, so that both sides of a transition are covered. A lookup
+  *          within the table is a comparison against at most two transitions and an array access, whether the
+  *          lookups go forward, backward or alternate across a transition. The table is built again only when a
+  *          lookup falls into another year, i.e. when the year has passed, the clock was set or a face asked
+  *          about a date in another year.
+  *
+  *          utz does not expose the transition dates of its rules, so transitions are located by probing the
+  *          rules once a week and then bisecting the week down to the minute. Building a table therefore costs
+  *          a few hundred rule evaluations. Zones without DST rules never expire.
+  */
+
+/** @brief Returns the UTC offset of a zone at a given time.
+  * @param zone_index The index of the zone in zone_defns.
+  * @param timestamp The UTC unix timestamp.
+  * @return The offset in seconds, including DST if it applies.
+  */
+int32_t timezone_get_offset(uint8_t zone_index, uint32_t timestamp);
+
+/** @brief Returns the UTC offset of a zone at a given time by evaluating its DST rules, bypassing the cache.
+  * @param zone_index The index of the zone in zone_defns.
+  * @param timestamp The UTC unix timestamp.
+  * @return The offset in seconds, including DST if it applies.
+  */
+int32_t timezone_compute_offset(uint8_t zone_index, uint32_t timestamp);
+
+/** @brief Returns the standard time offset of a zone, without DST.
+  * @param zone_index The index of the zone in zone_defns.
+  * @return The offset in seconds.
+  */
+int32_t timezone_get_standard_offset(uint8_t zone_index);
+
+/** @brief Returns true if the zone has DST rules.
+  * @param zone_index The index of the zone in zone_defns.
+  */
+bool timezone_observes_dst(uint8_t zone_index);
+
+/** @brief Returns the UTC timestamp of the next DST transition of a zone after a given time.
+  * @param zone_index The index of the zone in zone_defns.
+  * @param timestamp The UTC unix timestamp.
+  * @return The time of the transition, or UINT32_MAX if there is none within a year.
+  */
+uint32_t timezone_get_next_transition(uint8_t zone_index, uint32_t timestamp);
+
+/** @brief Drops all cached offsets. Not needed for correctness, but frees the work of the next lookups from
+  *        bisecting intervals that are far away from the current time.
+  */
+void timezone_invalidate_cache(void);
@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Host benchmark for the DST offset lookups in timezone/timezone.c.
+ *
+ * For every zone, it looks up the UTC offset at hourly times from 2020 to 2083, the RTC's range, in four
+ * orders: walking forward, walking backward, at random within a year and at random over the whole range.
+ * Each time the offset is computed twice: once by evaluating the zone's DST rules with utz, which is what
+ * Movement used to do for every lookup, and once through the cached transition tables. Both results must
+ * agree. The times of both paths are reported per order; random lookups within a year stay in the table,
+ * while random lookups over decades mostly miss it and show the cost of building a table.
+ *
+ * Build and run with `make run` in this directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "timezone.h"
+#include "watch.h"
+#include "utz.h"
+#include "zones.h"
+
+#define RANGE_START 1577836800u     // 2020-01-01 00:00:00 UTC
+#define RANGE_END 3597523200u       // 2084-01-01 00:00:00 UTC
+#define STEP 3600u
+#define LOOKUPS ((RANGE_END - RANGE_START) / STEP)
+#define RANDOM_LOOKUPS 50000u
+#define YEAR_START 1767225600u      // 2026-01-01 00:00:00 UTC
+#define YEAR_HOURS (365u * 24u)
+
+// watch_utility.c needs this for zone names, which the benchmark does not use.
+watch_lcd_type_t watch_get_lcd_type(void) {
+    return WATCH_LCD_TYPE_CLASSIC;
+}
+
+static double _now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+typedef enum {
+    ORDER_FORWARD = 0,
+    ORDER_BACKWARD,
+    ORDER_YEAR,
+    ORDER_RANDOM,
+} lookup_order_t;
+
+static const char *_order_names[] = { "forward", "backward", "year", "random" };
+
+static uint32_t _timestamps[LOOKUPS];
+
+// fills _timestamps in the given order and returns how many there are.
+static uint32_t _generate(lookup_order_t order) {
+    uint32_t state = 2463534242u;
+    uint32_t count = order >= ORDER_YEAR ? RANDOM_LOOKUPS : LOOKUPS;
+
+    for (uint32_t i = 0; i < count; i++) {
+        switch (order) {
+            case ORDER_FORWARD:
+                _timestamps[i] = RANGE_START + i * STEP;
+                break;
+            case ORDER_BACKWARD:
+                _timestamps[i] = RANGE_START + (count - 1 - i) * STEP;
+                break;
+            case ORDER_YEAR:
+            case ORDER_RANDOM:
+                // xorshift32, so that every run looks up the same times.
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                if (order == ORDER_YEAR) _timestamps[i] = YEAR_START + (state % YEAR_HOURS) * STEP;
+                else _timestamps[i] = RANGE_START + (state % LOOKUPS) * STEP;
+                break;
+        }
+    }
+
+    return count;
+}
+
+static int _run(lookup_order_t order) {
+    uint32_t count = _generate(order);
+    uint64_t lookups = 0;
+    int64_t checksum_rules = 0;
+    int64_t checksum_table = 0;
+    double rules_time = 0;
+    double table_time = 0;
+
+    for (uint8_t zone = 0; zone < NUM_ZONE_NAMES; zone++) {
+        double start = _now();
+        for (uint32_t i = 0; i < count; i++) {
+            checksum_rules += timezone_compute_offset(zone, _timestamps[i]);
+        }
+        rules_time += _now() - start;
+
+        timezone_invalidate_cache();
+        start = _now();
+        for (uint32_t i = 0; i < count; i++) {
+            checksum_table += timezone_get_offset(zone, _timestamps[i]);
+        }
+        table_time += _now() - start;
+
+        // verify separately, so that the comparison does not end up in the timings.
+        for (uint32_t i = 0; i < count; i++) {
+            int32_t expected = timezone_compute_offset(zone, _timestamps[i]);
+            int32_t actual = timezone_get_offset(zone, _timestamps[i]);
+            if (expected != actual) {
+                fprintf(stderr, "zone %d at %u (%s): rules give %d, table gives %d\n", zone, _timestamps[i],
+                        _order_names[order], expected, actual);
+                return 1;
+            }
+            lookups++;
+        }
+    }
+
+    if (checksum_rules != checksum_table) {
+        fprintf(stderr, "checksums differ (%s)\n", _order_names[order]);
+        return 1;
+    }
+
+    printf("%-8s  %8llu lookups  rules %7.1f ns  table %7.1f ns per lookup (%.2fx)\n", _order_names[order],
+           (unsigned long long)lookups, rules_time * 1e9 / lookups, table_time * 1e9 / lookups,
+           rules_time / table_time);
+
+    return 0;
+}
+
+int main(void) {
+    uint64_t transitions = 0;
+
+    for (uint8_t zone = 0; zone < NUM_ZONE_NAMES; zone++) {
+        int32_t previous = timezone_compute_offset(zone, RANGE_START);
+        for (uint32_t t = RANGE_START; t < RANGE_END; t += STEP) {
+            int32_t offset = timezone_compute_offset(zone, t);
+            if (offset != previous) transitions++;
+            previous = offset;
+        }
+    }
+    printf("%d zones, %llu transitions from 2020 to 2083\n", NUM_ZONE_NAMES, (unsigned long long)transitions);
+
+    for (lookup_order_t order = ORDER_FORWARD; order <= ORDER_RANDOM; order++) {
+        if (_run(order)) return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,223 @@
+#!/usr/bin/env python3
+"""
+Copies files to and from a watch running Movement, through the get and put commands of its serial shell.
+
+    movement_xfer.py --port /dev/ttyACM0 get templog.0 [LOCAL] [--resume]
+    movement_xfer.py --port /dev/ttyACM0 put LOCAL [REMOTE] [--resume]
+
+Instead of a serial port, --native runs the native simulator and talks to its shell, for example:
+
+    movement_xfer.py --native "build-native/movement -c -q -f storage.img" put secrets.txt totp_uris.txt
+
+Both directions move the file in frames of up to 256 bytes, each with a CRC-16, so that a damaged frame
+only costs its own chunk: get restarts the stream at the first bad frame, put resends the rejected one.
+With --resume, get appends to a partial local file and put keeps what the watch already holds. The frame
+format is described in filesystem/filesystem_transfer.c. --port needs pyserial.
+"""
+
+import argparse
+import os
+import select
+import struct
+import subprocess
+import sys
+import time
+
+SYNC = b"\xa5\x5a"
+CHUNK_SIZE = 256
+TIMEOUT = 3.0
+RETRIES = 5
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as in lib/crc16."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+    return crc
+
+
+def frame(kind, offset, payload=b""):
+    body = kind.encode() + struct.pack("<IH", offset, len(payload)) + payload
+    return SYNC + body + struct.pack("<H", crc16(body))
+
+
+class TransferError(Exception):
+    pass
+
+
+class SerialLink:
+    def __init__(self, port):
+        import serial  # pyserial
+        self.port = serial.Serial(port, 115200, timeout=0)
+
+    def write(self, data):
+        self.port.write(data)
+
+    def read(self, timeout):
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            data = self.port.read(4096)
+            if data:
+                return data
+            time.sleep(0.001)
+        return b""
+
+
+class NativeLink:
+    def __init__(self, command):
+        self.process = subprocess.Popen(command, shell=True, stdin=subprocess.PIPE, stdout=subprocess.PIPE, bufsize=0)
+
+    def write(self, data):
+        self.process.stdin.write(data)
+
+    def read(self, timeout):
+        ready, _, _ = select.select([self.process.stdout], [], [], timeout)
+        return os.read(self.process.stdout.fileno(), 4096) if ready else b""
+
+    def close(self):
+        self.process.terminate()
+        self.process.wait()
+
+
+class Watch:
+    def __init__(self, link):
+        self.link = link
+        self.buffer = b""
+
+    def command(self, line):
+        self.buffer = b""
+        self.link.write(line.encode() + b"\r")
+
+    def _fill(self, count, deadline):
+        while len(self.buffer) < count:
+            remaining = deadline - time.monotonic()
+            data = self.link.read(remaining) if remaining > 0 else b""
+            if not data:
+                return False
+            self.buffer += data
+        return True
+
+    def receive(self, timeout=TIMEOUT):
+        """Returns the next frame as (kind, offset, payload), None for a damaged one, or raises on timeout."""
+        deadline = time.monotonic() + timeout
+        while True:
+            # skip the shell's echo and prompt.
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                self.buffer = self.buffer[-1:]
+                if not self._fill(len(self.buffer) + 1, deadline):
+                    raise TransferError("timeout")
+                continue
+            self.buffer = self.buffer[start:]
+            if not self._fill(9, deadline):
+                raise TransferError("timeout")
+            kind, offset, length = struct.unpack_from("<cIH", self.buffer, 2)
+            if length > CHUNK_SIZE:
+                self.buffer = self.buffer[1:]
+                continue
+            if not self._fill(11 + length, deadline):
+                raise TransferError("timeout")
+            body, (crc,) = self.buffer[2:9 + length], struct.unpack_from("<H", self.buffer, 9 + length)
+            self.buffer = self.buffer[11 + length:]
+            if crc != crc16(body):
+                return None
+            return kind.decode(), offset, body[7:]
+
+
+def get(watch, remote, local, resume):
+    offset = os.path.getsize(local) if resume and os.path.exists(local) else 0
+    with open(local, "ab" if resume else "wb") as f:
+        for _ in range(RETRIES):
+            watch.command(f"get {remote} {offset}")
+            while True:
+                try:
+                    received = watch.receive()
+                except TransferError:
+                    break
+                if received is None:
+                    continue
+                kind, frame_offset, payload = received
+                if kind == "X":
+                    raise TransferError(payload.decode(errors="replace"))
+                if kind == "D" and frame_offset == offset:
+                    f.write(payload)
+                    offset += len(payload)
+                elif kind == "E":
+                    if offset == frame_offset:
+                        return offset
+                    break
+            # a frame was lost or damaged; ask again from the first byte that is missing.
+            print(f"restarting at {offset}", file=sys.stderr)
+    raise TransferError(f"gave up after {RETRIES} attempts")
+
+
+def put(watch, local, remote, resume):
+    with open(local, "rb") as f:
+        data = f.read()
+    watch.command(f"put {remote} {len(data)}" + (" resume" if resume else ""))
+
+    offset = None
+    resends = 0
+    while True:
+        received = watch.receive()
+        if received is None:
+            # a damaged reply; the watch still expects the offset it asked for before.
+            kind, frame_offset = "N", offset
+        else:
+            kind, frame_offset, payload = received
+        if kind == "X":
+            raise TransferError(payload.decode(errors="replace"))
+        if kind == "E":
+            return frame_offset
+        if kind == "N":
+            resends += 1
+            if resends > RETRIES * 10:
+                raise TransferError("too many rejected frames")
+        if frame_offset is None:
+            raise TransferError("unexpected reply")
+        offset = frame_offset
+        watch.link.write(frame("D", offset, data[offset:offset + CHUNK_SIZE]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter, epilog=__doc__)
+    link = parser.add_mutually_exclusive_group(required=True)
+    link.add_argument("--port", help="serial port of the watch")
+    link.add_argument("--native", metavar="COMMAND", help="run the native simulator with this command line")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    p = commands.add_parser("get", help="copy a file from the watch")
+    p.add_argument("remote")
+    p.add_argument("local", nargs="?")
+    p.add_argument("--resume", action="store_true", help="append to a partial local file")
+
+    p = commands.add_parser("put", help="copy a file to the watch")
+    p.add_argument("local")
+    p.add_argument("remote", nargs="?")
+    p.add_argument("--resume", action="store_true", help="keep what the watch already holds")
+
+    args = parser.parse_args()
+    link = SerialLink(args.port) if args.port else NativeLink(args.native)
+    watch = Watch(link)
+    start = time.monotonic()
+    try:
+        if args.command == "get":
+            size = get(watch, args.remote, args.local or os.path.basename(args.remote), args.resume)
+        else:
+            size = put(watch, args.local, args.remote or os.path.basename(args.local), args.resume)
+    except (OSError, TransferError) as e:
+        print(f"{args.command}: {e}", file=sys.stderr)
+        return 1
+    finally:
+        if isinstance(link, NativeLink):
+            link.close()
+    elapsed = time.monotonic() - start
+    print(f"{size} bytes in {elapsed:.3f} s ({size / elapsed:.0f} bytes/s)", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
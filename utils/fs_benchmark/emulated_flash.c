@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "emulated_flash.h"
+#include "watch.h"
+
+#define FLASH_SIZE (NVMCTRL_ROW_SIZE * NVMCTRL_RWWEE_PAGES / 4)
+#define FLASH_ROWS (FLASH_SIZE / NVMCTRL_ROW_SIZE)
+
+static FILE *flash;
+static emulated_flash_stats_t stats;
+static uint32_t row_erases[FLASH_ROWS];
+
+bool emulated_flash_open(const char *path) {
+    if (flash) fclose(flash);
+    flash = path ? fopen(path, "w+b") : tmpfile();
+    if (flash == NULL) return false;
+
+    uint8_t erased[FLASH_SIZE];
+    memset(erased, 0xff, sizeof(erased));
+    bool success = fwrite(erased, 1, sizeof(erased), flash) == sizeof(erased);
+    emulated_flash_reset_stats();
+    return success;
+}
+
+void emulated_flash_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+    memset(row_erases, 0, sizeof(row_erases));
+}
+
+emulated_flash_stats_t emulated_flash_get_stats(void) {
+    return stats;
+}
+
+double emulated_flash_busy_ms(const emulated_flash_stats_t *s) {
+    return s->programs * EMULATED_FLASH_PROGRAM_MS + s->erases * EMULATED_FLASH_ERASE_MS +
+           s->bytes_read * EMULATED_FLASH_READ_US_PER_BYTE / 1000.0;
+}
+
+bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t size) {
+    if (row * NVMCTRL_ROW_SIZE + offset + size > FLASH_SIZE) return false;
+    fseek(flash, row * NVMCTRL_ROW_SIZE + offset, SEEK_SET);
+    if (fread(buffer, 1, size, flash) != size) return false;
+
+    stats.reads++;
+    stats.bytes_read += size;
+    return true;
+}
+
+bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    uint8_t page[NVMCTRL_PAGE_SIZE];
+    if (row * NVMCTRL_ROW_SIZE + offset + size > FLASH_SIZE || size > NVMCTRL_PAGE_SIZE) return false;
+
+    // like NOR flash, programming can only clear bits.
+    fseek(flash, row * NVMCTRL_ROW_SIZE + offset, SEEK_SET);
+    if (fread(page, 1, size, flash) != size) return false;
+    for (uint32_t i = 0; i < size; i++) page[i] &= buffer[i];
+    fseek(flash, row * NVMCTRL_ROW_SIZE + offset, SEEK_SET);
+    if (fwrite(page, 1, size, flash) != size) return false;
+
+    stats.programs++;
+    stats.bytes_programmed += size;
+    return true;
+}
+
+bool watch_storage_erase(uint32_t row) {
+    uint8_t erased[NVMCTRL_ROW_SIZE];
+    if (row >= FLASH_ROWS) return false;
+
+    memset(erased, 0xff, sizeof(erased));
+    fseek(flash, row * NVMCTRL_ROW_SIZE, SEEK_SET);
+    if (fwrite(erased, 1, sizeof(erased), flash) != sizeof(erased)) return false;
+
+    stats.erases++;
+    if (++row_erases[row] > stats.max_row_erases) stats.max_row_erases = row_erases[row];
+    return true;
+}
+
+bool watch_storage_sync(void) {
+    fflush(flash);
+    return true;
+}
+
+// filesystem.c paces its base64 output, which the benchmarks do not use.
+void delay_ms(const uint16_t ms) {
+    (void) ms;
+}
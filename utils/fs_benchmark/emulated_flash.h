@@ -0,0 +1,65 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * A file-backed stand-in for the RWWEE area behind watch_storage_read, watch_storage_write and
+ * watch_storage_erase, for the host benchmarks in this directory. It behaves like the NVM controller:
+ * programming can only clear bits and writes at most one page, and erasing sets a whole row to 0xFF.
+ * Every access is counted, and the counts are turned into a time with the NVM timings of the SAM L22.
+ */
+
+// SAM L22 datasheet, NVM characteristics: maximum page programming and row erase times.
+#define EMULATED_FLASH_PROGRAM_MS 2.5
+#define EMULATED_FLASH_ERASE_MS 6.0
+// reading the RWWEE area at 4 MHz with one wait state, a 32 bit word per two cycles.
+#define EMULATED_FLASH_READ_US_PER_BYTE 0.125
+
+typedef struct {
+    uint64_t reads;
+    uint64_t bytes_read;
+    uint64_t programs;          // page programs, one per watch_storage_write
+    uint64_t bytes_programmed;
+    uint64_t erases;
+    uint32_t max_row_erases;    // erases of the most erased row since the last reset
+} emulated_flash_stats_t;
+
+/// @brief Backs the emulated flash with a file, which is erased first.
+/// @param path The file to use, or NULL for a temporary file.
+/// @return true if the file could be opened.
+bool emulated_flash_open(const char *path);
+
+/// @brief Sets every counter to zero.
+void emulated_flash_reset_stats(void);
+
+/// @brief Returns the counters since the last reset.
+emulated_flash_stats_t emulated_flash_get_stats(void);
+
+/// @brief Returns the time the NVM controller would have been busy for the given counters, in milliseconds.
+double emulated_flash_busy_ms(const emulated_flash_stats_t *stats);
@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Host benchmark for appends to the filesystem in filesystem/filesystem.c.
+ *
+ * For a growing number of files on the filesystem, it appends lines to a log file twice: once walking the
+ * whole filesystem for its free space before every append, as filesystem_append_file used to do, and once
+ * through filesystem_append_file with its cached block count. The flash is emulated in a file (see
+ * emulated_flash.c), so the host time per append is mostly littlefs' own work; the bytes read from flash per
+ * append are reported as well, since flash reads are what the walk costs on the watch.
+ *
+ * Build and run with `make run` in this directory.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "emulated_flash.h"
+#include "filesystem.h"
+#include "watch.h"
+#include "lfs.h"
+
+#define MAX_FILES 16
+#define FILES_STEP 2
+#define APPENDS 40
+
+extern lfs_t eeprom_filesystem;
+extern struct lfs_config watch_lfs_cfg;
+
+static int _count_block(void *p, lfs_block_t block) {
+    (void) block;
+    (*(uint32_t *)p)++;
+    return 0;
+}
+
+static double _now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void _prepare(int num_files) {
+    // a fresh filesystem, mounted again by filesystem_init so that its cached block count starts over.
+    lfs_unmount(&eeprom_filesystem);
+    lfs_format(&eeprom_filesystem, &watch_lfs_cfg);
+    if (!filesystem_init()) fprintf(stderr, "cannot mount the filesystem\n");
+    for (int i = 0; i < num_files; i++) {
+        char name[16];
+        char text[] = "some face settings, 32 bytes...";
+        snprintf(name, sizeof(name), "file%02d.txt", i);
+        filesystem_write_file(name, text, sizeof(text) - 1);
+    }
+}
+
+/// Appends APPENDS lines to a log and returns the seconds and flash bytes read per append.
+static void _run(bool walk, double *seconds, double *bytes_read) {
+    char line[] = "2026-10-16 12:34 21.5C 1013hPa\n";
+    uint64_t start_bytes = emulated_flash_get_stats().bytes_read;
+    double start = _now();
+
+    for (int i = 0; i < APPENDS; i++) {
+        if (walk) {
+            uint32_t blocks = 0;
+            lfs_fs_traverse(&eeprom_filesystem, _count_block, &blocks);
+        }
+        if (!filesystem_append_file("log.txt", line, sizeof(line) - 1)) {
+            fprintf(stderr, "append %d failed\n", i);
+            break;
+        }
+    }
+    filesystem_sync();
+
+    *seconds = (_now() - start) / APPENDS;
+    *bytes_read = (double)(emulated_flash_get_stats().bytes_read - start_bytes) / APPENDS;
+}
+
+int main(void) {
+    if (!emulated_flash_open(NULL)) {
+        fprintf(stderr, "cannot create the flash image\n");
+        return 1;
+    }
+    lfs_format(&eeprom_filesystem, &watch_lfs_cfg);
+    lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+
+    printf("%5s  %23s  %23s  %7s\n", "files", "walk: us, bytes read", "cached: us, bytes read", "speedup");
+    for (int num_files = 0; num_files <= MAX_FILES; num_files += FILES_STEP) {
+        double walk_seconds, walk_bytes, cached_seconds, cached_bytes;
+        _prepare(num_files);
+        _run(true, &walk_seconds, &walk_bytes);
+        _prepare(num_files);
+        _run(false, &cached_seconds, &cached_bytes);
+
+        printf("%5d  %10.1f %12.0f  %10.1f %12.0f  %6.1fx\n", num_files,
+               walk_seconds * 1e6, walk_bytes, cached_seconds * 1e6, cached_bytes,
+               cached_seconds > 0 ? walk_seconds / cached_seconds : 0);
+    }
+
+    return 0;
+}
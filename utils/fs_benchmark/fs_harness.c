@@ -0,0 +1,191 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Host benchmark harness for the littlefs configuration in filesystem/filesystem.c.
+ *
+ * It mounts the filesystem on an emulated RWWEE area (see emulated_flash.c) and replays the workloads the
+ * watch puts on it, each on a freshly formatted filesystem:
+ *
+ *  - settings: Movement saving its settings as a file, as it did before the key/value store
+ *  - kv store: the same through kv_store.c
+ *  - totp:     totp_lfs_face parsing its URIs once and then reading secrets as records are switched
+ *  - ring log: a sensor face logging a record every minute for a day, through ring_log.c
+ *  - text log: a face appending a line every minute for a day and starting over at 2 KB
+ *  - format:   the shell's format command
+ *
+ * For each, it reports erases (total and of the most erased row), page programs, bytes programmed and read,
+ * and how long the NVM controller would have been busy on the watch. The littlefs parameters can be set
+ * at compile time with FILESYSTEM_READ_SIZE, FILESYSTEM_CACHE_SIZE, FILESYSTEM_LOOKAHEAD_SIZE and
+ * FILESYSTEM_BLOCK_CYCLES; `make compare` runs the harness for a few variants next to the defaults.
+ *
+ * Build and run with `make run` in this directory. Pass a path to keep the flash image in that file.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "emulated_flash.h"
+#include "filesystem.h"
+#include "kv_store.h"
+#include "ring_log.h"
+#include "watch.h"
+#include "lfs.h"
+
+#define MINUTES_PER_DAY 1440
+
+extern lfs_t eeprom_filesystem;
+extern struct lfs_config watch_lfs_cfg;
+int _filesystem_format(void);
+
+// filesystem.c reports on stdout, so the results go to a stream of their own and stdout to /dev/null.
+static FILE *results;
+
+static void _fresh_filesystem(void) {
+    lfs_unmount(&eeprom_filesystem);
+    lfs_format(&eeprom_filesystem, &watch_lfs_cfg);
+    filesystem_init();
+}
+
+static uint32_t _settings(void) {
+    uint32_t settings[2] = { 0x12345678, 0 };
+    for (uint32_t i = 0; i < 200; i++) {
+        settings[1] = i;
+        filesystem_write_file("settings.u32", (char *)settings, sizeof(settings));
+    }
+    return 200;
+}
+
+static void _kv_store_setup(void) {
+    for (uint32_t row = filesystem_get_block_count(); row < NVMCTRL_RWWEE_PAGES / 4; row++) watch_storage_erase(row);
+    kv_store_init();
+}
+
+static uint32_t _kv_store(void) {
+    uint32_t settings[2] = { 0x12345678, 0 };
+    for (uint32_t i = 0; i < 200; i++) {
+        settings[1] = i;
+        kv_store_set(KV_STORE_KEY_SETTINGS, settings, sizeof(settings));
+    }
+    return 200;
+}
+
+static void _totp_setup(void) {
+    char line[128];
+    for (int i = 0; i < 12; i++) {
+        int length = sprintf(line, "otpauth://totp/Issuer%d:someone@example.com?secret=JBSWY3DPEHPK3PXPJBSWY3DPEHPK3PXP&issuer=Issuer%d\n", i, i);
+        filesystem_append_file("totp_uris.txt", line, length);
+    }
+    filesystem_sync();
+}
+
+static uint32_t _totp(void) {
+    filesystem_line_iter_t iter;
+    char line[256];
+    uint32_t offsets[12];
+    uint32_t count = 0;
+
+    filesystem_line_iter_open(&iter, "totp_uris.txt");
+    while (filesystem_line_iter_next(&iter, line, sizeof(line)) && count < 12) {
+        offsets[count++] = iter.line_offset + (strstr(line, "secret=") - line) + 7;
+    }
+    filesystem_line_iter_close(&iter);
+
+    // the face keeps the file open while it is active and seeks to the secret of every record it shows.
+    filesystem_file_t *file = filesystem_open("totp_uris.txt");
+    char secret[33];
+    for (uint32_t i = 0; i < 200; i++) {
+        filesystem_seek(file, offsets[i % count]);
+        filesystem_read(file, secret, 32);
+    }
+    filesystem_close(file);
+    return 201;
+}
+
+static uint32_t _ring_log(void) {
+    ring_log_t log;
+    ring_log_open(&log, "templog", sizeof(float), 18, 3);
+    for (uint32_t minute = 0; minute < MINUTES_PER_DAY; minute++) {
+        float temperature = 20.0f + (minute % 60) / 10.0f;
+        ring_log_append(&log, 1780000000 + minute * 60, &temperature);
+    }
+    filesystem_sync();
+    return MINUTES_PER_DAY;
+}
+
+static uint32_t _text_log(void) {
+    char line[32];
+    for (uint32_t minute = 0; minute < MINUTES_PER_DAY; minute++) {
+        if (filesystem_get_file_size("activity.csv") >= 2048) filesystem_rm("activity.csv");
+        int length = sprintf(line, "%02u:%02u,%u,%u\n", minute / 60, minute % 60, minute % 7, minute % 13);
+        filesystem_append_file("activity.csv", line, length);
+    }
+    filesystem_sync();
+    return MINUTES_PER_DAY;
+}
+
+static uint32_t _format(void) {
+    for (int i = 0; i < 10; i++) _filesystem_format();
+    return 10;
+}
+
+static void _run(const char *name, void (*setup)(void), uint32_t (*workload)(void)) {
+    _fresh_filesystem();
+    if (setup) setup();
+    emulated_flash_reset_stats();
+    uint32_t operations = workload();
+    emulated_flash_stats_t stats = emulated_flash_get_stats();
+
+    double busy_ms = emulated_flash_busy_ms(&stats);
+    fprintf(results, "%-9s %5u %7llu %5u %8llu %8.1f %8.1f %9.1f %7.2f\n", name, operations,
+           (unsigned long long)stats.erases, stats.max_row_erases, (unsigned long long)stats.programs,
+           stats.bytes_programmed / 1024.0, stats.bytes_read / 1024.0, busy_ms, busy_ms / operations);
+}
+
+int main(int argc, char **argv) {
+    if (!emulated_flash_open(argc > 1 ? argv[1] : NULL)) {
+        fprintf(stderr, "cannot create the flash image\n");
+        return 1;
+    }
+    results = fopen("/dev/stdout", "a");
+    if (results == NULL || freopen("/dev/null", "w", stdout) == NULL) {
+        fprintf(stderr, "cannot redirect stdout\n");
+        return 1;
+    }
+    lfs_format(&eeprom_filesystem, &watch_lfs_cfg);
+    lfs_mount(&eeprom_filesystem, &watch_lfs_cfg);
+
+    fprintf(results, "read_size %u, cache_size %u, lookahead_size %u, block_cycles %d\n",
+           (unsigned)watch_lfs_cfg.read_size, (unsigned)watch_lfs_cfg.cache_size,
+           (unsigned)watch_lfs_cfg.lookahead_size, (int)watch_lfs_cfg.block_cycles);
+    fprintf(results, "%-9s %5s %7s %5s %8s %8s %8s %9s %7s\n", "workload", "ops", "erases", "worst", "programs", "KB prog", "KB read", "busy ms", "ms/op");
+    _run("settings", NULL, _settings);
+    _run("kv store", _kv_store_setup, _kv_store);
+    _run("totp", _totp_setup, _totp);
+    _run("ring log", NULL, _ring_log);
+    _run("text log", NULL, _text_log);
+    _run("format", NULL, _format);
+
+    return 0;
+}
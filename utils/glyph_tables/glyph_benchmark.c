@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Host benchmark for the glyph tables in watch_common_glyphs.h.
+ *
+ * For both LCD types, it first draws every printable character in every position onto a set of random
+ * frames, once with legacy_display_character and once with watch_display_character, and checks that both
+ * leave the same pixels behind. It then times both paths rendering the same stream of characters into a
+ * RAM copy of the SLCD registers, like the hardware's watch_set_pixel does, and reports characters per
+ * second.
+ *
+ * Build and run with `make run` in this directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "legacy_display.h"
+#include "watch_slcd.h"
+#include "watch_common_display.h"
+
+#define NUM_COMS 8
+#define NUM_FRAMES 64
+#define ROUNDS 20000
+
+static watch_lcd_type_t lcd_type;
+static uint32_t shadow[NUM_COMS];
+static uint8_t dirty_coms;
+
+watch_lcd_type_t watch_get_lcd_type(void) {
+    return lcd_type;
+}
+
+void watch_set_pixel(uint8_t com, uint8_t seg) {
+    if (com >= NUM_COMS || seg >= 32) return;
+    shadow[com] |= 1u << seg;
+    dirty_coms |= 1u << com;
+}
+
+void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    if (com >= NUM_COMS || seg >= 32) return;
+    shadow[com] &= ~(1u << seg);
+    dirty_coms |= 1u << com;
+}
+
+void watch_update_pixels(uint8_t com, uint32_t mask, uint32_t value) {
+    if (com >= NUM_COMS) return;
+    shadow[com] = (shadow[com] & ~mask) | value;
+    dirty_coms |= 1u << com;
+}
+
+// watch_common_display.c also holds the animations, which the benchmark does not run.
+void _watch_slcd_start_animation(uint32_t duration) {
+    (void) duration;
+}
+
+void _watch_slcd_stop_animation(void) {
+}
+
+static double _now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t _random_word(void) {
+    return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+static unsigned _check(uint8_t num_positions) {
+    unsigned mismatches = 0;
+
+    for (int f = 0; f < NUM_FRAMES; f++) {
+        uint32_t before[NUM_COMS];
+        uint32_t expected[NUM_COMS];
+        for (int com = 0; com < NUM_COMS; com++) {
+            before[com] = f == 0 ? 0 : f == 1 ? 0xffffffff : _random_word();
+        }
+
+        for (uint8_t position = 0; position < num_positions; position++) {
+            for (int c = 0x20; c <= 0x7e; c++) {
+                memcpy(shadow, before, sizeof(shadow));
+                legacy_display_character(c, position);
+                memcpy(expected, shadow, sizeof(shadow));
+
+                memcpy(shadow, before, sizeof(shadow));
+                watch_display_character(c, position);
+                if (memcmp(expected, shadow, sizeof(shadow)) != 0) {
+                    if (mismatches++ < 10) printf("  mismatch: '%c' in position %d\n", c, position);
+                }
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+static double _time(void (*draw)(uint8_t, uint8_t), uint8_t num_positions, uint64_t *characters) {
+    double start = _now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (uint8_t position = 0; position < num_positions; position++) {
+            for (int c = 0x20; c <= 0x7e; c++) {
+                draw(c, position);
+            }
+        }
+    }
+    *characters = (uint64_t)ROUNDS * num_positions * (0x7f - 0x20);
+    return _now() - start;
+}
+
+static int _run(const char *name, watch_lcd_type_t type, uint8_t num_positions) {
+    uint64_t characters;
+
+    lcd_type = type;
+    _watch_update_glyph_table();
+
+    unsigned mismatches = _check(num_positions);
+    double legacy_time = _time(legacy_display_character, num_positions, &characters);
+    double table_time = _time(watch_display_character, num_positions, &characters);
+
+    printf("%s LCD, %d positions:\n", name, num_positions);
+    printf("  mismatches:     %u\n", mismatches);
+    printf("  legacy path:    %.3f s, %.1f M characters/s\n", legacy_time, characters / legacy_time / 1e6);
+    printf("  glyph tables:   %.3f s, %.1f M characters/s\n", table_time, characters / table_time / 1e6);
+    printf("  speedup:        %.2fx\n", legacy_time / table_time);
+    printf("  (checksum %08x)\n", shadow[0] ^ shadow[1] ^ shadow[2] ^ shadow[3] ^ dirty_coms);
+
+    return mismatches ? 1 : 0;
+}
+
+int main(void) {
+    srand(1);
+
+    int failed = 0;
+    failed |= _run("Classic", WATCH_LCD_TYPE_CLASSIC, sizeof(Classic_LCD_Display_Mapping) / sizeof(Classic_LCD_Display_Mapping[0]));
+    failed |= _run("Custom", WATCH_LCD_TYPE_CUSTOM, sizeof(Custom_LCD_Display_Mapping) / sizeof(Custom_LCD_Display_Mapping[0]));
+
+    return failed;
+}
@@ -0,0 +1,192 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Generates the glyph tables in watch-library/shared/watch/watch_common_glyphs.h.
+ *
+ * For both LCD types, it draws every printable character in every position with legacy_display_character,
+ * the reference implementation of the position-specific substitutions, and records which pixels the draw
+ * clears and which it lights. A position's mask is the set of pixels that any character clears; every
+ * character must touch all of them, so that drawing a glyph can replace them in one masked update. Lit
+ * pixels outside segments A-H (the funky ninth segment and the descender of T) get one of two extra
+ * segment slots.
+ *
+ * Run `make generate` in this directory to rebuild the header. The Makefile puts this file's license in front
+ * of the output.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "legacy_display.h"
+#include "watch_slcd.h"
+#include "watch_common_display.h"
+
+static watch_lcd_type_t lcd_type;
+static uint32_t frame[GLYPH_NUM_COMS];
+static uint32_t touched[GLYPH_NUM_COMS];
+static uint32_t cleared[GLYPH_NUM_COMS];
+
+watch_lcd_type_t watch_get_lcd_type(void) {
+    return lcd_type;
+}
+
+void watch_set_pixel(uint8_t com, uint8_t seg) {
+    if (com >= GLYPH_NUM_COMS) {
+        fprintf(stderr, "pixel (%d, %d) is outside the glyph tables\n", com, seg);
+        exit(1);
+    }
+    frame[com] |= 1u << seg;
+    touched[com] |= 1u << seg;
+}
+
+void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    if (com >= GLYPH_NUM_COMS) {
+        fprintf(stderr, "pixel (%d, %d) is outside the glyph tables\n", com, seg);
+        exit(1);
+    }
+    frame[com] &= ~(1u << seg);
+    touched[com] |= 1u << seg;
+    cleared[com] |= 1u << seg;
+}
+
+static int _find_slot(const glyph_position_t *position, uint8_t com, uint8_t seg) {
+    for (int i = 0; i < GLYPH_NUM_SEGMENTS; i++) {
+        if (position->segment[i].value == segment_does_not_exist) continue;
+        if (position->segment[i].address.com == com && position->segment[i].address.seg == seg) return i;
+    }
+    return -1;
+}
+
+static void _build_position(glyph_position_t *position, const digit_mapping_t *mapping, uint8_t index) {
+    uint32_t lit[GLYPH_NUM_CHARACTERS][GLYPH_NUM_COMS];
+    uint32_t touched_by[GLYPH_NUM_CHARACTERS][GLYPH_NUM_COMS];
+
+    memset(position, 0, sizeof(*position));
+    for (int i = 0; i < GLYPH_NUM_SEGMENTS; i++) {
+        position->segment[i].value = i < 8 ? mapping->segment[i].value : segment_does_not_exist;
+    }
+
+    for (int c = 0; c < GLYPH_NUM_CHARACTERS; c++) {
+        memset(frame, 0, sizeof(frame));
+        memset(touched, 0, sizeof(touched));
+        memset(cleared, 0, sizeof(cleared));
+        legacy_display_character(c + 0x20, index);
+        memcpy(lit[c], frame, sizeof(frame));
+        memcpy(touched_by[c], touched, sizeof(touched));
+        for (int com = 0; com < GLYPH_NUM_COMS; com++) position->mask[com] |= cleared[com];
+    }
+
+    for (int c = 0; c < GLYPH_NUM_CHARACTERS; c++) {
+        for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) {
+            if (position->mask[com] & ~touched_by[c][com]) {
+                fprintf(stderr, "position %d, '%c' leaves pixels of the mask untouched\n", index, c + 0x20);
+                exit(1);
+            }
+            for (uint8_t seg = 0; seg < 32; seg++) {
+                if (!(lit[c][com] & (1u << seg))) continue;
+                int slot = _find_slot(position, com, seg);
+                if (slot < 0) {
+                    for (slot = 8; slot < GLYPH_NUM_SEGMENTS; slot++) {
+                        if (position->segment[slot].value == segment_does_not_exist) break;
+                    }
+                    if (slot == GLYPH_NUM_SEGMENTS) {
+                        fprintf(stderr, "position %d has too many pixels outside the digit\n", index);
+                        exit(1);
+                    }
+                    position->segment[slot].address.com = com;
+                    position->segment[slot].address.seg = seg;
+                }
+                position->glyph[c] |= 1u << slot;
+            }
+        }
+    }
+}
+
+static void _print_table(const char *name, const glyph_table_t *table) {
+    printf("static const glyph_table_t %s = {\n", name);
+    printf("    .num_positions = %d,\n", table->num_positions);
+    printf("    .position = {\n");
+    for (int p = 0; p < table->num_positions; p++) {
+        const glyph_position_t *position = &table->position[p];
+        printf("        {   // position %d\n", p);
+        printf("            .mask = { 0x%08x, 0x%08x, 0x%08x, 0x%08x },\n",
+               position->mask[0], position->mask[1], position->mask[2], position->mask[3]);
+        printf("            .segment = {\n");
+        for (int i = 0; i < GLYPH_NUM_SEGMENTS; i++) {
+            if (position->segment[i].value == segment_does_not_exist) {
+                printf("                { .value = segment_does_not_exist },\n");
+            } else {
+                printf("                { .address = { .com = %d, .seg = %2d } },\n",
+                       position->segment[i].address.com, position->segment[i].address.seg);
+            }
+        }
+        printf("            },\n");
+        printf("            .glyph = {\n");
+        for (int c = 0; c < GLYPH_NUM_CHARACTERS; c += 16) {
+            printf("               ");
+            for (int i = c; i < c + 16 && i < GLYPH_NUM_CHARACTERS; i++) printf(" 0x%03x,", position->glyph[i]);
+            printf(" // 0x%02x-0x%02x\n", c + 0x20, (c + 15 < GLYPH_NUM_CHARACTERS ? c + 15 : GLYPH_NUM_CHARACTERS - 1) + 0x20);
+        }
+        printf("            },\n");
+        printf("        },\n");
+    }
+    printf("    },\n");
+    printf("};\n");
+}
+
+static glyph_table_t classic_table;
+static glyph_table_t custom_table;
+
+int main(void) {
+    lcd_type = WATCH_LCD_TYPE_CLASSIC;
+    classic_table.num_positions = sizeof(Classic_LCD_Display_Mapping) / sizeof(Classic_LCD_Display_Mapping[0]);
+    for (uint8_t p = 0; p < classic_table.num_positions; p++) {
+        _build_position(&classic_table.position[p], &Classic_LCD_Display_Mapping[p], p);
+    }
+
+    lcd_type = WATCH_LCD_TYPE_CUSTOM;
+    custom_table.num_positions = sizeof(Custom_LCD_Display_Mapping) / sizeof(Custom_LCD_Display_Mapping[0]);
+    for (uint8_t p = 0; p < custom_table.num_positions; p++) {
+        _build_position(&custom_table.position[p], &Custom_LCD_Display_Mapping[p], p);
+    }
+
+    printf("// Generated by utils/glyph_tables from the character sets and mappings in watch_common_display.h and\n");
+    printf("// the substitutions in utils/glyph_tables/legacy_display.c. Do not edit; run `make generate` there.\n");
+    printf("\n");
+    printf("#ifndef _WATCH_COMMON_GLYPHS_H_INCLUDED\n");
+    printf("#define _WATCH_COMMON_GLYPHS_H_INCLUDED\n");
+    printf("\n");
+    printf("#include \"watch_common_display.h\"\n");
+    printf("\n");
+    _print_table("Classic_LCD_Glyph_Table", &classic_table);
+    printf("\n");
+    _print_table("Custom_LCD_Glyph_Table", &custom_table);
+    printf("\n");
+    printf("#endif\n");
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * The character rendering that watch_display_character used before the glyph tables, kept as the reference
+ * for generating them (glyph_tables.c) and for checking and timing them (glyph_benchmark.c).
+ *
+ * The position-specific substitutions below are the source of truth: change them here, then run
+ * `make generate` to rebuild watch_common_glyphs.h.
+ */
+
+#include "legacy_display.h"
+#include "watch_slcd.h"
+#include "watch_common_display.h"
+
+void legacy_display_character(uint8_t character, uint8_t position) {
+    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
+        if (character == 'R' && position > 1 && position < 8) character = 'r'; // We can't display uppercase R in these positions
+        else if (character == 'T' && position > 1 && position < 8) character = 't'; // lowercase t is the only option for these positions
+    } else {
+        // special cases for positions 4 and 6
+        if (position == 4 || position == 6) {
+            if (character == '7') character = '&'; // "lowercase" 7
+            else if (character == 'A') character = 'a'; // A needs to be lowercase
+            else if (character == 'o') character = 'O'; // O needs to be uppercase
+            else if (character == 'L') character = '!'; // L needs to be in top half
+            else if (character == 'M' || character == 'm' || character == 'N') character = 'n'; // M and uppercase N need to be lowercase n
+            else if (character == 'c') character = 'C'; // C needs to be uppercase
+            else if (character == 'J') character = 'j'; // same
+            else if (character == 'v' || character == 'V' || character == 'U' || character == 'W' || character == 'w') character = 'u'; // bottom segment duplicated, so show in top half
+            else if (character == 't' || character == 'T') character = '+'; // avoid confusion with uppercase E
+        } else {
+            if (character == 'u') character = 'v'; // we can use the bottom segment; move to lower half
+            else if (character == 'j') character = 'J'; // same but just display a normal J
+            else if (character == '.') character = '_'; // we can use the bottom segment; make dot an underscore
+        }
+        if (position > 1) {
+            if (character == 'T') character = 't'; // uppercase T only works in positions 0 and 1
+        }
+        if (position == 1) {
+            if (character == 'a') character = 'A'; // A needs to be uppercase
+            else if (character == 'o') character = 'O'; // O needs to be uppercase
+            else if (character == 'i') character = 'l'; // I needs to be uppercase (use an l, it looks the same)
+            else if (character == 'n') character = 'N'; // N needs to be uppercase
+            else if (character == 'r') character = 'R'; // R needs to be uppercase
+            else if (character == 'd') character = 'D'; // D needs to be uppercase
+            else if (character == 'v' || character == 'V' || character == 'u') character = 'U'; // side segments shared, make uppercase
+            else if (character == 'b') character = 'B'; // B needs to be uppercase
+            else if (character == 'c') character = 'C'; // C needs to be uppercase
+        } else {
+            if (character == 'R') character = 'r'; // R needs to be lowercase almost everywhere
+        }
+        if (position == 0) {
+            watch_clear_pixel(0, 15); // clear funky ninth segment
+        } else {
+            if (character == 'I') character = 'l'; // uppercase I only works in position 0
+        }
+    }
+
+    digit_mapping_t segmap;
+    uint8_t segdata;
+
+    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
+        segmap = Custom_LCD_Display_Mapping[position];
+        segdata = Custom_LCD_Character_Set[character - 0x20];
+    } else {
+        segmap = Classic_LCD_Display_Mapping[position];
+        segdata = Classic_LCD_Character_Set[character - 0x20];
+    }
+
+    for (int i = 0; i < 8; i++) {
+        if (segmap.segment[i].value == segment_does_not_exist) {
+            // Segment does not exist; skip it.
+            segdata = segdata >> 1;
+            continue;
+        }
+        uint8_t com = segmap.segment[i].address.com;
+        uint8_t seg = segmap.segment[i].address.seg;
+
+        if (segdata & 1) {
+            watch_set_pixel(com, seg);
+        }
+        else {
+            watch_clear_pixel(com, seg);
+        }
+
+        segdata = segdata >> 1;
+    }
+
+    if (character == 'T' && position == 1) watch_set_pixel(1, 12); // add descender
+    else if (position == 0 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 15); // add funky ninth segment
+    else if (position == 1 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 12); // add funky ninth segment
+}
@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""
+Replays, summarizes and compares display traces recorded by the native
+simulator (build-native/movement --record FILE).
+
+A trace starts with an 8 byte header: the magic "LCDT", the format version
+(1), the LCD type (0xA9 classic, 0x56 custom), the number of COM words per
+frame and the RTC counter ticks per second. Then follows one record per
+committed frame in which the display changed or a face wrote segments:
+
+    varint  ticks since the previous record (the first counts from 0)
+    u8      mask of the COM words that changed
+    varint  segments written through the pixel functions since the last record
+    u32     new value of every changed COM word, little endian, lowest COM first
+
+Varints are unsigned LEB128. A record whose COM mask is zero is a redraw that
+left the display as it was.
+
+    lcd_trace.py dump TRACE
+    lcd_trace.py stats TRACE [--after SECONDS] [--max-writes N] [--max-redundant N]
+    lcd_trace.py diff GOLDEN TRACE [--limit N]
+
+stats exits with 1 if a budget is exceeded, diff if the displays differ, so
+both can gate a script or CI job, e.g. to hold clock_face to its segment
+write budget once it has drawn its first full frame:
+
+    movement -s "2026-01-01 11:59:00" -d 10m -q -r clock.trace
+    lcd_trace.py stats clock.trace --after 1 --max-writes 80 --max-redundant 0
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"LCDT"
+LCD_TYPES = {0xA9: "classic", 0x56: "custom"}
+
+
+class Trace:
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if len(data) < 8 or data[0:4] != MAGIC:
+            raise ValueError(f"{path}: not a display trace")
+        if data[4] != 1:
+            raise ValueError(f"{path}: unsupported trace version {data[4]}")
+        self.path = path
+        self.lcd_type = LCD_TYPES.get(data[5], f"0x{data[5]:02x}")
+        self.num_coms = data[6]
+        self.ticks_per_second = data[7]
+        self.records = list(self._parse(data, 8))
+
+    def _parse(self, data, pos):
+        """Yields (ticks, writes, changed_coms, frame) with the absolute tick and the frame after the record."""
+        frame = [0] * self.num_coms
+        ticks = 0
+        try:
+            while pos < len(data):
+                delta, pos = _varint(data, pos)
+                changed = data[pos]
+                pos += 1
+                writes, pos = _varint(data, pos)
+                for com in range(self.num_coms):
+                    if changed & (1 << com):
+                        (frame[com],) = struct.unpack_from("<I", data, pos)
+                        pos += 4
+                ticks += delta
+                yield ticks, writes, changed, tuple(frame)
+        except (IndexError, struct.error):
+            # the simulator was killed while writing; keep what is complete.
+            print(f"{self.path}: truncated record at offset {pos}", file=sys.stderr)
+
+    def seconds(self, ticks):
+        return ticks / self.ticks_per_second
+
+
+def _varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, pos
+        shift += 7
+
+
+def _segments(bits):
+    return [seg for seg in range(32) if bits & (1 << seg)]
+
+
+def _describe_change(before, after):
+    parts = []
+    for com, (a, b) in enumerate(zip(before, after)):
+        on = _segments(b & ~a)
+        off = _segments(a & ~b)
+        if on:
+            parts.append(f"+{com}:" + ",".join(map(str, on)))
+        if off:
+            parts.append(f"-{com}:" + ",".join(map(str, off)))
+    return " ".join(parts)
+
+
+def dump(args):
+    trace = Trace(args.trace)
+    print(f"# {trace.lcd_type} LCD, {trace.num_coms} COMs, {trace.ticks_per_second} ticks/s")
+    previous = (0,) * trace.num_coms
+    for ticks, writes, changed, frame in trace.records:
+        words = " ".join(f"{word:08x}" for word in frame[:4])
+        change = _describe_change(previous, frame) if changed else "(unchanged)"
+        print(f"{trace.seconds(ticks):10.3f}s  {writes:4d} writes  {words}  {change}")
+        previous = frame
+    return 0
+
+
+def stats(args):
+    trace = Trace(args.trace)
+    first = next((i for i, r in enumerate(trace.records) if trace.seconds(r[0]) >= args.after), len(trace.records))
+    records = trace.records[first:]
+    if not records:
+        print("no frames")
+        return 0
+
+    frames = [r for r in records if r[2]]
+    redundant = [r for r in records if not r[2]]
+    writes = [r[1] for r in records]
+    previous = trace.records[first - 1][3] if first else (0,) * trace.num_coms
+    changed_segments = []
+    for ticks, _, changed, frame in records:
+        if changed:
+            changed_segments.append(sum(bin(a ^ b).count("1") for a, b in zip(previous, frame)))
+        previous = frame
+
+    span = trace.seconds(records[-1][0] - records[0][0]) or 1 / trace.ticks_per_second
+    intervals = [b[0] - a[0] for a, b in zip(frames, frames[1:])]
+    print(f"records:            {len(records)} over {span:.3f} s")
+    print(f"display changes:    {len(frames)} ({len(frames) / span:.2f}/s)")
+    print(f"redundant redraws:  {len(redundant)}")
+    print(f"segment writes:     {sum(writes)} total, {sum(writes) / len(records):.1f} avg, {max(writes)} max per record")
+    if changed_segments:
+        print(f"segments changed:   {sum(changed_segments) / len(changed_segments):.1f} avg, "
+              f"{max(changed_segments)} max per change")
+    if intervals:
+        print(f"change interval:    {trace.seconds(min(intervals)):.3f} s min, "
+              f"{trace.seconds(sum(intervals) / len(intervals)):.3f} s avg")
+
+    ok = True
+    if args.max_writes is not None:
+        for ticks, count, _, _ in records:
+            if count > args.max_writes:
+                print(f"{trace.seconds(ticks):.3f}s: {count} segment writes exceed the budget of {args.max_writes}")
+                ok = False
+                break
+    if args.max_redundant is not None and len(redundant) > args.max_redundant:
+        first = trace.seconds(redundant[0][0])
+        print(f"{len(redundant)} redundant redraws exceed the budget of {args.max_redundant}, the first at {first:.3f}s")
+        ok = False
+    return 0 if ok else 1
+
+
+def diff(args):
+    golden = Trace(args.golden)
+    trace = Trace(args.trace)
+    if golden.num_coms != trace.num_coms or golden.ticks_per_second != trace.ticks_per_second:
+        print("traces have different formats")
+        return 1
+
+    # walk both timelines and compare what the display shows after every tick that either one changed.
+    def timeline(t):
+        return [(ticks, frame) for ticks, _, changed, frame in t.records if changed]
+
+    a, b = timeline(golden), timeline(trace)
+    i = j = 0
+    shown_a = shown_b = (0,) * golden.num_coms
+    differences = 0
+    while i < len(a) or j < len(b):
+        ticks = min(a[i][0] if i < len(a) else float("inf"), b[j][0] if j < len(b) else float("inf"))
+        while i < len(a) and a[i][0] == ticks:
+            shown_a = a[i][1]
+            i += 1
+        while j < len(b) and b[j][0] == ticks:
+            shown_b = b[j][1]
+            j += 1
+        if shown_a != shown_b:
+            differences += 1
+            if differences <= args.limit:
+                print(f"{golden.seconds(ticks):10.3f}s  {_describe_change(shown_a, shown_b)}")
+    if differences > args.limit:
+        print(f"... {differences - args.limit} more")
+    if differences:
+        print(f"{differences} differing frames")
+    return 1 if differences else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    p = commands.add_parser("dump", help="print every record")
+    p.add_argument("trace")
+    p.set_defaults(run=dump)
+
+    p = commands.add_parser("stats", help="summarize display changes and segment writes")
+    p.add_argument("trace")
+    p.add_argument("--after", type=float, default=0, help="ignore records before this many seconds")
+    p.add_argument("--max-writes", type=int, help="fail if a record writes more segments")
+    p.add_argument("--max-redundant", type=int, help="fail if more redraws leave the display unchanged")
+    p.set_defaults(run=stats)
+
+    p = commands.add_parser("diff", help="compare the display against a golden trace")
+    p.add_argument("golden")
+    p.add_argument("trace")
+    p.add_argument("--limit", type=int, default=20, help="differences to print (default 20)")
+    p.set_defaults(run=diff)
+
+    args = parser.parse_args()
+    try:
+        return args.run(args)
+    except (OSError, ValueError) as e:
+        print(e, file=sys.stderr)
+        return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""
+Captures and decodes the event trace of a watch built with TRACE=1 (see watch-library/shared/watch/watch_trace.h).
+
+The shell's trace command streams an 8 byte header: the magic "WTRC", the format version (1), a reserved
+byte and the RTC ticks per second (u16). Then follows one 8 byte record per event, little endian:
+
+    u32     RTC counter when the event was logged
+    u8      type, see TYPES below
+    u8      face index, 255 before Movement picked one
+    u16     argument, depending on the type
+
+The stream ends with a record of type 0 once the requested time is up.
+
+    watch_trace.py capture --port /dev/ttyACM0 [--seconds N] TRACE
+    watch_trace.py dump TRACE
+    watch_trace.py stats TRACE
+
+capture saves the stream of one trace command. dump and stats also accept anything that contains a stream,
+e.g. the output of the native simulator:
+
+    printf 'trace 30\\n' | build-native/movement -c -q -i buttons.txt > native.trace
+
+stats prints latency histograms: from a button edge to the face handling the event and on to the display,
+how long faces spend in their loop, how far ticks stray from their period and how late comparator
+callbacks fire. --port needs pyserial.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+MAGIC = b"WTRC"
+RECORD = struct.Struct("<IBBH")
+
+END, BUTTON_EDGE, BUTTON_EVENT, FACE_LOOP, FACE_LOOP_DONE, DISPLAY_COMMIT, TICK, COMP, DROPPED = range(9)
+TYPES = {
+    END: "end",
+    BUTTON_EDGE: "button edge",
+    BUTTON_EVENT: "button event",
+    FACE_LOOP: "face loop",
+    FACE_LOOP_DONE: "face loop done",
+    DISPLAY_COMMIT: "display commit",
+    TICK: "tick",
+    COMP: "comparator",
+    DROPPED: "dropped",
+}
+
+
+class Trace:
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        start = data.find(MAGIC)
+        if start < 0 or len(data) < start + 8:
+            raise ValueError(f"{path}: no trace stream found")
+        if data[start + 4] != 1:
+            raise ValueError(f"{path}: unsupported trace version {data[start + 4]}")
+        (self.ticks_per_second,) = struct.unpack_from("<H", data, start + 6)
+        self.records = []
+        self.complete = False
+        pos = start + 8
+        while pos + RECORD.size <= len(data):
+            record = RECORD.unpack_from(data, pos)
+            pos += RECORD.size
+            if record[1] == END:
+                self.complete = True
+                break
+            self.records.append(record)
+        if not self.complete:
+            print(f"{path}: stream ends without an end record", file=sys.stderr)
+
+    def ms(self, ticks):
+        return ticks * 1000 / self.ticks_per_second
+
+
+def _describe(record):
+    counter, kind, face, arg = record
+    face = "-" if face == 255 else str(face)
+    return f"{TYPES.get(kind, f'type {kind}'):15s} face {face:>3s}  arg {arg}"
+
+
+def dump(args):
+    trace = Trace(args.trace)
+    print(f"# {trace.ticks_per_second} ticks/s, {len(trace.records)} records")
+    if not trace.records:
+        return 0
+    first = trace.records[0][0]
+    for record in trace.records:
+        print(f"{trace.ms((record[0] - first) & 0xFFFFFFFF) / 1000:10.3f}s  {_describe(record)}")
+    return 0
+
+
+def _histogram(trace, title, samples):
+    """Prints samples, in RTC ticks, in power of two buckets."""
+    print(f"{title}: ", end="")
+    if not samples:
+        print("no samples")
+        return
+    samples = sorted(samples)
+    print(f"{len(samples)} samples, median {trace.ms(samples[len(samples) // 2]):.1f} ms, "
+          f"max {trace.ms(samples[-1]):.1f} ms")
+    buckets = {}
+    for ticks in samples:
+        bucket = 0 if ticks <= 0 else ticks.bit_length()
+        buckets[bucket] = buckets.get(bucket, 0) + 1
+    widest = max(buckets.values())
+    for bucket in sorted(buckets):
+        low = 0 if bucket == 0 else 1 << (bucket - 1)
+        high = 0 if bucket == 0 else (1 << bucket) - 1
+        label = f"{trace.ms(low):7.1f} ms" if low == high else f"{trace.ms(low):7.1f}-{trace.ms(high):.1f} ms"
+        count = buckets[bucket]
+        print(f"  {label:22s} {count:6d} {'#' * max(1, count * 40 // widest)}")
+
+
+def stats(args):
+    trace = Trace(args.trace)
+    records = trace.records
+
+    def delta(a, b):
+        return (b - a) & 0xFFFFFFFF
+
+    edge_to_event = []
+    event_to_loop = []
+    loop_time = []
+    loop_to_display = []
+    edge_to_display = []
+    tick_jitter = []
+    comp_late = []
+    dropped = 0
+    unchanged = 0
+
+    last_edge = None
+    pending = []        # button events waiting for their face loop: (edge counter, event counter, event type)
+    loop_start = None
+    awaiting_display = []   # edge counters and loop end counters of handled button events
+    last_tick = None
+    for counter, kind, face, arg in records:
+        if kind == BUTTON_EDGE:
+            last_edge = counter
+        elif kind == BUTTON_EVENT:
+            if last_edge is not None:
+                edge_to_event.append(delta(last_edge, counter))
+            if arg:
+                pending.append((last_edge if last_edge is not None else counter, counter, arg))
+        elif kind == FACE_LOOP:
+            # the display is committed once per pass of the main loop. A face that runs in a later pass,
+            # i.e. a later tick, means that the events before it left the display unchanged.
+            unchanged += sum(1 for _, done in awaiting_display if done != counter)
+            awaiting_display = [(edge, done) for edge, done in awaiting_display if done == counter]
+            loop_start = (counter, arg)
+            match = next((p for p in pending if p[2] == arg), None)
+            if match:
+                pending.remove(match)
+                event_to_loop.append(delta(match[1], counter))
+                loop_start = (counter, arg, match[0])
+        elif kind == FACE_LOOP_DONE and loop_start:
+            loop_time.append(delta(loop_start[0], counter))
+            if len(loop_start) == 3:
+                awaiting_display.append((loop_start[2], counter))
+            loop_start = None
+        elif kind == DISPLAY_COMMIT:
+            for edge, done in awaiting_display:
+                loop_to_display.append(delta(done, counter))
+                edge_to_display.append(delta(edge, counter))
+            awaiting_display = []
+        elif kind == TICK:
+            # only compare ticks of the same frequency, and skip gaps of more than one period.
+            if last_tick is not None and last_tick[1] == arg and arg:
+                period = trace.ticks_per_second // arg
+                interval = delta(last_tick[0], counter)
+                if interval < 2 * period:
+                    tick_jitter.append(abs(interval - period))
+            last_tick = (counter, arg)
+        elif kind == COMP:
+            comp_late.append(arg)
+        elif kind == DROPPED:
+            dropped += arg
+
+    span = delta(records[0][0], records[-1][0]) if records else 0
+    print(f"{len(records)} records over {trace.ms(span) / 1000:.3f} s, {trace.ticks_per_second} ticks/s")
+    if dropped:
+        print(f"{dropped} records were dropped; the latencies around the gaps are missing")
+    _histogram(trace, "button edge to event", edge_to_event)
+    _histogram(trace, "button event to face loop", event_to_loop)
+    _histogram(trace, "face loop", loop_time)
+    _histogram(trace, "face loop to display", loop_to_display)
+    _histogram(trace, "button edge to display", edge_to_display)
+    if unchanged:
+        print(f"  ({unchanged} button events left the display unchanged)")
+    _histogram(trace, "tick jitter", tick_jitter)
+    _histogram(trace, "comparator lateness", comp_late)
+
+    faces = {}
+    for (start, kind, face, _), (end, end_kind, _, _) in zip(records, records[1:]):
+        if kind == FACE_LOOP and end_kind == FACE_LOOP_DONE:
+            faces.setdefault(face, []).append(delta(start, end))
+    if faces:
+        print("face  loops  total ms  max ms")
+        for face in sorted(faces):
+            times = faces[face]
+            print(f"{face:4d}  {len(times):5d}  {trace.ms(sum(times)):8.1f}  {trace.ms(max(times)):6.1f}")
+    return 0
+
+
+def capture(args):
+    import serial  # pyserial
+    port = serial.Serial(args.port, 115200, timeout=0)
+    port.reset_input_buffer()
+    port.write(f"trace {args.seconds}\r".encode())
+
+    data = b""
+    deadline = time.monotonic() + args.seconds + 5
+    start = -1
+    while time.monotonic() < deadline:
+        data += port.read(4096)
+        if start < 0:
+            start = data.find(MAGIC)
+            continue
+        # look for the end record at a record boundary.
+        records = data[start + 8:]
+        ends = [i for i in range(0, len(records) - RECORD.size + 1, RECORD.size) if records[i + 4] == END]
+        if ends:
+            data = data[start:start + 8 + ends[0] + RECORD.size]
+            break
+        time.sleep(0.01)
+    else:
+        raise OSError("the watch did not finish the trace; was it built with TRACE=1?")
+
+    with open(args.trace, "wb") as f:
+        f.write(data)
+    print(f"{(len(data) - 8) // RECORD.size - 1} records")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    p = commands.add_parser("capture", help="run the trace command and save its stream")
+    p.add_argument("--port", required=True)
+    p.add_argument("--seconds", type=int, default=10, help="how long to trace (default 10)")
+    p.add_argument("trace")
+    p.set_defaults(run=capture)
+
+    p = commands.add_parser("dump", help="print every record")
+    p.add_argument("trace")
+    p.set_defaults(run=dump)
+
+    p = commands.add_parser("stats", help="print latency histograms")
+    p.add_argument("trace")
+    p.set_defaults(run=stats)
+
+    args = parser.parse_args()
+    try:
+        return args.run(args)
+    except (OSError, ValueError) as e:
+        print(e, file=sys.stderr)
+        return 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -105,9 +105,15 @@ static void clock_check_battery_periodically(clock_state_t *state, watch_date_ti
     clock_indicate_low_available_power(state);
 }
 
+static void clock_update_advisory_cadence(clock_state_t *state) {
+    // the time signal only ever sounds at the top of the hour.
+    movement_set_advisory_cadence_for_face(state->watch_face_index, state->time_signal_enabled ? MOVEMENT_ADVISE_HOURLY : MOVEMENT_ADVISE_NEVER);
+}
+
 static void clock_toggle_time_signal(clock_state_t *state) {
     state->time_signal_enabled = !state->time_signal_enabled;
     clock_indicate_time_signal(state);
+    clock_update_advisory_cadence(state);
 }
 
 static void clock_display_all(watch_date_time_t date_time) {
@@ -123,7 +129,8 @@ static void clock_display_all(watch_date_time_t date_time) {
         date_time.unit.second
     );
 
-    watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, watch_utility_get_long_weekday(date_time), watch_utility_get_weekday(date_time));
+    uint8_t weekday = movement_get_local_calendar()->weekday;
+    watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, watch_utility_get_long_weekday_name(weekday), watch_utility_get_weekday_name(weekday));
     watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
     watch_display_text(WATCH_POSITION_BOTTOM, buf + 2);
 }
@@ -187,7 +194,8 @@ static void clock_display_low_energy(watch_date_time_t date_time) {
         date_time.unit.minute
     );
 
-    watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, watch_utility_get_long_weekday(date_time), watch_utility_get_weekday(date_time));
+    uint8_t weekday = movement_get_local_calendar()->weekday;
+    watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, watch_utility_get_long_weekday_name(weekday), watch_utility_get_weekday_name(weekday));
     watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
     watch_display_text(WATCH_POSITION_BOTTOM, buf + 2);
 }
@@ -215,6 +223,8 @@ void clock_face_setup(uint8_t watch_face_index, void ** context_ptr) {
         state->time_signal_enabled = false;
         state->watch_face_index = watch_face_index;
     }
+
+    clock_update_advisory_cadence((clock_state_t *) *context_ptr);
 }
 
 void clock_face_activate(void *context) {
@@ -210,9 +210,10 @@ bool close_enough_face_loop(movement_event_t event, void *context) {
                 sprintf(third_word, "%2d", close_enough_hour);
             }
 
+            uint8_t weekday = movement_get_local_calendar()->weekday;
             watch_display_text_with_fallback(
                 WATCH_POSITION_TOP_LEFT,
-                watch_utility_get_long_weekday(date_time), watch_utility_get_weekday(date_time)
+                watch_utility_get_long_weekday_name(weekday), watch_utility_get_weekday_name(weekday)
             );
 
             char day_buf[2 + 1];
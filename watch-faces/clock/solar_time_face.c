@@ -79,12 +79,8 @@ static void _compute_daily(solar_time_state_t *state, uint16_t d) {
 }
 
 /* Recompute if the day-of-year has rolled over. Returns current d. */
-static uint16_t _maybe_recompute(solar_time_state_t *state, watch_date_time_t dt) {
-    uint16_t d = watch_utility_days_since_new_year(
-        (uint16_t)(dt.unit.year + WATCH_RTC_REFERENCE_YEAR),
-        dt.unit.month,
-        dt.unit.day
-    );
+static uint16_t _maybe_recompute(solar_time_state_t *state) {
+    uint16_t d = movement_get_local_calendar()->day_of_year;
     if (d != state->last_calc_d && _load_location().reg != 0) {
         _compute_daily(state, d);
     }
@@ -185,8 +181,7 @@ void solar_time_face_activate(void *context) {
 
     /* Force recompute on activation: timezone or location may have changed */
     state->last_calc_d = 0;
-    watch_date_time_t dt = movement_get_local_date_time();
-    _maybe_recompute(state, dt);
+    _maybe_recompute(state);
 }
 
 bool solar_time_face_loop(movement_event_t event, void *context) {
@@ -196,7 +191,7 @@ bool solar_time_face_loop(movement_event_t event, void *context) {
         case EVENT_ACTIVATE:
         case EVENT_TICK: {
             watch_date_time_t dt = movement_get_local_date_time();
-            _maybe_recompute(state, dt);
+            _maybe_recompute(state);
             _update_display(state, dt);
             break;
         }
@@ -212,7 +207,7 @@ bool solar_time_face_loop(movement_event_t event, void *context) {
         case EVENT_LOW_ENERGY_UPDATE: {
             if (!watch_sleep_animation_is_running()) watch_start_sleep_animation(1000);
             watch_date_time_t dt = movement_get_local_date_time();
-            _maybe_recompute(state, dt);
+            _maybe_recompute(state);
             _update_display(state, dt);
             break;
         }
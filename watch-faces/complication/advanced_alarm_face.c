@@ -334,6 +334,7 @@ bool advanced_alarm_face_loop(movement_event_t event, void *context) {
                     state->alarm[state->alarm_idx].enabled ^= 1;
                     _alarm_set_signal(state);
                     _alarm_show_alarm_on_text(state);
+                    watch_display_commit();
                     delay_ms(275);
                     state->alarm_idx = 0;
                 }
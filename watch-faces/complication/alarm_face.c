@@ -55,13 +55,42 @@ static inline void button_beep() {
     if (movement_button_should_sound()) watch_buzzer_play_note_with_volume(BUZZER_NOTE_C7, 50, movement_button_volume());
 }
 
+// Returns the UTC timestamp at which the alarm goes off next, today or tomorrow.
+static uint32_t _alarm_face_next_alarm_timestamp(alarm_face_state_t *state) {
+    uint32_t now = movement_get_utc_timestamp();
+    int32_t offset = movement_get_current_timezone_offset();
+    uint32_t timestamp = 0;
+
+    for (uint8_t days = 0; days < 2; days++) {
+        watch_date_time_t date_time = watch_utility_date_time_from_unix_time(now + days * 86400, offset);
+        date_time.unit.hour = state->hour;
+        date_time.unit.minute = state->minute;
+        date_time.unit.second = 0;
+        // the offset of the alarm's date, in case a DST transition comes first.
+        timestamp = watch_utility_date_time_to_unix_time(date_time, movement_get_timezone_offset_for_date(date_time));
+        if (timestamp > now) break;
+    }
+
+    return timestamp;
+}
+
+static void _alarm_face_update_advisory(alarm_face_state_t *state) {
+    if (state->alarm_is_on) {
+        // we only need to be asked at the alarm time. The daily advisory at midnight recomputes it, in case the
+        // time or the time zone was changed since.
+        movement_set_advisory_cadence_for_face(state->watch_face_index, MOVEMENT_ADVISE_DAILY);
+        movement_request_advisory_at(state->watch_face_index, _alarm_face_next_alarm_timestamp(state));
+    } else {
+        movement_set_advisory_cadence_for_face(state->watch_face_index, MOVEMENT_ADVISE_NEVER);
+        movement_request_advisory_at(state->watch_face_index, 0);
+    }
+}
+
 //
 // Exported
 //
 
 void alarm_face_setup(uint8_t watch_face_index, void **context_ptr) {
-    (void) watch_face_index;
-
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(alarm_face_state_t));
         alarm_face_state_t *state = (alarm_face_state_t *)*context_ptr;
@@ -70,6 +99,10 @@ void alarm_face_setup(uint8_t watch_face_index, void **context_ptr) {
         // default to an 8:00 AM alarm time.
         state->hour = 8;
     }
+
+    alarm_face_state_t *state = (alarm_face_state_t *)*context_ptr;
+    state->watch_face_index = watch_face_index;
+    _alarm_face_update_advisory(state);
 }
 
 void alarm_face_activate(void *context) {
@@ -119,6 +152,7 @@ bool alarm_face_loop(movement_event_t event, void *context) {
                     // also turn the alarm on since they just set it.
                     state->alarm_is_on = 1;
                     movement_set_alarm_enabled(true);
+                    _alarm_face_update_advisory(state);
                     watch_set_indicator(WATCH_INDICATOR_SIGNAL);
                     _alarm_face_display_alarm_time(state);
                     break;
@@ -135,6 +169,7 @@ bool alarm_face_loop(movement_event_t event, void *context) {
                     watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
                     movement_set_alarm_enabled(false);
                 }
+                _alarm_face_update_advisory(state);
             }
             break;
         case EVENT_ALARM_BUTTON_DOWN:
@@ -192,6 +227,9 @@ movement_watch_face_advisory_t alarm_face_advise(void *context) {
         // for its date. So first we’d have to see if the TOD of wake is after that
         // of now. If it is, take tomorrow’s date, calculating month and year rollover
         // if need be.
+
+        // ask for the next alarm, which is tomorrow's if this was it.
+        _alarm_face_update_advisory(state);
     }
 
     return retval;
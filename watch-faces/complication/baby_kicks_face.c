@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "baby_kicks_face.h"
+#include "shell.h"
 #include "watch.h"
 #include "watch_utility.h"
 
@@ -299,6 +300,43 @@ static inline void _stop_sleep_face() {
     }
 }
 
+static baby_kicks_state_t *_export_state;
+
+/** @brief Shell command that prints the current session as CSV, or as
+  *        the packed fields of `baby_kicks_state_t` with `bin`.
+  */
+static int _export_cmd(int argc, char *argv[]) {
+    baby_kicks_state_t *state = _export_state;
+
+    if (argc > 1 && strcmp(argv[1], "bin") != 0) {
+        return -2;
+    }
+    if (argc > 1) {
+        fwrite(&state->start, sizeof(state->start), 1, stdout);
+        fwrite(&state->latest_stretch_start, sizeof(state->latest_stretch_start), 1, stdout);
+        fwrite(&state->stretch_count, sizeof(state->stretch_count), 1, stdout);
+        fwrite(&state->movement_count, sizeof(state->movement_count), 1, stdout);
+        return 0;
+    }
+    printf("start,latest_stretch_start,stretches,movements\r\n");
+    printf(
+        "%lu,%lu,%u,%u\r\n",
+        (unsigned long)state->start,
+        (unsigned long)state->latest_stretch_start,
+        state->stretch_count,
+        state->movement_count
+    );
+    return 0;
+}
+
+static const shell_command_t _export_command = {
+    .name = "kicks",
+    .help = "usage: kicks [bin] - print the current session",
+    .min_args = 0,
+    .max_args = 1,
+    .cb = _export_cmd,
+};
+
 void baby_kicks_face_setup(uint8_t watch_face_index,
                            void **context_ptr) {
     (void) watch_face_index;
@@ -307,6 +345,8 @@ void baby_kicks_face_setup(uint8_t watch_face_index,
         *context_ptr = malloc(sizeof(baby_kicks_state_t));
         _reset(*context_ptr);
     }
+    _export_state = *context_ptr;
+    shell_register_command(&_export_command);
 }
 
 void baby_kicks_face_activate(void *context) {
@@ -69,6 +69,13 @@ static void _days_since_face_update(days_since_state_t *state) {
     watch_display_text(WATCH_POSITION_BOTTOM, buf);
 }
 
+// The count only changes at midnight, so the face stays tickless while it is displayed.
+static void _days_since_face_wait_for_midnight(void) {
+    const watch_calendar_t *calendar = movement_get_local_calendar();
+    uint32_t seconds_since_midnight = calendar->date_time.unit.hour * 3600 + calendar->date_time.unit.minute * 60 + calendar->date_time.unit.second;
+    movement_set_next_display_change(calendar->timestamp + 86400 - seconds_since_midnight);
+}
+
 static void _days_since_face_abort_quick_cycle(days_since_state_t *state) {
     if (state->quick_cycle) {
         state->quick_cycle = false;
@@ -138,6 +145,7 @@ bool days_since_face_loop(movement_event_t event, void *context) {
     switch (event.event_type) {
         case EVENT_ACTIVATE:
             _days_since_face_update(state);
+            _days_since_face_wait_for_midnight();
             break;
         case EVENT_LOW_ENERGY_UPDATE:
         case EVENT_TICK:
@@ -177,19 +185,24 @@ bool days_since_face_loop(movement_event_t event, void *context) {
                         watch_display_text(WATCH_POSITION_BOTTOM, "      ");
                     }
                     break;
-                // otherwise, check if we have to update. the display only needs to change at midnight!
-                case PAGE_DISPLAY: {
-                    watch_date_time_t date_time = movement_get_local_date_time();
-                    if (date_time.unit.hour == 0 &&  date_time.unit.minute == 0 && date_time.unit.second == 0) {
+                // otherwise, the display only needs to change at midnight! we are tickless until then,
+                // but low energy updates still arrive every minute.
+                case PAGE_DISPLAY:
+                    if (event.event_type == EVENT_TICK) {
                         _days_since_face_update(state);
+                        _days_since_face_wait_for_midnight();
+                    } else {
+                        watch_date_time_t date_time = movement_get_local_date_time();
+                        if (date_time.unit.hour == 0 && date_time.unit.minute == 0) _days_since_face_update(state);
                     }
-                    break;}
+                    break;
                 case PAGE_DATE:
                     if (state->ticks > 0) {
                         state->ticks--;
                     } else {
                         state->current_page = PAGE_DISPLAY;
                         _days_since_face_update(state);
+                        _days_since_face_wait_for_midnight();
                     }
                     break;
                 default:
@@ -220,11 +233,11 @@ bool days_since_face_loop(movement_event_t event, void *context) {
                     state->current_page = (state->current_page + 1) % 4;
                     if (state->current_page == PAGE_DISPLAY) {
                         // ...unless we've been pushed back to display mode.
-                        movement_request_tick_frequency(1);
                         // save the date if it changed
                         persist_date(state);
                         // and force display since it normally won't update til midnight.
                         _days_since_face_update(state);
+                        _days_since_face_wait_for_midnight();
                     }
                     break;
                 default:
@@ -255,6 +268,8 @@ bool days_since_face_loop(movement_event_t event, void *context) {
                     state->current_page = PAGE_DATE;
                     sprintf(buf, "%02d%02d%02d", state->working_year % 100, state->working_month % 100, state->working_day % 100);
                     watch_display_text(WATCH_POSITION_BOTTOM, buf);
+                    // the date is shown for a couple of ticks, so we need them again.
+                    movement_request_tick_frequency(1);
                     state->ticks = 2;
                 }
                     break;
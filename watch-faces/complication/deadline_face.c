@@ -79,6 +79,13 @@ static inline int _days_in_month(int16_t month, int16_t year)
     }
 }
 
+/* Only ask for advisories while the alarm is on */
+static inline void _deadline_update_advisory_cadence(deadline_state_t *state)
+{
+    movement_set_advisory_cadence_for_face(state->face_idx,
+                                           state->alarm_enabled ? MOVEMENT_ADVISE_EVERY_MINUTE : MOVEMENT_ADVISE_NEVER);
+}
+
 /* Play beep sound based on type */
 static inline void _beep(beep_type_t beep_type)
 {
@@ -341,6 +348,7 @@ static bool _deadline_running_loop(movement_event_t event, void *context)
         case EVENT_LIGHT_LONG_PRESS:
             _beep(BEEP_BUTTON);
             state->alarm_enabled = !state->alarm_enabled;
+            _deadline_update_advisory_cadence(state);
             _deadline_running_display(event, state);
             break;
         case EVENT_TIMEOUT:
@@ -504,6 +512,7 @@ void deadline_face_setup(uint8_t watch_face_index, void **context_ptr)
     /* Store face index for background tasks */
     deadline_state_t *state = (deadline_state_t *) * context_ptr;
     state->face_idx = watch_face_index;
+    _deadline_update_advisory_cadence(state);
 }
 
 /* Activate face */
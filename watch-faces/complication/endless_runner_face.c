@@ -432,6 +432,7 @@ static void display_lose_screen(endless_runner_state_t *state) {
     watch_clear_display();
     watch_display_text(WATCH_POSITION_BOTTOM, " LOSE ");
     if (state -> soundOn) {
+        watch_display_commit();
         watch_buzzer_play_sequence(lose_tune, NULL);
         delay_ms(600);
     }
@@ -546,6 +547,7 @@ static void update_game(endless_runner_state_t *state, uint8_t subsecond) {
         break;
     }
     if (game_state.jump_state == NOT_JUMPING && (game_state.loc_2_on || game_state.loc_3_on)) {
+        watch_display_commit();
         delay_ms(200);  // To show the player jumping onto the obstacle before displaying the lose screen.
         display_lose_screen(state);
     }
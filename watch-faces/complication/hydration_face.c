@@ -623,7 +623,8 @@ static bool _settings_loop(movement_event_t event, void *context)
 
 void hydration_face_setup(uint8_t watch_face_index, void **context_ptr)
 {
-    (void) watch_face_index;
+    /* The daily reset and the alerts both happen at the top of an hour */
+    movement_set_advisory_cadence_for_face(watch_face_index, MOVEMENT_ADVISE_HOURLY);
     if (*context_ptr != NULL)
         return; /* Skip setup if context available */
 
@@ -202,20 +202,26 @@ static void _update(moon_phase_state_t *state) {
     }
 }
 
+static uint32_t _next_top_of_hour(void) {
+    uint32_t now = movement_get_utc_timestamp();
+    return now - now % 3600 + 3600;
+}
+
 bool moon_phase_face_loop(movement_event_t event, void *context) {
     moon_phase_state_t *state = (moon_phase_state_t *)context;
-    watch_date_time_t date_time;
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
             if (watch_sleep_animation_is_running()) watch_stop_sleep_animation();
             is_southern_hemisphere(state);
             _update(state);
+            // nothing changes until the top of the hour, so there is no need for a tick every second.
+            movement_set_next_display_change(_next_top_of_hour());
             break;
         case EVENT_TICK:
             // only update once an hour
-            date_time = watch_rtc_get_date_time();
-            if ((date_time.unit.minute == 0) && (date_time.unit.second == 0)) _update(state);
+            _update(state);
+            movement_set_next_display_change(_next_top_of_hour());
             break;
         case EVENT_LOW_ENERGY_UPDATE:
             // update at the top of the hour OR if we're entering sleep mode with an offset.
@@ -448,6 +448,7 @@ static void display_lose_screen(ping_state_t *state) {
     watch_clear_display();
     watch_display_text(WATCH_POSITION_BOTTOM, " LOSE ");
     if (state -> soundOn) {
+        watch_display_commit();
         watch_buzzer_play_sequence(lose_tune, NULL);
         delay_ms(600);
     }
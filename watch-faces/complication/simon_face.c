@@ -116,6 +116,7 @@ static void _simon_display_note(SimonNote note, simon_state_t *state) {
 
 static void _simon_play_note(SimonNote note, simon_state_t *state, bool skip_rest) {
     _simon_display_note(note, state);
+    watch_display_commit();
     switch (note) {
         case SIMON_LED_NOTE:
             if (!state->lightOff) watch_set_led_yellow();
@@ -142,6 +143,7 @@ static void _simon_play_note(SimonNote note, simon_state_t *state, bool skip_res
     if (note != SIMON_WRONG_NOTE) {
         _simon_clear_display(state);
         if (!skip_rest) {
+            watch_display_commit();
             delay_ms((_delay_beep * 2)/3);
         }
     }
@@ -65,6 +65,7 @@ static void set_pixels(int pixels[3][4][2], int j_len) {
             for(int j = 0; j<j_len; j++){
                 watch_set_pixel(pixels[i][j][0], pixels[i][j][1]);
             }
+            watch_display_commit();
             delay_ms(150);
         }
     }
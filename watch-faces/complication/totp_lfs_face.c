@@ -63,6 +63,9 @@ static uint8_t current_secret[MAX_TOTP_SECRET_SIZE];
 static struct totp_record totp_records[MAX_TOTP_RECORDS];
 static uint8_t num_totp_records = 0;
 
+/* Open while the face is active, so that switching records only seeks to the secret. */
+static filesystem_file_t *secrets_file;
+
 static void init_totp_record(struct totp_record *totp_record) {
     totp_record->label[0] = 'A';
     totp_record->label[1] = 'A';
@@ -131,14 +134,18 @@ static void totp_lfs_face_read_file(char *filename) {
     // For 'format' of file, see comment at top.
     const size_t uri_start_len = strlen(TOTP_URI_START);
 
-    if (!filesystem_file_exists(filename)) {
+    filesystem_line_iter_t iter;
+    if (!filesystem_line_iter_open(&iter, filename)) {
         printf("TOTP file error: %s\n", filename);
         return;
     }
 
     char line[256];
-    int32_t offset = 0, old_offset = 0;
-    while (old_offset = offset, filesystem_read_line(filename, line, &offset, 255) && strlen(line)) {
+    while (filesystem_line_iter_next(&iter, line, sizeof(line))) {
+        if (!strlen(line)) {
+            continue;
+        }
+
         if (num_totp_records == MAX_TOTP_RECORDS) {
             printf("TOTP max records: %d\n", MAX_TOTP_RECORDS);
             break;
@@ -168,7 +175,7 @@ static void totp_lfs_face_read_file(char *filename) {
             *param_middle = '\0';
             if (totp_lfs_face_read_param(&totp_records[num_totp_records], param, param_middle + 1)) {
                 if (!strcmp(param, "secret")) {
-                    totp_records[num_totp_records].file_secret_offset = old_offset + (param_middle + 1 - line);
+                    totp_records[num_totp_records].file_secret_offset = iter.line_offset + (param_middle + 1 - line);
                 }
             } else {
                 error = true;
@@ -187,6 +194,8 @@ static void totp_lfs_face_read_file(char *filename) {
             printf("TOTP missing secret: %s\n", line);
         }
     }
+
+    filesystem_line_iter_close(&iter);
 }
 
 void totp_lfs_face_setup(uint8_t watch_face_index, void ** context_ptr) {
@@ -204,18 +213,24 @@ void totp_lfs_face_setup(uint8_t watch_face_index, void ** context_ptr) {
 
 static uint8_t *totp_lfs_face_get_file_secret(struct totp_record *record) {
     char buffer[BASE32_LEN(MAX_TOTP_SECRET_SIZE) + 1];
-    int32_t file_secret_offset = record->file_secret_offset;
 
-    /* TODO filesystem_read_line is quite inefficient. Consider writing a new function,
-     * and keeping the file open?
-     */
-    if (!filesystem_read_line(TOTP_FILE, buffer, &file_secret_offset, record->file_secret_length + 1)) {
+    // the file stays open while the face is active; open it just for this read otherwise.
+    filesystem_file_t *file = secrets_file ? secrets_file : filesystem_open(TOTP_FILE);
+    bool ok = file != NULL
+        && filesystem_seek(file, record->file_secret_offset)
+        && filesystem_read(file, buffer, record->file_secret_length) == record->file_secret_length;
+    if (file != secrets_file) {
+        filesystem_close(file);
+    }
+
+    if (!ok) {
         /* Shouldn't happen at this point. Return current_secret, which is misleading but will not cause a crash. */
-        printf("TOTP can't read expected secret from totp_uris.txt (failed readline)\n");
+        printf("TOTP can't read expected secret from totp_uris.txt\n");
         return current_secret;
     }
+    buffer[record->file_secret_length] = '\0';
     if (base32_decode((unsigned char *)buffer, current_secret) != record->secret_size) {
-        printf("TOTP can't properly decode secret '%s' from totp_uris.txt; failed at offset %d; read to %ld\n", buffer, record->file_secret_offset, file_secret_offset);
+        printf("TOTP can't properly decode secret '%s' from totp_uris.txt at offset %d\n", buffer, record->file_secret_offset);
     }
     return current_secret;
 }
@@ -252,6 +267,10 @@ void totp_lfs_face_activate(void *context) {
     }
 #endif
 
+    if (num_totp_records) {
+        secrets_file = filesystem_open(TOTP_FILE);
+    }
+
     totp_state->timestamp = movement_get_utc_timestamp();
     totp_face_set_record(totp_state, 0);
 }
@@ -319,4 +338,6 @@ bool totp_lfs_face_loop(movement_event_t event, void *context) {
 
 void totp_lfs_face_resign(void *context) {
     (void) context;
+    filesystem_close(secrets_file);
+    secrets_file = NULL;
 }
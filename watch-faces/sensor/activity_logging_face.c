@@ -26,9 +26,61 @@
 #include <string.h>
 #include "activity_logging_face.h"
 #include "filesystem.h"
+#include "shell.h"
 #include "watch.h"
 #include "watch_utility.h"
 
+// The actlog shell command streams the log straight from flash, a few days per pass of the app loop.
+#define ACTIVITY_LOGGING_EXPORT_BATCH (8)
+#define ACTIVITY_LOGGING_EXPORT_LINE (20)
+
+static activity_logging_state_t *export_state;
+static uint32_t export_index;
+static bool export_binary;
+
+static int _activity_logging_face_export(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bin") != 0) return -2;
+    export_binary = argc > 1;
+    export_index = 0;
+    if (!export_binary) printf("timestamp,active_minutes\r\n");
+    return SHELL_CMD_CONTINUE;
+}
+
+static int _activity_logging_face_export_resume(size_t budget) {
+    uint32_t timestamps[ACTIVITY_LOGGING_EXPORT_BATCH];
+    uint16_t active_minutes[ACTIVITY_LOGGING_EXPORT_BATCH];
+    uint32_t count = budget / ACTIVITY_LOGGING_EXPORT_LINE;
+    if (count > ACTIVITY_LOGGING_EXPORT_BATCH) count = ACTIVITY_LOGGING_EXPORT_BATCH;
+
+    count = ring_log_read_records(&export_state->activity_log, export_index, count, timestamps, active_minutes);
+    bool today = count == 0;
+    if (today) {
+        // today's minutes are not in the log yet; they are stamped with the current time.
+        timestamps[0] = movement_get_utc_timestamp();
+        active_minutes[0] = export_state->active_minutes_today;
+        count = 1;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (export_binary) {
+            fwrite(&timestamps[i], sizeof(uint32_t), 1, stdout);
+            fwrite(&active_minutes[i], sizeof(uint16_t), 1, stdout);
+        } else {
+            printf("%lu,%u\r\n", (unsigned long)timestamps[i], active_minutes[i]);
+        }
+    }
+    export_index += count;
+    return today ? 0 : SHELL_CMD_CONTINUE;
+}
+
+static const shell_command_t activity_logging_export_command = {
+    .name = "actlog",
+    .help = "usage: actlog [bin] - print active minutes per day as CSV, or as records of a u32 timestamp and a u16",
+    .min_args = 0,
+    .max_args = 1,
+    .cb = _activity_logging_face_export,
+    .resume = _activity_logging_face_export_resume,
+};
+
 static void _activity_logging_face_update_display(activity_logging_state_t *state) {
     char buf[8];
     watch_date_time_t timestamp = movement_get_local_date_time();
@@ -47,7 +99,10 @@ static void _activity_logging_face_update_display(activity_logging_state_t *stat
     } else {
         // otherwise we need to go into the log.
         watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
-        int32_t pos = ((int16_t)state->data_points - (int32_t)state->display_index) % ACTIVITY_LOGGING_NUM_DAYS;
+        uint32_t data_points = ring_log_count(&state->activity_log);
+        uint16_t active_minutes = 0;
+        bool has_data = state->display_index <= data_points &&
+            ring_log_read(&state->activity_log, data_points - state->display_index, NULL, &active_minutes);
         // get day of month for today - display_index
         uint32_t unixtime = watch_utility_date_time_to_unix_time(timestamp, movement_get_current_timezone_offset());
         unixtime -= 86400 * state->display_index;
@@ -57,12 +112,12 @@ static void _activity_logging_face_update_display(activity_logging_state_t *stat
         snprintf(buf, 8, "%2d", timestamp.unit.day);
         watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
 
-        if (pos < 0) {
+        if (!has_data) {
             // no data at this index
             watch_display_text(WATCH_POSITION_BOTTOM, "no dat");
         } else {
             // we are displaying the number active minutes
-            snprintf(buf, 8, "%4d  ", state->activity_log[pos]);
+            snprintf(buf, 8, "%4d  ", active_minutes);
             watch_display_text(WATCH_POSITION_BOTTOM, buf);
         }
     }
@@ -73,9 +128,14 @@ void activity_logging_face_setup(uint8_t watch_face_index, void ** context_ptr)
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(activity_logging_state_t));
         memset(*context_ptr, 0, sizeof(activity_logging_state_t));
+        activity_logging_state_t *state = (activity_logging_state_t *)*context_ptr;
+        // once full, the log drops 14 days at a time, so two segments of 14 always hold the last 14 days.
+        ring_log_open(&state->activity_log, "actlog", sizeof(uint16_t), ACTIVITY_LOGGING_NUM_DAYS, 2);
         // At first run, tell Movement to run the accelerometer in the background. It will now run at this rate forever.
         movement_set_accelerometer_background_rate(LIS2DW_DATA_RATE_LOWEST);
     }
+    export_state = (activity_logging_state_t *)*context_ptr;
+    shell_register_command(&activity_logging_export_command);
 }
 
 void activity_logging_face_activate(void *context) {
@@ -111,9 +171,7 @@ bool activity_logging_face_loop(movement_event_t event, void *context) {
             break;
         case EVENT_BACKGROUND_TASK:
             {
-                size_t pos = state->data_points % ACTIVITY_LOGGING_NUM_DAYS;
-                state->activity_log[pos] = state->active_minutes_today;
-                state->data_points++;
+                ring_log_append(&state->activity_log, movement_get_utc_timestamp(), &state->active_minutes_today);
                 state->active_minutes_today = 0;
             }
             break;
@@ -30,7 +30,8 @@
  * ACTIVITY LOGGING
  *
  * This watch face works with Movement's built-in tracking of accelerometer state to log activity over time.
- * The watch face shows the number of active minutes counted for each of the last 14 days. Layout:
+ * The watch face shows the number of active minutes counted for each of the last 14 days. The days are kept
+ * in the file system (actlog.0 and actlog.1), so they survive a reset. Layout:
  *
  *  - Top left is display title (ACT or AC for Activity)
  *  - Top right is the day of the month corresponding to the data point shown on screen.
@@ -47,12 +48,12 @@
 
 #include "movement.h"
 #include "watch.h"
+#include "ring_log.h"
 
 #define ACTIVITY_LOGGING_NUM_DAYS (14)
 
 typedef struct {
-    uint16_t activity_log[ACTIVITY_LOGGING_NUM_DAYS];   // the activity log
-    uint16_t data_points;                               // the number of days logged
+    ring_log_t activity_log;                            // the activity log, active minutes per day (uint16_t)
     uint8_t display_index;                              // the index we are displaying on screen
     uint16_t active_minutes_today;                      // the number of active minutes logged today
     bool previous_minute_was_active;                    // we only want to count two or more consecutive active minutes
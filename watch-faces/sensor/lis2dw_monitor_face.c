@@ -526,7 +526,8 @@ static bool _settings_loop(movement_event_t event, void *context)
 
 void lis2dw_monitor_face_setup(uint8_t watch_face_index, void **context_ptr)
 {
-    (void) watch_face_index;
+    /* The advisory never asks for anything */
+    movement_set_advisory_cadence_for_face(watch_face_index, MOVEMENT_ADVISE_NEVER);
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(lis2dw_monitor_state_t));
         memset(*context_ptr, 0, sizeof(lis2dw_monitor_state_t));
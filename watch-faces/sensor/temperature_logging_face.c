@@ -25,28 +25,75 @@
 #include <stdlib.h>
 #include <string.h>
 #include "temperature_logging_face.h"
+#include "shell.h"
 #include "watch.h"
+#include "watch_utility.h"
 
 static bool skip = false;
 
-static void _temperature_logging_face_log_data(temperature_logging_state_t *logger_state) {
-    watch_date_time_t date_time = watch_rtc_get_date_time();
-    size_t pos = logger_state->data_points % TEMPERATURE_LOGGING_NUM_DATA_POINTS;
+// The templog shell command streams the log straight from flash, a few readings per pass of the app loop.
+#define TEMPERATURE_LOGGING_EXPORT_BATCH (8)
+#define TEMPERATURE_LOGGING_EXPORT_LINE (24)
+
+static temperature_logging_state_t *export_state;
+static uint32_t export_index;
+static bool export_binary;
+
+static int _temperature_logging_face_export(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bin") != 0) return -2;
+    export_binary = argc > 1;
+    export_index = 0;
+    if (!export_binary) printf("timestamp,celsius\r\n");
+    return SHELL_CMD_CONTINUE;
+}
 
-    logger_state->data[pos].timestamp.reg = date_time.reg;
-    logger_state->data[pos].temperature_c = movement_get_temperature();
-    logger_state->data_points++;
+static int _temperature_logging_face_export_resume(size_t budget) {
+    uint32_t timestamps[TEMPERATURE_LOGGING_EXPORT_BATCH];
+    float temperatures[TEMPERATURE_LOGGING_EXPORT_BATCH];
+    uint32_t count = budget / TEMPERATURE_LOGGING_EXPORT_LINE;
+    if (count > TEMPERATURE_LOGGING_EXPORT_BATCH) count = TEMPERATURE_LOGGING_EXPORT_BATCH;
+
+    count = ring_log_read_records(&export_state->log, export_index, count, timestamps, temperatures);
+    if (count == 0) return 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (export_binary) {
+            fwrite(&timestamps[i], sizeof(uint32_t), 1, stdout);
+            fwrite(&temperatures[i], sizeof(float), 1, stdout);
+        } else {
+            printf("%lu,%.2f\r\n", (unsigned long)timestamps[i], (double)temperatures[i]);
+        }
+    }
+    export_index += count;
+    return SHELL_CMD_CONTINUE;
+}
+
+static const shell_command_t temperature_logging_export_command = {
+    .name = "templog",
+    .help = "usage: templog [bin] - print the temperature log as CSV, or as records of a u32 timestamp and a float",
+    .min_args = 0,
+    .max_args = 1,
+    .cb = _temperature_logging_face_export,
+    .resume = _temperature_logging_face_export_resume,
+};
+
+static void _temperature_logging_face_log_data(temperature_logging_state_t *logger_state) {
+    float temperature_c = movement_get_temperature();
+    ring_log_append(&logger_state->log, movement_get_utc_timestamp(), &temperature_c);
 }
 
 static void _temperature_logging_face_update_display(temperature_logging_state_t *logger_state, bool in_fahrenheit, bool clock_mode_24h) {
-    int8_t pos = (logger_state->data_points - 1 - logger_state->display_index) % TEMPERATURE_LOGGING_NUM_DATA_POINTS;
+    uint32_t count = ring_log_count(&logger_state->log);
+    uint32_t timestamp = 0;
+    float temperature_c = 0;
+    bool has_data = logger_state->display_index < count &&
+        ring_log_read(&logger_state->log, count - 1 - logger_state->display_index, &timestamp, &temperature_c);
     char buf[7];
 
     watch_clear_indicator(WATCH_INDICATOR_24H);
     watch_clear_indicator(WATCH_INDICATOR_PM);
     watch_clear_colon();
 
-    if (pos < 0) {
+    if (!has_data) {
         // no data at this index
         watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LOG", "TL");
         watch_display_text(WATCH_POSITION_BOTTOM, "no dat");
@@ -54,7 +101,7 @@ static void _temperature_logging_face_update_display(temperature_logging_state_t
         watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
     } else if (logger_state->ts_ticks) {
         // we are displaying the timestamp in response to a button press
-        watch_date_time_t date_time = logger_state->data[pos].timestamp;
+        watch_date_time_t date_time = watch_utility_date_time_from_unix_time(timestamp, movement_get_current_timezone_offset());
         watch_set_colon();
         if (clock_mode_24h) {
             watch_set_indicator(WATCH_INDICATOR_24H);
@@ -74,15 +121,16 @@ static void _temperature_logging_face_update_display(temperature_logging_state_t
         sprintf(buf, "%2d", logger_state->display_index);
         watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
         if (in_fahrenheit) {
-            watch_display_float_with_best_effort(logger_state->data[pos].temperature_c * 1.8 + 32.0, "#F");
+            watch_display_float_with_best_effort(temperature_c * 1.8 + 32.0, "#F");
         } else {
-            watch_display_float_with_best_effort(logger_state->data[pos].temperature_c, "#C");
+            watch_display_float_with_best_effort(temperature_c, "#C");
         }
     }
 }
 
 void temperature_logging_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
+    // we log once an hour, so there is no need to be asked every minute.
+    movement_set_advisory_cadence_for_face(watch_face_index, MOVEMENT_ADVISE_HOURLY);
 
     // if temperature is invalid, we don't have a temperature sensor which means we shouldn't be here.
     if (movement_get_temperature() == 0xFFFFFFFF) skip = true;
@@ -90,6 +138,13 @@ void temperature_logging_face_setup(uint8_t watch_face_index, void ** context_pt
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(temperature_logging_state_t));
         memset(*context_ptr, 0, sizeof(temperature_logging_state_t));
+        temperature_logging_state_t *logger_state = (temperature_logging_state_t *)*context_ptr;
+        ring_log_open(&logger_state->log, "templog", sizeof(float), TEMPERATURE_LOGGING_RECORDS_PER_SEGMENT, TEMPERATURE_LOGGING_NUM_SEGMENTS);
+    }
+
+    if (!skip) {
+        export_state = (temperature_logging_state_t *)*context_ptr;
+        shell_register_command(&temperature_logging_export_command);
     }
 }
 
@@ -148,9 +203,8 @@ movement_watch_face_advisory_t temperature_logging_face_advise(void *context) {
     (void) context;
     movement_watch_face_advisory_t retval = { 0 };
 
-    // this will get called at the top of each minute, so all we check is if we're at the top of the hour as well.
-    // if we are, we ask for a background task.
-    retval.wants_background_task = watch_rtc_get_date_time().unit.minute == 0;
+    // the hourly cadence calls this at the top of the local hour, which is what we check for.
+    retval.wants_background_task = movement_get_local_date_time().unit.minute == 0;
 
     return retval;
 }
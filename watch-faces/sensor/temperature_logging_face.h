@@ -30,8 +30,9 @@
  * THERMISTOR LOGGING (aka Temperature Log)
  *
  * This watch face automatically logs the temperature once an hour, and
- * maintains a 36-hour log of readings. This watch face is admittedly rather
- * complex, and bears some explanation.
+ * maintains a 36-hour log of readings. The log is kept in the file system
+ * (templog.0 to templog.2), so it survives a reset. This watch face is
+ * admittedly rather complex, and bears some explanation.
  *
  * The main display shows the letters “TL” in the top left, indicating the
  * name of the watch face. At the top right, it displays the index of the
@@ -56,19 +57,18 @@
 
 #include "movement.h"
 #include "watch.h"
+#include "ring_log.h"
 
 #define TEMPERATURE_LOGGING_NUM_DATA_POINTS (36)
 
-typedef struct {
-    watch_date_time_t timestamp;
-    float temperature_c;
-} thermistor_logger_data_point_t;
+// the log drops 18 readings at a time once it is full, so three segments always hold the last 36.
+#define TEMPERATURE_LOGGING_RECORDS_PER_SEGMENT (18)
+#define TEMPERATURE_LOGGING_NUM_SEGMENTS (3)
 
 typedef struct {
     uint8_t display_index;  // the index we are displaying on screen
     uint8_t ts_ticks;       // when the user taps the LIGHT button, we show the timestamp for a few ticks.
-    int32_t data_points;    // the absolute number of data points logged
-    thermistor_logger_data_point_t data[TEMPERATURE_LOGGING_NUM_DATA_POINTS];
+    ring_log_t log;         // readings in degrees Celsius (float), stamped with UTC
 } temperature_logging_state_t;
 
 void temperature_logging_face_setup(uint8_t watch_face_index, void ** context_ptr);
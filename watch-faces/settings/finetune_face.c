@@ -100,6 +100,7 @@ static void finetune_adjust_subseconds(int delta) {
     else
         total_adjustment += delta;
     finetune_update_display();
+    watch_display_commit();
 
     // Then delay clock
     watch_rtc_enable(false);
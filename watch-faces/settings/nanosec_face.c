@@ -36,6 +36,7 @@ nanosec_state_t nanosec_state;
 
 #define nanosec_max_screen 7
 int8_t nanosec_screen = 0;
+static int8_t nanosec_face_index = -1;
 bool nanosec_changed = false; // We try to avoid saving settings when no changes were made, for example when just browsing through face
 
 const float voltage_coefficient = 0.241666667 * dithering; // 10 * ppm/V. Nominal frequency is at 3V.
@@ -132,6 +133,12 @@ void nanosec_ui_save(void) {
         nanosec_save();
 }
 
+// Profile 0 is applied once by the hardware, the others are corrected in the background.
+static void nanosec_update_advisory_cadence(void) {
+    if (nanosec_face_index < 0) return;
+    movement_set_advisory_cadence_for_face(nanosec_face_index, nanosec_state.correction_profile != 0 ? MOVEMENT_ADVISE_EVERY_MINUTE : MOVEMENT_ADVISE_NEVER);
+}
+
 // This is low-level save function, that can be used by other faces
 void nanosec_save(void) {
     if (nanosec_state.correction_profile == 0) {
@@ -141,10 +148,11 @@ void nanosec_save(void) {
 
     filesystem_write_file("nanosec.ini", (char*)&nanosec_state, sizeof(nanosec_state));
     nanosec_changed = false;
+    nanosec_update_advisory_cadence();
 }
 
 void nanosec_face_setup(uint8_t watch_face_index, void ** context_ptr) {
-    (void) watch_face_index;
+    nanosec_face_index = watch_face_index;
 
     if (*context_ptr == NULL) {
         if (filesystem_get_file_size("nanosec.ini") != sizeof(nanosec_state)) {
@@ -161,6 +169,8 @@ void nanosec_face_setup(uint8_t watch_face_index, void ** context_ptr) {
 
         *context_ptr = (void *)1; // No need to re-read from filesystem when exiting low power mode
     }
+
+    nanosec_update_advisory_cadence();
 }
 
 void nanosec_face_activate(void *context) {
@@ -26,40 +26,38 @@
 #include "settings_face.h"
 #include "watch.h"
 
-static void clock_setting_display(uint8_t subsecond) {
+// the value being edited blinks on and off at 2 Hz, like it did with a 4 Hz tick. The locations are not on SEG0 and
+// SEG1, so the blink still wakes the CPU four times a second, but only for the SLCD interrupt; the face is not called.
+#define SETTINGS_BLINK_DURATION 250
+
+static void clock_setting_display(void) {
     watch_display_text_with_fallback(WATCH_POSITION_TOP, "CLOCK", "CL");
-    if (subsecond % 2) {
-        if (movement_clock_mode_24h()) watch_display_text(WATCH_POSITION_BOTTOM, "24h");
-        else watch_display_text(WATCH_POSITION_BOTTOM, "12h");
-    } else {
-        watch_display_text(WATCH_POSITION_BOTTOM, "      ");
-    }
+    if (movement_clock_mode_24h()) watch_display_text(WATCH_POSITION_BOTTOM, "24h");
+    else watch_display_text(WATCH_POSITION_BOTTOM, "12h");
+    watch_start_text_blink(WATCH_POSITION_BOTTOM, SETTINGS_BLINK_DURATION);
 }
 
 static void clock_setting_advance(void) {
     movement_set_clock_mode_24h(((movement_clock_mode_24h() + 1) % MOVEMENT_NUM_CLOCK_MODES));
 }
 
-static void beep_setting_display(uint8_t subsecond) {
+static void beep_setting_display(void) {
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "BTN", "BT");
     watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "beep  ", " beep ");
-    if (subsecond % 2) {
-        if (movement_button_should_sound()) {
-            if (movement_button_volume() == WATCH_BUZZER_VOLUME_LOUD) {
-                // H for HIGH
-                watch_display_text(WATCH_POSITION_TOP_RIGHT, " H");
-            }
-            else {
-                // L for LOW
-                watch_display_text(WATCH_POSITION_TOP_RIGHT, " L");
-            }
-        } else {
-            // N for NONE
-            watch_display_text(WATCH_POSITION_TOP_RIGHT, " N");
+    if (movement_button_should_sound()) {
+        if (movement_button_volume() == WATCH_BUZZER_VOLUME_LOUD) {
+            // H for HIGH
+            watch_display_text(WATCH_POSITION_TOP_RIGHT, " H");
+        }
+        else {
+            // L for LOW
+            watch_display_text(WATCH_POSITION_TOP_RIGHT, " L");
         }
     } else {
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
+        // N for NONE
+        watch_display_text(WATCH_POSITION_TOP_RIGHT, " N");
     }
+    watch_start_text_blink(WATCH_POSITION_TOP_RIGHT, SETTINGS_BLINK_DURATION);
 }
 
 static void beep_setting_advance(void) {
@@ -67,35 +65,32 @@ static void beep_setting_advance(void) {
         // was muted. make it soft.
         movement_set_button_should_sound(true);
         movement_set_button_volume(WATCH_BUZZER_VOLUME_SOFT);
-        beep_setting_display(1);
+        beep_setting_display();
         watch_buzzer_play_note_with_volume(BUZZER_NOTE_C7, 50, WATCH_BUZZER_VOLUME_SOFT);
     } else if (movement_button_volume() == WATCH_BUZZER_VOLUME_SOFT) {
         // was soft. make it loud.
         movement_set_button_volume(WATCH_BUZZER_VOLUME_LOUD);
-        beep_setting_display(1);
+        beep_setting_display();
         watch_buzzer_play_note_with_volume(BUZZER_NOTE_C7, 50, WATCH_BUZZER_VOLUME_LOUD);
     } else {
         // was loud. make it silent.
         movement_set_button_should_sound(false);
-        beep_setting_display(1);
+        beep_setting_display();
     }
 }
 
-static void signal_setting_display(uint8_t subsecond) {
+static void signal_setting_display(void) {
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "SIG", "SI");
     watch_display_text(WATCH_POSITION_BOTTOM, "SIGNAL");
-    if (subsecond % 2) {
-        if (movement_signal_volume() == WATCH_BUZZER_VOLUME_LOUD) {
-            // H for HIGH
-            watch_display_text(WATCH_POSITION_TOP_RIGHT, " H");
-        }
-        else {
-            // L for LOW
-            watch_display_text(WATCH_POSITION_TOP_RIGHT, " L");
-        }
-    } else {
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
+    if (movement_signal_volume() == WATCH_BUZZER_VOLUME_LOUD) {
+        // H for HIGH
+        watch_display_text(WATCH_POSITION_TOP_RIGHT, " H");
+    }
+    else {
+        // L for LOW
+        watch_display_text(WATCH_POSITION_TOP_RIGHT, " L");
     }
+    watch_start_text_blink(WATCH_POSITION_TOP_RIGHT, SETTINGS_BLINK_DURATION);
 }
 
 static void signal_setting_advance(void) {
@@ -107,26 +102,23 @@ static void signal_setting_advance(void) {
         movement_set_signal_volume(WATCH_BUZZER_VOLUME_SOFT);
     }
 
-    signal_setting_display(1);
+    signal_setting_display();
     movement_play_signal();
 }
 
 
-static void alarm_setting_display(uint8_t subsecond) {
+static void alarm_setting_display(void) {
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "ALM", "AL");
     watch_display_text(WATCH_POSITION_BOTTOM, "ALARM ");
-    if (subsecond % 2) {
-        if (movement_alarm_volume() == WATCH_BUZZER_VOLUME_LOUD) {
-            // H for HIGH
-            watch_display_text(WATCH_POSITION_TOP_RIGHT, " H");
-        }
-        else {
-            // L for LOW
-            watch_display_text(WATCH_POSITION_TOP_RIGHT, " L");
-        }
-    } else {
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
+    if (movement_alarm_volume() == WATCH_BUZZER_VOLUME_LOUD) {
+        // H for HIGH
+        watch_display_text(WATCH_POSITION_TOP_RIGHT, " H");
+    }
+    else {
+        // L for LOW
+        watch_display_text(WATCH_POSITION_TOP_RIGHT, " L");
     }
+    watch_start_text_blink(WATCH_POSITION_TOP_RIGHT, SETTINGS_BLINK_DURATION);
 }
 
 static void alarm_setting_advance(void) {
@@ -139,90 +131,81 @@ static void alarm_setting_advance(void) {
 
     }
 
-    alarm_setting_display(1);
+    alarm_setting_display();
     movement_play_alarm();
 }
 
-static void timeout_setting_display(uint8_t subsecond) {
+static void timeout_setting_display(void) {
     watch_display_text_with_fallback(WATCH_POSITION_TOP, "TMOUt", "TO");
-    if (subsecond % 2) {
-        switch (movement_get_fast_tick_timeout()) {
-            case 0:
-                watch_display_text(WATCH_POSITION_BOTTOM, "60 SeC");
-                break;
-            case 1:
-                watch_display_text(WATCH_POSITION_BOTTOM, "2 n&in");
-                break;
-            case 2:
-                watch_display_text(WATCH_POSITION_BOTTOM, "5 n&in");
-                break;
-            case 3:
-                watch_display_text(WATCH_POSITION_BOTTOM, "30n&in");
-                break;
-        }
-    } else {
-        watch_display_text(WATCH_POSITION_BOTTOM, "      ");
+    switch (movement_get_fast_tick_timeout()) {
+        case 0:
+            watch_display_text(WATCH_POSITION_BOTTOM, "60 SeC");
+            break;
+        case 1:
+            watch_display_text(WATCH_POSITION_BOTTOM, "2 n&in");
+            break;
+        case 2:
+            watch_display_text(WATCH_POSITION_BOTTOM, "5 n&in");
+            break;
+        case 3:
+            watch_display_text(WATCH_POSITION_BOTTOM, "30n&in");
+            break;
     }
+    watch_start_text_blink(WATCH_POSITION_BOTTOM, SETTINGS_BLINK_DURATION);
 }
 
 static void timeout_setting_advance(void) {
     movement_set_fast_tick_timeout((movement_get_fast_tick_timeout() + 1));
 }
 
-static void low_energy_setting_display(uint8_t subsecond) {
+static void low_energy_setting_display(void) {
     watch_display_text_with_fallback(WATCH_POSITION_TOP, "LoEne", "LE");
-    if (subsecond % 2) {
-        switch (movement_get_low_energy_timeout()) {
-            case 0:
-                watch_display_text(WATCH_POSITION_BOTTOM, " Never");
-                break;
-            case 1:
-                watch_display_text(WATCH_POSITION_BOTTOM, "10n&in");
-                break;
-            case 2:
-                watch_display_text(WATCH_POSITION_BOTTOM, "1 hour");
-                break;
-            case 3:
-                watch_display_text(WATCH_POSITION_BOTTOM, "2 hour");
-                break;
-            case 4:
-                watch_display_text(WATCH_POSITION_BOTTOM, "6 hour");
-                break;
-            case 5:
-                watch_display_text(WATCH_POSITION_BOTTOM, "12 hr");
-                break;
-            case 6:
-                watch_display_text(WATCH_POSITION_BOTTOM, " 1 day");
-                break;
-            case 7:
-                watch_display_text(WATCH_POSITION_BOTTOM, " 7 day");
-                break;
-        }
-    } else {
-        watch_display_text(WATCH_POSITION_BOTTOM, "      ");
+    switch (movement_get_low_energy_timeout()) {
+        case 0:
+            watch_display_text(WATCH_POSITION_BOTTOM, " Never");
+            break;
+        case 1:
+            watch_display_text(WATCH_POSITION_BOTTOM, "10n&in");
+            break;
+        case 2:
+            watch_display_text(WATCH_POSITION_BOTTOM, "1 hour");
+            break;
+        case 3:
+            watch_display_text(WATCH_POSITION_BOTTOM, "2 hour");
+            break;
+        case 4:
+            watch_display_text(WATCH_POSITION_BOTTOM, "6 hour");
+            break;
+        case 5:
+            watch_display_text(WATCH_POSITION_BOTTOM, "12 hr");
+            break;
+        case 6:
+            watch_display_text(WATCH_POSITION_BOTTOM, " 1 day");
+            break;
+        case 7:
+            watch_display_text(WATCH_POSITION_BOTTOM, " 7 day");
+            break;
     }
+    watch_start_text_blink(WATCH_POSITION_BOTTOM, SETTINGS_BLINK_DURATION);
 }
 
 static void low_energy_setting_advance(void) {
     movement_set_low_energy_timeout((movement_get_low_energy_timeout() + 1));
 }
 
-static void led_duration_setting_display(uint8_t subsecond) {
+static void led_duration_setting_display(void) {
     char buf[8];
 
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LED", "LT");
-    if (subsecond % 2) {
-        if (movement_get_backlight_dwell() == 0) {
-            watch_display_text(WATCH_POSITION_BOTTOM, "instnt");
-        } else if (movement_get_backlight_dwell() == 0b111) {
-            watch_display_text(WATCH_POSITION_BOTTOM, "no LEd");
-        } else {
-            sprintf(buf, " %1d SeC", (movement_get_backlight_dwell() * 2 - 1) % 10);
-            watch_display_text(WATCH_POSITION_BOTTOM, buf);
-        }
+    if (movement_get_backlight_dwell() == 0) {
+        watch_display_text(WATCH_POSITION_BOTTOM, "instnt");
+    } else if (movement_get_backlight_dwell() == 0b111) {
+        watch_display_text(WATCH_POSITION_BOTTOM, "no LEd");
     } else {
-        watch_display_text(WATCH_POSITION_BOTTOM, "      ");
+        sprintf(buf, " %1d SeC", (movement_get_backlight_dwell() * 2 - 1) % 10);
+        watch_display_text(WATCH_POSITION_BOTTOM, buf);
     }
+    watch_start_text_blink(WATCH_POSITION_BOTTOM, SETTINGS_BLINK_DURATION);
 }
 
 static void led_duration_setting_advance(void) {
@@ -233,18 +216,15 @@ static void led_duration_setting_advance(void) {
     }
 }
 
-static void red_led_setting_display(uint8_t subsecond) {
+static void red_led_setting_display(void) {
     char buf[8];
     movement_color_t color = movement_backlight_color();
 
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LED", "LT");
     watch_display_text(WATCH_POSITION_BOTTOM, " red  ");
-    if (subsecond % 2) {
-        sprintf(buf, "%2d", color.red);
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
-    } else {
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
-    }
+    sprintf(buf, "%2d", color.red);
+    watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+    watch_start_text_blink(WATCH_POSITION_TOP_RIGHT, SETTINGS_BLINK_DURATION);
 }
 
 static void red_led_setting_advance(void) {
@@ -253,18 +233,15 @@ static void red_led_setting_advance(void) {
     movement_set_backlight_color(color);
 }
 
-static void green_led_setting_display(uint8_t subsecond) {
+static void green_led_setting_display(void) {
     char buf[8];
     movement_color_t color = movement_backlight_color();
 
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LED", "LT");
     watch_display_text(WATCH_POSITION_BOTTOM, " green");
-    if (subsecond % 2) {
-        sprintf(buf, "%2d", color.green);
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
-    } else {
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
-    }
+    sprintf(buf, "%2d", color.green);
+    watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+    watch_start_text_blink(WATCH_POSITION_TOP_RIGHT, SETTINGS_BLINK_DURATION);
 }
 
 static void green_led_setting_advance(void) {
@@ -273,18 +250,15 @@ static void green_led_setting_advance(void) {
     movement_set_backlight_color(color);
 }
 
-static void blue_led_setting_display(uint8_t subsecond) {
+static void blue_led_setting_display(void) {
     char buf[8];
     movement_color_t color = movement_backlight_color();
 
     watch_display_text_with_fallback(WATCH_POSITION_TOP_LEFT, "LED", "LT");
     watch_display_text_with_fallback(WATCH_POSITION_BOTTOM, "blue  ", " blue ");
-    if (subsecond % 2) {
-        sprintf(buf, "%2d", color.blue);
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
-    } else {
-        watch_display_text(WATCH_POSITION_TOP_RIGHT, "  ");
-    }
+    sprintf(buf, "%2d", color.blue);
+    watch_display_text(WATCH_POSITION_TOP_RIGHT, buf);
+    watch_start_text_blink(WATCH_POSITION_TOP_RIGHT, SETTINGS_BLINK_DURATION);
 }
 
 static void blue_led_setting_advance(void) {
@@ -293,8 +267,7 @@ static void blue_led_setting_advance(void) {
     movement_set_backlight_color(color);
 }
 
-static void  git_hash_setting_display(uint8_t subsecond) {
-    (void) subsecond;
+static void  git_hash_setting_display(void) {
     char buf[8];
     // BUILD_GIT_HASH will already be truncated to 6 characters in the makefile, but this is to be safe.
     sprintf(buf, "%.6s", BUILD_GIT_HASH);
@@ -391,7 +364,6 @@ void settings_face_setup(uint8_t watch_face_index, void ** context_ptr) {
 void settings_face_activate(void *context) {
     settings_state_t *state = (settings_state_t *)context;
     state->current_page = 0;
-    movement_request_tick_frequency(4); // we need to manually blink some pixels
 }
 
 bool settings_face_loop(movement_event_t event, void *context) {
@@ -400,11 +372,12 @@ bool settings_face_loop(movement_event_t event, void *context) {
     switch (event.event_type) {
         case EVENT_LIGHT_BUTTON_DOWN:
             state->current_page = (state->current_page + 1) % state->num_settings;
+            // not every page blinks its value.
+            watch_stop_animation();
             watch_clear_display();
             // fall through
-        case EVENT_TICK:
         case EVENT_ACTIVATE:
-            state->settings_screens[state->current_page].display(event.subsecond);
+            state->settings_screens[state->current_page].display();
             break;
         case EVENT_MODE_BUTTON_UP:
             movement_force_led_off();
@@ -412,6 +385,8 @@ bool settings_face_loop(movement_event_t event, void *context) {
             return true;
         case EVENT_ALARM_BUTTON_UP:
             state->settings_screens[state->current_page].advance();
+            // without a fast tick, nothing else redraws the new value.
+            state->settings_screens[state->current_page].display();
             break;
         case EVENT_TIMEOUT:
             movement_move_to_face(0);
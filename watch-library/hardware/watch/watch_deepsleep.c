@@ -163,6 +163,9 @@ static void _watch_disable_all_peripherals_except_slcd(void) {
 }
 
 void watch_enter_sleep_mode(void) {
+    // the display stays on while we sleep, so make sure it shows what was drawn.
+    watch_display_commit();
+
     // disable all other peripherals
     _watch_disable_all_peripherals_except_slcd();
 
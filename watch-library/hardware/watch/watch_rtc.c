@@ -29,6 +29,8 @@
 #include "watch_rtc.h"
 #include "watch_private.h"
 #include "watch_utility.h"
+#include "watch_calendar.h"
+#include "watch_trace.h"
 
 static const uint32_t RTC_OSC_DIV = 10;
 static const uint32_t RTC_OSC_HZ = 1 << RTC_OSC_DIV; // 2^10 = 1024
@@ -90,19 +92,11 @@ void watch_rtc_set_date_time(rtc_date_time_t date_time) {
 }
 
 rtc_date_time_t watch_rtc_get_date_time(void) {
-    static struct {
-        unix_timestamp_t timestamp;
-        rtc_date_time_t datetime;
-    } cached_date_time = {.datetime.reg=0, .timestamp=0};
+    static watch_calendar_t calendar = {0};
 
-    unix_timestamp_t timestamp = watch_rtc_get_unix_time();
+    watch_calendar_update(&calendar, watch_rtc_get_unix_time(), 0);
 
-    if (timestamp != cached_date_time.timestamp) {
-        cached_date_time.timestamp = timestamp;
-        cached_date_time.datetime = watch_utility_date_time_from_unix_time(timestamp, 0);
-    }
-
-    return cached_date_time.datetime;
+    return calendar.date_time;
 }
 
 void watch_rtc_set_unix_time(unix_timestamp_t unix_time) {
@@ -325,6 +319,7 @@ void watch_rtc_callback(uint16_t interrupt_cause) {
                 (curr_counter - comp_callbacks[index].counter) < (RTC_COMP_GRACE_PERIOD * 4)
             ) {
                 comp_callbacks[index].enabled = false;
+                WATCH_TRACE_EVENT(WATCH_TRACE_COMP, curr_counter - comp_callbacks[index].counter);
                 comp_callbacks[index].callback();
             }
         }
@@ -23,11 +23,13 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "delay.h"
 #include "usb.h"
 #include "pins.h"
 #include "watch_slcd.h"
 #include "watch_common_display.h"
+#include "watch_trace.h"
 #include "slcd.h"
 #include "tc.h"
 #include "adc.h"
@@ -40,6 +42,50 @@ static uint16_t _slcd_fc_min_ms_bypass = 0;
 
 static watch_lcd_type_t _installed_display = WATCH_LCD_TYPE_UNKNOWN;
 
+// RAM copy of the SDATAL registers, one word per COM line. Drawing only touches this copy; watch_display_commit
+// writes the COM lines that changed to the peripheral in one go.
+#define SLCD_NUM_COMS (8)
+static uint32_t _slcd_shadow[SLCD_NUM_COMS];
+static uint32_t _slcd_committed[SLCD_NUM_COMS];
+static uint8_t _slcd_dirty_coms;
+
+// Animations are stepped by frame counter 2, whose overflow interrupt wakes the CPU just long enough to write the
+// next frame. Blinks of segments on SEG0 and SEG1 are left to the blink hardware, which needs no CPU at all.
+#define SLCD_ANIMATION_FRAME_COUNTER (2)
+static bool _slcd_animation_in_blink_hardware;
+
+// Sets a frame counter to overflow every duration ms; longer durations use the frame counter's prescaler.
+static void _slcd_configure_frame_counter(uint8_t fc, uint32_t duration) {
+    uint32_t frames = duration / (1000 / _slcd_framerate);
+
+    if (duration <= _slcd_fc_min_ms_bypass) {
+        if (frames == 0) frames = 1;
+        slcd_configure_frame_counter(fc, frames - 1, false);
+    } else {
+        frames /= 8;
+        if (frames > 32) frames = 32;
+        slcd_configure_frame_counter(fc, frames - 1, true);
+    }
+}
+
+// gossamer's slcd.h sets segments one at a time and has no switch for the frame counter overflow interrupts,
+// so the two accessors the shadow and the animations need talk to the peripheral directly. The SDATAL and SDATAH
+// registers of each COM line are interleaved; SEG32 and up are not wired on either display.
+static inline void _slcd_write_com(uint8_t com, uint32_t value) {
+    (&SLCD->SDATAL0.reg)[com * 2] = value;
+}
+
+static void _slcd_set_animation_interrupt_enabled(bool enabled) {
+    if (enabled) {
+        SLCD->INTFLAG.reg = SLCD_INTFLAG_FC2O;
+        SLCD->INTENSET.reg = SLCD_INTENSET_FC2O;
+        NVIC_ClearPendingIRQ(SLCD_IRQn);
+        NVIC_EnableIRQ(SLCD_IRQn);
+    } else {
+        SLCD->INTENCLR.reg = SLCD_INTENCLR_FC2O;
+    }
+}
+
 /// NOTE: The function below was commented out because LCD autodetection proved unreliable.
 /// While I would love to fix it, I can't figure it out in time for the product launch.
 /// Instead, this function simply implements the failsafe: red LED glows until one of two
@@ -49,9 +95,11 @@ void watch_discover_lcd_type(void) {
     #if defined(FORCE_CUSTOM_LCD_TYPE)
     _installed_display = WATCH_LCD_TYPE_CUSTOM;
     _watch_update_indicator_segments();
+    _watch_update_glyph_table();
     return;
     #elif defined(FORCE_CLASSIC_LCD_TYPE)
     _installed_display = WATCH_LCD_TYPE_CLASSIC;
+    _watch_update_glyph_table();
     return;
     #endif
 
@@ -88,8 +136,9 @@ void watch_discover_lcd_type(void) {
     watch_set_led_off();
     watch_disable_leds();
 
-    // Update indicator segment mapping based on the detected display (they are v different).
+    // Update indicator segment mapping and glyph table based on the detected display (they are v different).
     _watch_update_indicator_segments();
+    _watch_update_glyph_table();
 }
 
 /*
@@ -250,6 +299,9 @@ void watch_enable_display(void) {
     _slcd_fc_min_ms_bypass = 32 * (1000 / _slcd_framerate);
 
     slcd_clear();
+    memset(_slcd_shadow, 0, sizeof(_slcd_shadow));
+    memset(_slcd_committed, 0, sizeof(_slcd_committed));
+    _slcd_dirty_coms = 0;
 
     if (_installed_display == WATCH_LCD_TYPE_CUSTOM) {
         slcd_set_contrast(0);
@@ -265,29 +317,116 @@ void watch_disable_display(void) {
 }
 
 inline void watch_set_pixel(uint8_t com, uint8_t seg) {
-    slcd_set_segment(com, seg);
+    if (com >= SLCD_NUM_COMS || seg >= 32) return;
+    _slcd_shadow[com] |= 1u << seg;
+    _slcd_dirty_coms |= 1u << com;
 }
 
 inline void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    slcd_clear_segment(com, seg);
+    if (com >= SLCD_NUM_COMS || seg >= 32) return;
+    _slcd_shadow[com] &= ~(1u << seg);
+    _slcd_dirty_coms |= 1u << com;
+}
+
+void watch_update_pixels(uint8_t com, uint32_t mask, uint32_t value) {
+    if (com >= SLCD_NUM_COMS) return;
+    _slcd_shadow[com] = (_slcd_shadow[com] & ~mask) | value;
+    _slcd_dirty_coms |= 1u << com;
 }
 
 void watch_clear_display(void) {
-    slcd_clear();
+    memset(_slcd_shadow, 0, sizeof(_slcd_shadow));
+    _slcd_dirty_coms = 0xFF;
 }
 
-void watch_start_character_blink(char character, uint32_t duration) {
-    slcd_set_frame_counter_enabled(0, false);
+void watch_display_commit(void) {
+    uint16_t changed_coms = 0;
+
+    while (_slcd_dirty_coms) {
+        uint8_t com = __builtin_ctz(_slcd_dirty_coms);
+        _slcd_dirty_coms &= _slcd_dirty_coms - 1;
+
+        // the animation interrupt writes these registers too.
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint32_t value = _watch_animation_merge(com, _slcd_shadow[com]);
+        if (value != _slcd_committed[com]) {
+            _slcd_write_com(com, value);
+            _slcd_committed[com] = value;
+            changed_coms |= 1 << com;
+        }
+        __set_PRIMASK(primask);
+    }
 
-    if (duration <= _slcd_fc_min_ms_bypass) {
-        slcd_configure_frame_counter(0, (duration / (1000 / _slcd_framerate)) - 1, false);
+    if (changed_coms) WATCH_TRACE_EVENT(WATCH_TRACE_DISPLAY_COMMIT, changed_coms);
+}
+
+void _watch_slcd_start_animation(uint32_t duration) {
+    bool blink_in_hardware = _watch_animation.type == WATCH_ANIMATION_BLINK;
+    uint8_t bss0 = 0;
+    uint8_t bss1 = 0;
+
+    for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) {
+        if (_watch_animation.owned[com] & ~0b11) blink_in_hardware = false;
+        bss0 |= (_watch_animation.owned[com] & 1) << com;
+        bss1 |= ((_watch_animation.owned[com] >> 1) & 1) << com;
+    }
+
+    slcd_set_frame_counter_enabled(SLCD_ANIMATION_FRAME_COUNTER, false);
+    _slcd_configure_frame_counter(SLCD_ANIMATION_FRAME_COUNTER, duration);
+
+    if (blink_in_hardware) {
+        slcd_disable();
+        slcd_set_blink_enabled(false);
+        slcd_configure_blink(false, bss0, bss1, SLCD_ANIMATION_FRAME_COUNTER);
+        slcd_set_blink_enabled(true);
+        slcd_enable();
     } else {
-        slcd_configure_frame_counter(0, ((duration / (1000 / _slcd_framerate)) / 8 - 1), true);
+        _slcd_set_animation_interrupt_enabled(true);
+    }
+    _slcd_animation_in_blink_hardware = blink_in_hardware;
+    slcd_set_frame_counter_enabled(SLCD_ANIMATION_FRAME_COUNTER, true);
+
+    // the first frame goes out with the next commit.
+    _slcd_dirty_coms |= (1u << GLYPH_NUM_COMS) - 1;
+}
+
+void _watch_slcd_stop_animation(void) {
+    slcd_set_frame_counter_enabled(SLCD_ANIMATION_FRAME_COUNTER, false);
+    _slcd_set_animation_interrupt_enabled(false);
+    if (_slcd_animation_in_blink_hardware) slcd_set_blink_enabled(false);
+    _slcd_animation_in_blink_hardware = false;
+
+    _slcd_dirty_coms |= (1u << GLYPH_NUM_COMS) - 1;
+}
+
+void irq_handler_slcd(void);
+void irq_handler_slcd(void) {
+    SLCD->INTFLAG.reg = SLCD_INTFLAG_FC2O;
+    _watch_animation_step();
+
+    // only the animated segments change; the rest of the line keeps what was last committed.
+    for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) {
+        uint32_t owned = _watch_animation.owned[com];
+        if (!owned) continue;
+
+        uint32_t value = (_slcd_committed[com] & ~owned) | (_watch_animation_merge(com, _slcd_shadow[com]) & owned);
+        if (value != _slcd_committed[com]) {
+            _slcd_write_com(com, value);
+            _slcd_committed[com] = value;
+        }
     }
+}
+
+void watch_start_character_blink(char character, uint32_t duration) {
+    slcd_set_frame_counter_enabled(0, false);
+
+    _slcd_configure_frame_counter(0, duration);
     slcd_set_frame_counter_enabled(0, true);
 
     watch_display_character(character, 7);
     watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+    watch_display_commit();
 
     slcd_disable();
     slcd_set_blink_enabled(false);
@@ -317,12 +456,9 @@ void watch_start_indicator_blink_if_possible(watch_indicator_t indicator, uint32
             return;
         }
         watch_set_indicator(indicator);
+        watch_display_commit();
 
-        if (duration <= _slcd_fc_min_ms_bypass) {
-            slcd_configure_frame_counter(0, (duration / (1000 / _slcd_framerate)) - 1, false);
-        } else {
-            slcd_configure_frame_counter(0, ((duration / (1000 / _slcd_framerate)) / 8 - 1), true);
-        }
+        _slcd_configure_frame_counter(0, duration);
         slcd_set_frame_counter_enabled(0, true);
 
 
@@ -347,16 +483,13 @@ void watch_start_sleep_animation(uint32_t duration) {
         // on classic LCD we do the "tick/tock" animation
         watch_display_character(' ', 8);
         watch_display_character(' ', 9);
+        watch_display_commit();
 
         slcd_disable();
         slcd_set_frame_counter_enabled(1, false);
         slcd_set_circular_shift_animation_enabled(false);
 
-        if (duration <= _slcd_fc_min_ms_bypass) {
-            slcd_configure_frame_counter(1, (duration / (1000 / _slcd_framerate)) - 1, false);
-        } else {
-            slcd_configure_frame_counter(1, ((duration / (1000 / _slcd_framerate)) / 8 - 1), true);
-        }
+        _slcd_configure_frame_counter(1, duration);
         slcd_set_frame_counter_enabled(1, true);
 
         slcd_configure_circular_shift_animation(0b00000001, 1, SLCD_CSRSHIFT_LEFT, 1);
@@ -369,7 +502,7 @@ bool watch_sleep_animation_is_running(void) {
     // TODO: wrap this in gossamer call
     if (_installed_display == WATCH_LCD_TYPE_CUSTOM) {
         // COM3, SEG0 contains the half moon icon
-        return SLCD->SDATAL3.bit.SDATA & 1;
+        return _slcd_shadow[3] & 1;
     } else {
         // CSREN indicates that the tick/tick animation is running
         return SLCD->CTRLD.bit.CSREN;
@@ -24,9 +24,15 @@
  */
 
 #include <stddef.h>
+#include <string.h>
 #include "watch_usb_cdc.h"
+#include "watch.h"
 #include "tusb.h"
 
+#ifndef min
+#define min(x, y) ((x) > (y) ? (y) : (x))
+#endif
+
 /*
  * Implement a circular buffer for the USB CDC Serial read buffer.
  * The size of the buffer must be a power of two for this circular buffer
@@ -42,12 +48,27 @@ static char s_write_buf[CDC_WRITE_BUF_SZ] = {0};
 static size_t s_write_buf_pos = 0;
 static size_t s_write_buf_len = 0;
 
+// How long a write waits for the host to make room in the buffer before it drops what does not fit.
+#define CDC_WRITE_TIMEOUT_MS  (100)
+static bool s_write_pumping = false;
+static cdc_stats_t s_stats = {0};
+
 #define CDC_READ_BUF_SZ  (256)
 #define CDC_READ_BUF_IDX(x)  ((x) & (CDC_READ_BUF_SZ - 1))
 static char s_read_buf[CDC_READ_BUF_SZ] = {0};
 static size_t s_read_buf_pos = 0;
 static size_t s_read_buf_len = 0;
 
+static void prv_handle_writes(void);
+
+// Runs the USB stack from within a write, so that the host can drain the buffer.
+static void prv_pump(void) {
+    s_write_pumping = true;
+    tud_task();
+    prv_handle_writes();
+    s_write_pumping = false;
+}
+
 int _write(int file, char *ptr, int len) {
     (void) file;
 
@@ -56,17 +77,40 @@ int _write(int file, char *ptr, int len) {
     }
 
     int bytes_written = 0;
-
-    for (int i = 0; i < len; i++) {
-        s_write_buf[s_write_buf_pos] = ptr[i];
-        s_write_buf_pos = CDC_WRITE_BUF_IDX(s_write_buf_pos + 1);
-        if (s_write_buf_len < CDC_WRITE_BUF_SZ) {
-            s_write_buf_len++;
+    rtc_counter_t deadline = 0;
+    bool waiting = false;
+
+    while (bytes_written < len) {
+        const size_t room = CDC_WRITE_BUF_SZ - s_write_buf_len;
+        if (room == 0) {
+            // Back-pressure: while a terminal is listening, wait for the host to read. Without one,
+            // or if it stops reading, drop what does not fit rather than overwrite what is queued.
+            if (!waiting) {
+                deadline = watch_rtc_get_counter() + (watch_rtc_get_frequency() * CDC_WRITE_TIMEOUT_MS) / 1000;
+                waiting = true;
+                s_stats.waits++;
+            }
+            if (s_write_pumping || !tud_cdc_connected() || (int32_t)(watch_rtc_get_counter() - deadline) > 0) {
+                s_stats.dropped += len - bytes_written;
+                break;
+            }
+            prv_pump();
+            continue;
         }
-        bytes_written++;
+        waiting = false;
+
+        // Copy the longest contiguous span up to the end of the buffer.
+        const size_t span = min(min(room, CDC_WRITE_BUF_SZ - s_write_buf_pos), (size_t)(len - bytes_written));
+        memcpy(&s_write_buf[s_write_buf_pos], ptr + bytes_written, span);
+        s_write_buf_pos = CDC_WRITE_BUF_IDX(s_write_buf_pos + span);
+        s_write_buf_len += span;
+        bytes_written += span;
     }
 
-    return bytes_written;
+    s_stats.written += len;
+
+    // Dropped bytes count as written, or newlib would keep retrying them.
+    return len;
 }
 
 int _read(int file, char *ptr, int len) {
@@ -97,42 +141,70 @@ int _read(int file, char *ptr, int len) {
 }
 
 static void prv_handle_reads(void) {
-    while (tud_cdc_available()) {
-        int c = tud_cdc_read_char();
-        if (c < 0) {
-            continue;
-        }
-        s_read_buf[s_read_buf_pos] = c;
-        s_read_buf_pos = CDC_READ_BUF_IDX(s_read_buf_pos + 1);
-        if (s_read_buf_len < CDC_READ_BUF_SZ) {
-            s_read_buf_len++;
+    // Take no more than the buffer holds; the rest waits in the TinyUSB FIFO, which in
+    // turn holds off the host, so that binary transfers do not lose bytes.
+    while (s_read_buf_len < CDC_READ_BUF_SZ && tud_cdc_available()) {
+        const size_t span = min(CDC_READ_BUF_SZ - s_read_buf_len, CDC_READ_BUF_SZ - s_read_buf_pos);
+        const uint32_t received = tud_cdc_read(&s_read_buf[s_read_buf_pos], span);
+        if (received == 0) {
+            break;
         }
+        s_read_buf_pos = CDC_READ_BUF_IDX(s_read_buf_pos + received);
+        s_read_buf_len += received;
     }
 }
 
 static void prv_handle_writes(void) {
-    if (s_write_buf_len > 0) {
-        const size_t start_pos =
-            CDC_WRITE_BUF_IDX(s_write_buf_pos - s_write_buf_len);
-        for (size_t i = 0; i < (size_t) s_write_buf_len; i++) {
-            const size_t idx = CDC_WRITE_BUF_IDX(start_pos + i);
-            if (tud_cdc_available() > 0) {
-                // If we receive data while doing a large write, we need to
-                // fully service it before continuing to write, or the
-                // stack will crash.
-                prv_handle_reads();
-            }
-            if (tud_cdc_write_available()) {
-                tud_cdc_write(&s_write_buf[idx], 1);
-            }
-            s_write_buf[idx] = 0;
-            s_write_buf_len--;
+    while (s_write_buf_len > 0) {
+        if (tud_cdc_available() > 0) {
+            // If we receive data while doing a large write, we need to
+            // fully service it before continuing to write, or the
+            // stack will crash.
+            prv_handle_reads();
+        }
+
+        // Hand the oldest contiguous span to the TinyUSB FIFO, as much as it takes. What
+        // does not fit stays queued for the next call.
+        const size_t start_pos = CDC_WRITE_BUF_IDX(s_write_buf_pos - s_write_buf_len);
+        const size_t span = min(min(s_write_buf_len, CDC_WRITE_BUF_SZ - start_pos), (size_t)tud_cdc_write_available());
+        if (span == 0) {
+            break;
         }
-        tud_cdc_write_flush();
+        const uint32_t sent = tud_cdc_write(&s_write_buf[start_pos], span);
+        if (sent == 0) {
+            break;
+        }
+        s_write_buf_len -= sent;
+        s_stats.sent += sent;
     }
+    tud_cdc_write_flush();
 }
 
 void cdc_task(void) {
     prv_handle_reads();
     prv_handle_writes();
 }
+
+void cdc_flush(void) {
+    rtc_counter_t deadline = watch_rtc_get_counter() + (watch_rtc_get_frequency() * CDC_WRITE_TIMEOUT_MS) / 1000;
+    size_t queued = s_write_buf_len;
+
+    while (s_write_buf_len > 0 && !s_write_pumping && tud_cdc_connected()) {
+        prv_pump();
+        if (s_write_buf_len < queued) {
+            // the host is reading, so give it another timeout.
+            queued = s_write_buf_len;
+            deadline = watch_rtc_get_counter() + (watch_rtc_get_frequency() * CDC_WRITE_TIMEOUT_MS) / 1000;
+        } else if ((int32_t)(watch_rtc_get_counter() - deadline) > 0) {
+            break;
+        }
+    }
+}
+
+size_t cdc_write_space(void) {
+    return CDC_WRITE_BUF_SZ - s_write_buf_len;
+}
+
+cdc_stats_t cdc_get_stats(void) {
+    return s_stats;
+}
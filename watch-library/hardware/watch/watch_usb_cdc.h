@@ -25,6 +25,25 @@
 
 #pragma once
 
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t written;   // bytes passed to _write, dropped ones included
+    uint32_t sent;      // bytes handed to the USB stack
+    uint32_t dropped;   // bytes that did not fit while the host was not reading
+    uint32_t waits;     // writes that had to wait for the host to make room
+} cdc_stats_t;
+
 int _write(int file, char *ptr, int len);
 int _read(int file, char *ptr, int len);
 void cdc_task(void);
+
+// Waits until everything written so far is handed to the USB stack, or the host stops reading.
+void cdc_flush(void);
+
+// Bytes that can be written right now without waiting for the host.
+size_t cdc_write_space(void);
+
+// Counters since boot.
+cdc_stats_t cdc_get_stats(void);
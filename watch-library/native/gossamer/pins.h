@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+/*
+ * Host replacement for gossamer's board pin definitions. The native build has
+ * no port registers, so every HAL_GPIO_* accessor reads and writes a shadow
+ * level table instead. The button levels in this table are what the native
+ * external interrupt controller drives when a scripted button event fires.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HAL_GPIO_PORTA 0
+#define HAL_GPIO_PORTB 1
+
+#define HAL_GPIO_PMUX_A             0
+#define HAL_GPIO_PMUX_B             1
+#define HAL_GPIO_PMUX_C             2
+#define HAL_GPIO_PMUX_D             3
+#define HAL_GPIO_PMUX_E             4
+#define HAL_GPIO_PMUX_F             5
+#define HAL_GPIO_PMUX_G             6
+#define HAL_GPIO_PMUX_H             7
+#define HAL_GPIO_PMUX_EIC           HAL_GPIO_PMUX_A
+#define HAL_GPIO_PMUX_ADC           HAL_GPIO_PMUX_B
+#define HAL_GPIO_PMUX_SLCD          HAL_GPIO_PMUX_B
+#define HAL_GPIO_PMUX_SERCOM        HAL_GPIO_PMUX_C
+#define HAL_GPIO_PMUX_SERCOM_ALT    HAL_GPIO_PMUX_D
+#define HAL_GPIO_PMUX_TC            HAL_GPIO_PMUX_E
+#define HAL_GPIO_PMUX_TCC           HAL_GPIO_PMUX_E
+#define HAL_GPIO_PMUX_TCC_ALT       HAL_GPIO_PMUX_F
+#define HAL_GPIO_PMUX_RTC           HAL_GPIO_PMUX_G
+#define HAL_GPIO_PMUX_USB           HAL_GPIO_PMUX_G
+
+#define GPIO_PORTA HAL_GPIO_PORTA
+#define GPIO_PORTB HAL_GPIO_PORTB
+#define GPIO(port, pin) ((((port) & 0x7u) << 5) + ((pin) & 0x1Fu))
+
+extern volatile bool _hal_gpio_levels[64];
+
+#define HAL_GPIO_PIN(name, port, pin) \
+    static inline uint8_t HAL_GPIO_##name##_pin(void) { return (HAL_GPIO_PORT##port << 5) | (pin); } \
+    static inline void HAL_GPIO_##name##_set(void) { _hal_gpio_levels[HAL_GPIO_##name##_pin()] = true; } \
+    static inline void HAL_GPIO_##name##_clr(void) { _hal_gpio_levels[HAL_GPIO_##name##_pin()] = false; } \
+    static inline void HAL_GPIO_##name##_toggle(void) { _hal_gpio_levels[HAL_GPIO_##name##_pin()] = !_hal_gpio_levels[HAL_GPIO_##name##_pin()]; } \
+    static inline void HAL_GPIO_##name##_write(int value) { _hal_gpio_levels[HAL_GPIO_##name##_pin()] = value != 0; } \
+    static inline int HAL_GPIO_##name##_read(void) { return _hal_gpio_levels[HAL_GPIO_##name##_pin()]; } \
+    static inline int HAL_GPIO_##name##_state(void) { return _hal_gpio_levels[HAL_GPIO_##name##_pin()]; } \
+    static inline void HAL_GPIO_##name##_in(void) {} \
+    static inline void HAL_GPIO_##name##_out(void) {} \
+    static inline void HAL_GPIO_##name##_off(void) {} \
+    static inline void HAL_GPIO_##name##_pullup(void) {} \
+    static inline void HAL_GPIO_##name##_pulldown(void) {} \
+    static inline void HAL_GPIO_##name##_drvstr(int enable) { (void) enable; } \
+    static inline void HAL_GPIO_##name##_pmuxen(int mux) { (void) mux; } \
+    static inline void HAL_GPIO_##name##_pmuxdis(void) {}
+
+// The pins referenced outside of the hardware HAL. Pin numbers follow the
+// Sensor Watch boards so that code comparing pin numbers behaves the same way.
+HAL_GPIO_PIN(BTN_ALARM,     A, 2)
+HAL_GPIO_PIN(BTN_LIGHT,     A, 22)
+HAL_GPIO_PIN(BTN_MODE,      A, 23)
+HAL_GPIO_PIN(VBUS_DET,      A, 7)
+HAL_GPIO_PIN(A0,            B, 4)
+HAL_GPIO_PIN(A1,            B, 1)
+HAL_GPIO_PIN(A2,            B, 2)
+HAL_GPIO_PIN(A3,            B, 3)
+HAL_GPIO_PIN(A4,            B, 0)
+HAL_GPIO_PIN(TS_ENABLE,     B, 23)
+HAL_GPIO_PIN(TEMPSENSE,     B, 22)
@@ -0,0 +1,35 @@
+# Host (native) build of Movement, in place of gossamer's make.mk.
+# The watch library is replaced by the virtual-clock HAL in watch-library/native/watch,
+# and the few gossamer headers that shared code includes are shimmed in
+# watch-library/native/gossamer. Build with:
+#
+#   make NATIVE=1 DISPLAY=classic
+#
+# and run ./build-native/movement --help for the command line options.
+
+BUILD = ./build-native
+BIN = movement
+
+CFLAGS += -std=gnu17 -g -O2
+CFLAGS += -Wall -Wextra -Wno-unused-parameter -Wno-missing-field-initializers
+# newlib's int32_t is a long, so the firmware's %ld / %lu format strings only match on the watch.
+CFLAGS += -Wno-format
+LDFLAGS +=
+LIBS += -lm
+
+DEFINES += -DWATCH_NATIVE
+DEFINES += -DBUILD_GIT_HASH=\"$(shell git rev-parse --short=6 HEAD 2>/dev/null || echo native)\"
+
+# The shims must come first so that they shadow any gossamer header of the same name.
+INCLUDES += \
+  -I./watch-library/native/gossamer \
+
+SRCS +=
+
+# Sources that poke at SAM L22 registers or provide newlib system calls have no host equivalent.
+NATIVE_EXCLUDED_SRCS += \
+  ./dummy.c \
+  ./watch-faces/demo/light_sensor_face.c \
+  ./watch-faces/demo/peek_memory_face.c \
+  ./watch-faces/demo/rtccount_face.c \
+  ./watch-faces/io/irda_upload_face.c \
@@ -0,0 +1,22 @@
+# Host (native) build rules, in place of gossamer's rules.mk.
+
+SRCS := $(filter-out $(NATIVE_EXCLUDED_SRCS),$(SRCS))
+OBJS = $(addprefix $(BUILD)/,$(patsubst ./%,%,$(SRCS:.c=.o)))
+
+all: $(BUILD)/$(BIN)
+
+$(BUILD)/$(BIN): $(OBJS)
+	@echo LD $@
+	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@
+
+$(BUILD)/%.o: %.c
+	@echo CC $<
+	@mkdir -p $(@D)
+	@$(CC) $(CFLAGS) $(DEFINES) $(INCLUDES) -MMD -MP -c $< -o $@
+
+clean:
+	rm -rf $(BUILD)
+
+.PHONY: all clean
+
+-include $(OBJS:.o=.d)
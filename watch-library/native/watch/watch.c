@@ -0,0 +1,10 @@
+#include "watch.h"
+#include "usb.h"
+
+bool watch_is_usb_enabled(void) {
+    return usb_is_enabled();
+}
+
+void watch_reset_to_bootloader(void) {
+    // No bootloader in the native build; nothing to do here
+}
@@ -0,0 +1,482 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+
+#include "watch.h"
+#include "watch_native.h"
+#include "app.h"
+#include "delay.h"
+
+/*
+ * Native (host) entry point for Movement.
+ *
+ * Usage: movement [options]
+ *   -d, --duration TIME   simulated time to run, e.g. 90s, 15m, 12h, 7d (default 60s)
+ *   -s, --start DATETIME  local start time as "YYYY-MM-DD HH:MM:SS" (default: host clock)
+ *   -x, --speed FACTOR    pace the virtual clock at FACTOR times real time; 0 runs
+ *                         as fast as possible (default 0, or 1 with --shell)
+ *   -i, --script FILE     scripted button input, see below
+ *   -f, --storage FILE    back the 8 KB filesystem area with FILE
+ *   -r, --record FILE     record every committed display frame into FILE, see
+ *                         utils/lcd_trace/lcd_trace.py
+ *   -c, --shell           attach the serial shell to stdin/stdout
+ *   -q, --quiet           do not print display updates
+ *
+ * A script has one event per line: "<time> <button> <action> [hold]". Time is
+ * absolute from the start of the run, or relative to the previous event when
+ * prefixed with '+'. Button is mode, light or alarm. Action is down, up, press
+ * (held for 0.1 s) or long (held for 1 s); press takes an optional hold time.
+ * Lines starting with '#' are ignored. Example:
+ *
+ *   # enter the settings face and leave again
+ *   5s mode press
+ *   +1s mode long
+ *   +2m alarm press 0.5s
+ *
+ * Every time the core goes to sleep and the display differs from the last
+ * printed frame, the display is decoded and printed with the simulated time.
+ */
+
+#define NATIVE_TICKS_PER_SECOND 128
+#define NATIVE_NUM_TIMERS 4
+
+typedef struct {
+    watch_cb_t callback;
+    uint32_t period;
+    uint64_t next;
+    bool wakes;
+} native_timer_t;
+
+typedef struct {
+    uint64_t ticks;
+    uint8_t pin;
+    bool level;
+} native_input_event_t;
+
+static native_timer_t timers[NATIVE_NUM_TIMERS];
+
+static native_input_event_t *input_events;
+static size_t input_events_count;
+static size_t input_events_next;
+
+static volatile bool interrupt_fired;
+static uint64_t elapsed_ticks;
+static uint64_t end_ticks = 60 * NATIVE_TICKS_PER_SECOND;
+static uint64_t delay_remainder;
+
+static time_t start_time;
+static double speed = -1;
+static bool console_enabled;
+static bool quiet;
+static struct timespec host_start;
+
+static struct {
+    uint64_t loops;
+    uint64_t sleeps;
+    uint64_t interrupts;
+    uint64_t display_updates;
+} stats;
+
+static double _host_seconds_since_start(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - host_start.tv_sec) + (double)(now.tv_nsec - host_start.tv_nsec) / 1e9;
+}
+
+static void _watch_native_finish(void) {
+    _watch_storage_save();
+    _watch_slcd_trace_close();
+
+    if (quiet) return;
+    fflush(stdout);
+    double host_seconds = _host_seconds_since_start();
+    double sim_seconds = (double)elapsed_ticks / NATIVE_TICKS_PER_SECOND;
+    fprintf(stderr, "simulated %.3f s in %.3f s host time (%.0fx), %llu loops, %llu sleeps, %llu interrupts, %llu display updates\n",
+            sim_seconds, host_seconds, host_seconds > 0 ? sim_seconds / host_seconds : 0,
+            (unsigned long long)stats.loops, (unsigned long long)stats.sleeps,
+            (unsigned long long)stats.interrupts, (unsigned long long)stats.display_updates);
+}
+
+static void _watch_native_print_display(void) {
+    if (quiet || !_watch_slcd_frame_changed()) return;
+
+    char description[96];
+    _watch_slcd_describe(description, sizeof(description));
+    stats.display_updates++;
+
+    uint64_t millis = elapsed_ticks * 1000 / NATIVE_TICKS_PER_SECOND;
+    printf("%7llu.%03u %s\n", (unsigned long long)(millis / 1000), (unsigned)(millis % 1000), description);
+}
+
+static void _watch_native_pace(void) {
+    if (speed <= 0) return;
+
+    double target = (double)elapsed_ticks / NATIVE_TICKS_PER_SECOND / speed;
+    double ahead = target - _host_seconds_since_start();
+    if (ahead > 0) {
+        struct timespec ts = { .tv_sec = (time_t)ahead, .tv_nsec = (long)((ahead - (time_t)ahead) * 1e9) };
+        nanosleep(&ts, NULL);
+    }
+}
+
+void _watch_native_interrupt(void) {
+    interrupt_fired = true;
+    stats.interrupts++;
+}
+
+bool _watch_native_console_enabled(void) {
+    return console_enabled;
+}
+
+int8_t _watch_native_timer_start(watch_cb_t callback, uint32_t period_ticks, bool wakes) {
+    if (period_ticks == 0) period_ticks = 1;
+
+    for (int8_t i = 0; i < NATIVE_NUM_TIMERS; i++) {
+        if (timers[i].callback == NULL) {
+            timers[i].callback = callback;
+            timers[i].period = period_ticks;
+            timers[i].next = elapsed_ticks + period_ticks;
+            timers[i].wakes = wakes;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void _watch_native_timer_stop(int8_t handle) {
+    if (handle < 0 || handle >= NATIVE_NUM_TIMERS) return;
+    timers[handle].callback = NULL;
+}
+
+static void _watch_native_dispatch_input(void) {
+    while (input_events_next < input_events_count && input_events[input_events_next].ticks <= elapsed_ticks) {
+        native_input_event_t *event = &input_events[input_events_next++];
+        _watch_extint_set_button(event->pin, event->level);
+    }
+}
+
+/// Advances the virtual clock to the next event, but at most by max_ticks.
+static void _watch_native_step(uint64_t max_ticks) {
+    _watch_native_dispatch_input();
+
+    uint64_t ticks = max_ticks;
+    uint64_t candidate;
+
+    candidate = _watch_rtc_ticks_until_next_interrupt();
+    if (candidate < ticks) ticks = candidate;
+
+    for (uint8_t i = 0; i < NATIVE_NUM_TIMERS; i++) {
+        if (timers[i].callback == NULL) continue;
+        candidate = timers[i].next - elapsed_ticks;
+        if (candidate < ticks) ticks = candidate;
+    }
+
+    if (input_events_next < input_events_count) {
+        candidate = input_events[input_events_next].ticks - elapsed_ticks;
+        if (candidate < ticks) ticks = candidate;
+    }
+
+    if (end_ticks - elapsed_ticks < ticks) ticks = end_ticks - elapsed_ticks;
+    if (ticks == 0) exit(0);
+
+    elapsed_ticks += ticks;
+    _watch_native_pace();
+
+    _watch_rtc_advance(ticks);
+
+    for (uint8_t i = 0; i < NATIVE_NUM_TIMERS; i++) {
+        if (timers[i].callback != NULL && timers[i].next <= elapsed_ticks) {
+            timers[i].next += timers[i].period;
+            timers[i].callback();
+            if (timers[i].wakes) _watch_native_interrupt();
+        }
+    }
+
+    _watch_native_dispatch_input();
+
+    if (elapsed_ticks >= end_ticks) exit(0);
+}
+
+void _watch_native_run_ticks(uint32_t ticks) {
+    uint64_t target = elapsed_ticks + ticks;
+    while (elapsed_ticks < target) {
+        _watch_native_step(target - elapsed_ticks);
+    }
+}
+
+void _watch_native_wait_for_interrupt(void) {
+    _watch_native_print_display();
+    stats.sleeps++;
+
+    interrupt_fired = false;
+    while (!interrupt_fired) {
+        _watch_native_step(UINT64_MAX);
+    }
+}
+
+void delay_us(const uint32_t us) {
+    // accumulate in units of 1/(128 * 10^6) s so short delays add up exactly.
+    delay_remainder += (uint64_t)us * NATIVE_TICKS_PER_SECOND;
+    uint32_t ticks = delay_remainder / 1000000;
+    delay_remainder %= 1000000;
+    _watch_native_run_ticks(ticks);
+}
+
+void delay_ms(const uint16_t ms) {
+    delay_us((uint32_t)ms * 1000);
+}
+
+int32_t watch_native_get_utc_offset(void) {
+    struct tm local;
+    localtime_r(&start_time, &local);
+
+    return (int32_t)local.tm_gmtoff;
+}
+
+/// Parses "90", "90s", "15m", "12h", "7d" or "0.5s" into ticks.
+static bool _parse_duration(const char *s, uint64_t *ticks) {
+    char *end;
+    double value = strtod(s, &end);
+    if (end == s || value < 0) return false;
+
+    switch (*end) {
+        case 'd': value *= 24;
+            // fall through
+        case 'h': value *= 60;
+            // fall through
+        case 'm': value *= 60;
+            // fall through
+        case 's':
+            end++;
+            break;
+        case '\0':
+            break;
+        default:
+            return false;
+    }
+    if (*end != '\0') return false;
+
+    *ticks = (uint64_t)(value * NATIVE_TICKS_PER_SECOND + 0.5);
+    return true;
+}
+
+static bool _parse_start(const char *s, time_t *time) {
+    struct tm local = { .tm_isdst = -1 };
+    int n = sscanf(s, "%d-%d-%d%*[ T]%d:%d:%d", &local.tm_year, &local.tm_mon, &local.tm_mday,
+                   &local.tm_hour, &local.tm_min, &local.tm_sec);
+    if (n != 3 && n != 6) return false;
+    if (local.tm_year < WATCH_RTC_REFERENCE_YEAR || local.tm_year > WATCH_RTC_REFERENCE_YEAR + 63) return false;
+
+    local.tm_year -= 1900;
+    local.tm_mon -= 1;
+    *time = mktime(&local);
+    return *time != (time_t)-1;
+}
+
+static rtc_date_time_t _local_date_time(time_t time) {
+    rtc_date_time_t date_time = {0};
+    struct tm local;
+    localtime_r(&time, &local);
+
+    date_time.unit.year = local.tm_year + 1900 - WATCH_RTC_REFERENCE_YEAR;
+    date_time.unit.month = local.tm_mon + 1;
+    date_time.unit.day = local.tm_mday;
+    date_time.unit.hour = local.tm_hour;
+    date_time.unit.minute = local.tm_min;
+    date_time.unit.second = local.tm_sec;
+    return date_time;
+}
+
+static void _add_input_event(uint64_t ticks, uint8_t pin, bool level) {
+    input_events = realloc(input_events, (input_events_count + 1) * sizeof(native_input_event_t));
+    if (input_events == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+
+    // keep the list sorted; a release may land after a later press.
+    size_t i = input_events_count++;
+    while (i > 0 && input_events[i - 1].ticks > ticks) {
+        input_events[i] = input_events[i - 1];
+        i--;
+    }
+    input_events[i] = (native_input_event_t) { .ticks = ticks, .pin = pin, .level = level };
+}
+
+static bool _load_script(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "%s: cannot open script\n", path);
+        return false;
+    }
+
+    char line[128];
+    unsigned line_number = 0;
+    uint64_t previous = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        line_number++;
+        char time_arg[32], button_arg[16], action_arg[16], hold_arg[32] = "";
+        char *p = line + strspn(line, " \t");
+        if (*p == '#' || *p == '\n' || *p == '\0') continue;
+
+        int n = sscanf(p, "%31s %15s %15s %31s", time_arg, button_arg, action_arg, hold_arg);
+        uint64_t ticks, hold = NATIVE_TICKS_PER_SECOND / 10;
+        bool relative = time_arg[0] == '+';
+        uint8_t pin;
+
+        bool valid = n >= 3 && _parse_duration(time_arg + relative, &ticks);
+        if (valid && relative) ticks += previous;
+
+        if (strcmp(button_arg, "mode") == 0) pin = HAL_GPIO_BTN_MODE_pin();
+        else if (strcmp(button_arg, "light") == 0) pin = HAL_GPIO_BTN_LIGHT_pin();
+        else if (strcmp(button_arg, "alarm") == 0) pin = HAL_GPIO_BTN_ALARM_pin();
+        else valid = false;
+
+        if (strcmp(action_arg, "long") == 0) hold = NATIVE_TICKS_PER_SECOND;
+        if (n == 4) valid = valid && _parse_duration(hold_arg, &hold);
+
+        if (!valid) {
+            fprintf(stderr, "%s:%u: expected \"<time> <mode|light|alarm> <down|up|press|long> [hold]\"\n", path, line_number);
+            fclose(f);
+            return false;
+        }
+
+        if (strcmp(action_arg, "down") == 0) {
+            _add_input_event(ticks, pin, true);
+        } else if (strcmp(action_arg, "up") == 0) {
+            _add_input_event(ticks, pin, false);
+        } else if (strcmp(action_arg, "press") == 0 || strcmp(action_arg, "long") == 0) {
+            _add_input_event(ticks, pin, true);
+            _add_input_event(ticks + hold, pin, false);
+        } else {
+            fprintf(stderr, "%s:%u: unknown action \"%s\"\n", path, line_number, action_arg);
+            fclose(f);
+            return false;
+        }
+        previous = ticks;
+    }
+
+    fclose(f);
+    return true;
+}
+
+static void _usage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-d duration] [-s \"YYYY-MM-DD HH:MM:SS\"] [-x speed] [-i script] [-f storage] [-r trace] [-c] [-q]\n",
+            name);
+}
+
+int main(int argc, char **argv) {
+    const char *storage_path = NULL;
+    const char *trace_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        bool ok = true;
+
+        if (strcmp(arg, "-c") == 0 || strcmp(arg, "--shell") == 0) {
+            console_enabled = true;
+            continue;
+        } else if (strcmp(arg, "-q") == 0 || strcmp(arg, "--quiet") == 0) {
+            quiet = true;
+            continue;
+        } else if (value == NULL) {
+            ok = false;
+        } else if (strcmp(arg, "-d") == 0 || strcmp(arg, "--duration") == 0) {
+            ok = _parse_duration(value, &end_ticks);
+        } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--start") == 0) {
+            ok = _parse_start(value, &start_time);
+        } else if (strcmp(arg, "-x") == 0 || strcmp(arg, "--speed") == 0) {
+            speed = strtod(value, NULL);
+        } else if (strcmp(arg, "-i") == 0 || strcmp(arg, "--script") == 0) {
+            ok = _load_script(value);
+        } else if (strcmp(arg, "-f") == 0 || strcmp(arg, "--storage") == 0) {
+            storage_path = value;
+        } else if (strcmp(arg, "-r") == 0 || strcmp(arg, "--record") == 0) {
+            trace_path = value;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            _usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    if (speed < 0) speed = console_enabled ? 1 : 0;
+    if (start_time == 0) start_time = time(NULL);
+    _watch_rtc_set_init_time((unix_timestamp_t)start_time, _local_date_time(start_time));
+
+    if (!_watch_storage_load(storage_path)) {
+        fprintf(stderr, "%s: cannot read storage image\n", storage_path);
+        return 1;
+    }
+
+    if (trace_path && !_watch_slcd_trace_open(trace_path)) {
+        fprintf(stderr, "%s: cannot create trace\n", trace_path);
+        return 1;
+    }
+
+    if (console_enabled) {
+        // the shell polls for input, so reads must not block.
+        fcntl(0, F_SETFL, fcntl(0, F_GETFL) | O_NONBLOCK);
+        setvbuf(stdout, NULL, _IONBF, 0);
+        // Movement probes VBUS to decide whether to start the shell.
+        HAL_GPIO_VBUS_DET_write(true);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &host_start);
+    atexit(_watch_native_finish);
+
+    app_init();
+    app_setup();
+
+    while (true) {
+        if (console_enabled) clearerr(stdin);
+
+        bool can_sleep = app_loop();
+        stats.loops++;
+
+        if (can_sleep) {
+            _watch_native_wait_for_interrupt();
+        } else {
+            _watch_native_print_display();
+            _watch_native_run_ticks(1);
+        }
+    }
+
+    return 0;
+}
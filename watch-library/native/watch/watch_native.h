@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch.h"
+
+/*
+ * Plumbing shared by the native (host) HAL modules.
+ *
+ * The native build replaces the SAM L22 with a virtual clock. Nothing happens
+ * between two events, so whenever Movement reports that it can sleep, the clock
+ * jumps straight to the next RTC periodic interrupt, comparator match, auxiliary
+ * timer or scripted button event. A simulated day usually takes well under a
+ * second of host time. Use --speed to pace the clock against the wall clock.
+ */
+
+/// @brief Signals that an interrupt was serviced; wakes the core from sleep.
+void _watch_native_interrupt(void);
+
+/// @brief Advances the virtual clock by the given number of ticks, servicing every event on the way.
+void _watch_native_run_ticks(uint32_t ticks);
+
+/// @brief Advances the virtual clock until the next interrupt has been serviced (the equivalent of WFI).
+void _watch_native_wait_for_interrupt(void);
+
+/// @brief Returns true if the console on stdin/stdout is attached (--shell).
+bool _watch_native_console_enabled(void);
+
+/// @brief Returns the host's UTC offset in seconds for the simulated start time.
+int32_t watch_native_get_utc_offset(void);
+
+/// @brief Auxiliary timers model peripherals that tick independently of the RTC (TC0 for the buzzer,
+///        the SLCD blink and animation engines). Periods are in 128 Hz RTC ticks.
+/// @param callback The function to call every period_ticks ticks.
+/// @param period_ticks The period in ticks, at least 1.
+/// @param wakes True if the timer raises an interrupt that wakes the core, as TC0 does.
+/// @return A timer handle, or -1 if all timers are in use.
+int8_t _watch_native_timer_start(watch_cb_t callback, uint32_t period_ticks, bool wakes);
+
+/// @brief Stops an auxiliary timer. Stopping handle -1 is a no-op.
+void _watch_native_timer_stop(int8_t handle);
+
+// RTC internals, implemented in watch_rtc.c.
+uint32_t _watch_rtc_ticks_until_next_interrupt(void);
+void _watch_rtc_advance(uint32_t ticks);
+void _watch_rtc_set_init_time(unix_timestamp_t unix_time, rtc_date_time_t local_date_time);
+
+// Button injection, implemented in watch_extint.c.
+void _watch_extint_set_button(uint8_t pin, bool level);
+
+// Display inspection, implemented in watch_slcd.c.
+bool _watch_slcd_frame_changed(void);
+void _watch_slcd_describe(char *buf, size_t size);
+bool _watch_slcd_trace_open(const char *path);
+void _watch_slcd_trace_close(void);
+
+// Storage persistence, implemented in watch_storage.c.
+bool _watch_storage_load(const char *path);
+bool _watch_storage_save(void);
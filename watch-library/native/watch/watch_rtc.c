@@ -0,0 +1,351 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Joey Castillo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+
+#include "watch_rtc.h"
+#include "watch_utility.h"
+#include "watch_calendar.h"
+#include "watch_trace.h"
+#include "watch_native.h"
+
+static const uint32_t RTC_CNT_HZ = 128;
+static const uint32_t RTC_CNT_SUBSECOND_MASK = RTC_CNT_HZ - 1;
+static const uint32_t RTC_CNT_DIV = 7;
+static const uint32_t RTC_CNT_TICKS_PER_MINUTE = RTC_CNT_HZ * 60;
+
+static bool rtc_enabled;
+static uint32_t counter;
+static uint32_t reference_timestamp;
+static rtc_date_time_t init_date_time;
+static unix_timestamp_t init_unix_time;
+
+#define WATCH_RTC_N_COMP_CB 8
+
+typedef struct {
+    volatile uint32_t counter;
+    volatile watch_cb_t callback;
+    volatile bool enabled;
+} comp_cb_t;
+
+watch_cb_t tick_callbacks[8];
+comp_cb_t comp_callbacks[WATCH_RTC_N_COMP_CB];
+
+static uint32_t scheduled_comp_counter;
+
+watch_cb_t btn_alarm_callback;
+watch_cb_t a2_callback;
+watch_cb_t a4_callback;
+
+static void _watch_process_periodic_callbacks(void);
+static void _watch_process_comp_callbacks(void);
+
+bool _watch_rtc_is_enabled(void) {
+    return rtc_enabled;
+}
+
+void _watch_rtc_init(void) {
+    for (uint8_t index = 0; index < 8; ++index) {
+        tick_callbacks[index] = NULL;
+    }
+
+    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
+        comp_callbacks[index].counter = 0;
+        comp_callbacks[index].callback = NULL;
+        comp_callbacks[index].enabled = false;
+    }
+
+    scheduled_comp_counter = 0;
+    counter = 0;
+    rtc_enabled = false;
+
+    // the RTC keeps UTC; the start time was given in the host's local time zone.
+    watch_rtc_set_unix_time(init_unix_time);
+    watch_rtc_enable(true);
+}
+
+void _watch_rtc_set_init_time(unix_timestamp_t unix_time, rtc_date_time_t local_date_time) {
+    init_unix_time = unix_time;
+    init_date_time = local_date_time;
+}
+
+void watch_rtc_set_date_time(rtc_date_time_t date_time) {
+    watch_rtc_set_unix_time(watch_utility_date_time_to_unix_time(date_time, 0));
+}
+
+rtc_date_time_t watch_rtc_get_date_time(void) {
+    static watch_calendar_t calendar = {0};
+
+    watch_calendar_update(&calendar, watch_rtc_get_unix_time(), 0);
+
+    return calendar.date_time;
+}
+
+void watch_rtc_set_unix_time(unix_timestamp_t unix_time) {
+    // unix_time = time_backup + counter / RTC_CNT_HZ - 0.5
+    rtc_counter_t counter = watch_rtc_get_counter();
+    reference_timestamp = unix_time - (counter >> RTC_CNT_DIV) - ((counter & RTC_CNT_SUBSECOND_MASK) >> (RTC_CNT_DIV - 1)) + 1;
+}
+
+unix_timestamp_t watch_rtc_get_unix_time(void) {
+    // unix_time = time_backup + counter / RTC_CNT_HZ - 0.5
+    rtc_counter_t counter = watch_rtc_get_counter();
+    return reference_timestamp + (counter >> RTC_CNT_DIV) + ((counter & RTC_CNT_SUBSECOND_MASK) >> (RTC_CNT_DIV - 1)) - 1;
+}
+
+rtc_counter_t watch_rtc_get_counter(void) {
+    return counter;
+}
+
+uint32_t watch_rtc_get_frequency(void) {
+    return RTC_CNT_HZ;
+}
+
+uint32_t watch_rtc_get_ticks_per_minute(void) {
+    return RTC_CNT_TICKS_PER_MINUTE;
+}
+
+rtc_date_time_t watch_get_init_date_time(void) {
+    // set by the command line parser in watch_native.c, from --start or the host clock.
+    return init_date_time;
+}
+
+void watch_rtc_register_tick_callback(watch_cb_t callback) {
+    watch_rtc_register_periodic_callback(callback, 1);
+}
+
+void watch_rtc_disable_tick_callback(void) {
+    watch_rtc_disable_periodic_callback(1);
+}
+
+uint32_t _watch_rtc_ticks_until_next_interrupt(void) {
+    if (!rtc_enabled) return UINT32_MAX;
+
+    uint32_t min_ticks = UINT32_MAX;
+
+    // PER0 fires on every tick; PERn (n > 0) fires when counter % 2^n == 2^(n-1). See the table below.
+    if (tick_callbacks[0]) return 1;
+    for (uint8_t per_n = 1; per_n < 8; per_n++) {
+        if (!tick_callbacks[per_n]) continue;
+        uint32_t period = 1u << per_n;
+        uint32_t phase = period >> 1;
+        uint32_t ticks = ((phase - counter - 1) & (period - 1)) + 1;
+        if (ticks < min_ticks) min_ticks = ticks;
+    }
+
+    // the comparator interrupt fires one tick after the matching counter.
+    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
+        if (comp_callbacks[index].enabled) {
+            uint32_t ticks = scheduled_comp_counter + 1 - counter;
+            if (ticks != 0 && ticks < min_ticks) min_ticks = ticks;
+            break;
+        }
+    }
+
+    return min_ticks;
+}
+
+void _watch_rtc_advance(uint32_t ticks) {
+    if (!rtc_enabled || ticks == 0) return;
+
+    // nothing can fire in between, so skip straight to the last tick.
+    counter += ticks - 1;
+
+    counter += 1;
+    // Fire the periodic callbacks that match this counter
+    _watch_process_periodic_callbacks();
+    // Fire the comp callbacks that match this counter
+    _watch_process_comp_callbacks();
+}
+
+static void _watch_process_periodic_callbacks(void) {
+    /* It looks weird but it follows the way the hardware triggers periodic interrupts.
+     * For 128hz counter periodic interrupts fire at these tick values:
+     * 1Hz:   64
+     * 2Hz:   32, 96
+     * 4Hz:   16, 48, 80, 112
+     * 8Hz:   8, 24, 40, 56, 72, 88, 104, 120
+     * 16Hz:  4, 12, 20, ..., 124
+     * 32Hz:  2, 6, 10, ..., 126
+     * 64Hz:  1, 3, 5, ..., 127
+     * 128Hz: 0, 1, 2, ..., 127
+     *
+     * Which means that only one periodic interrupt can fire for a given counter value
+     * (except 128Hz which can always fire)
+     */
+
+    uint32_t subseconds = counter & RTC_CNT_SUBSECOND_MASK;
+
+    // Find the first non-zero bit in the counter, which can be used to determine the appropriate period (see table above).
+    uint8_t per_n = 0;
+
+    for (uint8_t i = 0; i < 7; i++) {
+        if (subseconds & (1 << i)) {
+            per_n = i + 1;
+            break;
+        }
+    }
+
+    if (tick_callbacks[per_n]) {
+        tick_callbacks[per_n]();
+        _watch_native_interrupt();
+    }
+
+    // 128Hz is always a match
+    if (per_n != 0 && tick_callbacks[0]) {
+        tick_callbacks[0]();
+        _watch_native_interrupt();
+    }
+}
+
+static void _watch_process_comp_callbacks(void) {
+    // In hardware the interrupt fires one tick after the matching counter
+    if (counter == (scheduled_comp_counter + 1)) {
+        for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
+            if (comp_callbacks[index].enabled && scheduled_comp_counter == comp_callbacks[index].counter) {
+                comp_callbacks[index].enabled = false;
+                WATCH_TRACE_EVENT(WATCH_TRACE_COMP, counter - comp_callbacks[index].counter);
+                comp_callbacks[index].callback();
+                _watch_native_interrupt();
+            }
+        }
+
+        watch_rtc_schedule_next_comp();
+    }
+}
+
+void watch_rtc_register_periodic_callback(watch_cb_t callback, uint8_t frequency) {
+    // we told them, it has to be a power of 2.
+    if (__builtin_popcount(frequency) != 1) return;
+
+    // this left-justifies the period in a 32-bit integer.
+    uint32_t tmp = (frequency & 0xFF) << 24;
+    // now we can count the leading zeroes to get the value we need.
+    // 0x01 (1 Hz) will have 7 leading zeros for PER7. 0xF0 (128 Hz) will have no leading zeroes for PER0.
+    uint8_t per_n = __builtin_clz(tmp);
+
+    tick_callbacks[per_n] = callback;
+}
+
+void watch_rtc_disable_periodic_callback(uint8_t frequency) {
+    if (__builtin_popcount(frequency) != 1) return;
+    uint8_t per_n = __builtin_clz((frequency & 0xFF) << 24);
+    tick_callbacks[per_n] = NULL;
+}
+
+void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
+    for (int i = 0; i < 8; i++) {
+        if (tick_callbacks[i] && (mask & (1 << i)) != 0) {
+            tick_callbacks[i] = NULL;
+        }
+    }
+}
+
+void watch_rtc_disable_all_periodic_callbacks(void) {
+    watch_rtc_disable_matching_periodic_callbacks(0xFF);
+}
+
+void watch_rtc_register_comp_callback(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
+    if (index >= WATCH_RTC_N_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].counter = counter;
+    comp_callbacks[index].callback = callback;
+    comp_callbacks[index].enabled = true;
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_register_comp_callback_no_schedule(watch_cb_t callback, rtc_counter_t counter, uint8_t index) {
+    if (index >= WATCH_RTC_N_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].counter = counter;
+    comp_callbacks[index].callback = callback;
+    comp_callbacks[index].enabled = true;
+}
+
+void watch_rtc_disable_comp_callback(uint8_t index) {
+    if (index >= WATCH_RTC_N_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].enabled = false;
+
+    watch_rtc_schedule_next_comp();
+}
+
+void watch_rtc_disable_comp_callback_no_schedule(uint8_t index) {
+    if (index >= WATCH_RTC_N_COMP_CB) {
+        return;
+    }
+
+    comp_callbacks[index].enabled = false;
+}
+
+void watch_rtc_schedule_next_comp(void) {
+    rtc_counter_t curr_counter = watch_rtc_get_counter();
+    // If there is already a pending comp interrupt for this very tick, let it fire
+    // And this function will be called again as soon as the interrupt fires.
+    if (curr_counter == scheduled_comp_counter) {
+        return;
+    }
+
+    // The soonest we can schedule is the next tick
+    curr_counter +=1;
+
+    bool schedule_any = false;
+    rtc_counter_t comp_counter;
+    rtc_counter_t min_diff = UINT_MAX;
+
+    for (uint8_t index = 0; index < WATCH_RTC_N_COMP_CB; ++index) {
+        if (comp_callbacks[index].enabled) {
+            rtc_counter_t diff = comp_callbacks[index].counter - curr_counter;
+            if (diff <= min_diff) {
+                min_diff = diff;
+                comp_counter = comp_callbacks[index].counter;
+                schedule_any = true;
+            }
+        }
+    }
+
+    if (schedule_any) {
+        scheduled_comp_counter = comp_counter;
+    } else {
+        scheduled_comp_counter = curr_counter - 2;
+    }
+}
+
+void watch_rtc_enable(bool en) {
+    rtc_enabled = en;
+}
+
+void watch_rtc_freqcorr_write(int16_t value, int16_t sign) {
+    (void) value;
+    (void) sign;
+    // Not simulated
+}
@@ -0,0 +1,414 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 Joey Castillo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "watch_slcd.h"
+#include "watch_common_display.h"
+#include "watch_trace.h"
+#include "watch_native.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Segmented Display
+
+// One word per COM line, one bit per SEG line, like the SLCD's SDATA registers.
+#define SLCD_NUM_COMS 8
+
+// Drawing goes into frame; watch_display_commit copies it to panel, which is what the LCD shows.
+static uint32_t frame[SLCD_NUM_COMS];
+static uint32_t panel[SLCD_NUM_COMS];
+static uint32_t last_described_frame[SLCD_NUM_COMS];
+static uint8_t dirty_coms;
+static bool display_enabled;
+
+static char blink_character;
+static bool blink_state;
+static int8_t blink_timer = -1;
+static int8_t blink_indicator = -1;    // the blinking indicator, or -1 if the character in position 7 blinks
+static bool tick_state;
+static int8_t tick_timer = -1;
+static int8_t animation_timer = -1;
+
+// While the decoder tables are built, pixel writes are recorded here instead.
+static uint32_t *capture_touched;
+
+// Segments written through the pixel functions since the last commit, and the frame trace (--record).
+static uint32_t pending_writes;
+static FILE *trace_file;
+static rtc_counter_t trace_counter;
+
+watch_lcd_type_t watch_get_lcd_type(void) {
+#if defined(FORCE_CUSTOM_LCD_TYPE)
+    return WATCH_LCD_TYPE_CUSTOM;
+#else
+    return WATCH_LCD_TYPE_CLASSIC;
+#endif
+}
+
+void watch_discover_lcd_type(void) {
+}
+
+void watch_enable_display(void) {
+#if defined(FORCE_CUSTOM_LCD_TYPE)
+    _watch_update_indicator_segments();
+#endif
+    _watch_update_glyph_table();
+    display_enabled = true;
+
+    watch_clear_display();
+}
+
+void watch_disable_display(void) {
+    watch_clear_display();
+    display_enabled = false;
+}
+
+void watch_set_pixel(uint8_t com, uint8_t seg) {
+    if (com >= SLCD_NUM_COMS || seg >= 32) return;
+    if (capture_touched) capture_touched[com] |= 1u << seg;
+    pending_writes++;
+    frame[com] |= 1u << seg;
+    dirty_coms |= 1u << com;
+}
+
+void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    if (com >= SLCD_NUM_COMS || seg >= 32) return;
+    if (capture_touched) capture_touched[com] |= 1u << seg;
+    pending_writes++;
+    frame[com] &= ~(1u << seg);
+    dirty_coms |= 1u << com;
+}
+
+void watch_update_pixels(uint8_t com, uint32_t mask, uint32_t value) {
+    if (com >= SLCD_NUM_COMS) return;
+    if (capture_touched) capture_touched[com] |= mask | value;
+    pending_writes += __builtin_popcount(mask | value);
+    frame[com] = (frame[com] & ~mask) | value;
+    dirty_coms |= 1u << com;
+}
+
+void watch_clear_display(void) {
+    for (uint8_t com = 0; com < SLCD_NUM_COMS; com++) pending_writes += __builtin_popcount(frame[com]);
+    memset(frame, 0, sizeof(frame));
+    dirty_coms = 0xFF;
+}
+
+static void _watch_slcd_trace_varint(uint32_t value) {
+    while (value >= 0x80) {
+        fputc((value & 0x7F) | 0x80, trace_file);
+        value >>= 7;
+    }
+    fputc(value, trace_file);
+}
+
+/// Appends a record to the trace if the panel changed or a face drew something since the last record.
+static void _watch_slcd_trace_frame(const uint32_t previous[SLCD_NUM_COMS]) {
+    uint8_t changed_coms = 0;
+    for (uint8_t com = 0; com < SLCD_NUM_COMS; com++) {
+        if (panel[com] != previous[com]) changed_coms |= 1u << com;
+    }
+    uint32_t writes = pending_writes;
+    pending_writes = 0;
+    if (!trace_file || (!changed_coms && !writes)) return;
+
+    rtc_counter_t counter = watch_rtc_get_counter();
+    _watch_slcd_trace_varint(counter - trace_counter);
+    trace_counter = counter;
+    fputc(changed_coms, trace_file);
+    _watch_slcd_trace_varint(writes);
+    for (uint8_t com = 0; com < SLCD_NUM_COMS; com++) {
+        if (!(changed_coms & (1u << com))) continue;
+        for (uint8_t byte = 0; byte < 4; byte++) fputc((panel[com] >> (8 * byte)) & 0xFF, trace_file);
+    }
+}
+
+void watch_display_commit(void) {
+    uint32_t previous[SLCD_NUM_COMS];
+    memcpy(previous, panel, sizeof(panel));
+
+    while (dirty_coms) {
+        uint8_t com = __builtin_ctz(dirty_coms);
+        dirty_coms &= dirty_coms - 1;
+        panel[com] = _watch_animation_merge(com, frame[com]);
+    }
+
+#ifdef WATCH_TRACE
+    uint16_t changed_coms = 0;
+    for (uint8_t com = 0; com < SLCD_NUM_COMS; com++) {
+        if (panel[com] != previous[com]) changed_coms |= 1 << com;
+    }
+    if (changed_coms) WATCH_TRACE_EVENT(WATCH_TRACE_DISPLAY_COMMIT, changed_coms);
+#endif
+
+    _watch_slcd_trace_frame(previous);
+}
+
+static void watch_invoke_animation_callback(void) {
+    uint32_t previous[SLCD_NUM_COMS];
+    memcpy(previous, panel, sizeof(panel));
+    uint32_t writes = pending_writes;
+    _watch_animation_step();
+
+    // like the SLCD interrupt, only touch the animated segments.
+    for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) {
+        uint32_t owned = _watch_animation.owned[com];
+        panel[com] = (panel[com] & ~owned) | (_watch_animation_merge(com, frame[com]) & owned);
+    }
+
+    // the face has not committed yet, so its writes go to the next record.
+    pending_writes = 0;
+    _watch_slcd_trace_frame(previous);
+    pending_writes = writes;
+}
+
+void _watch_slcd_start_animation(uint32_t duration) {
+    // blinks on SEG0 and SEG1 run in the SLCD's blink hardware, everything else wakes the core for each frame.
+    bool blink_in_hardware = _watch_animation.type == WATCH_ANIMATION_BLINK;
+    for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) {
+        if (_watch_animation.owned[com] & ~0b11) blink_in_hardware = false;
+    }
+
+    _watch_native_timer_stop(animation_timer);
+    animation_timer = _watch_native_timer_start(watch_invoke_animation_callback, (duration * 128 + 500) / 1000, !blink_in_hardware);
+    dirty_coms |= (1u << GLYPH_NUM_COMS) - 1;
+}
+
+void _watch_slcd_stop_animation(void) {
+    _watch_native_timer_stop(animation_timer);
+    animation_timer = -1;
+    dirty_coms |= (1u << GLYPH_NUM_COMS) - 1;
+}
+
+static void watch_invoke_blink_callback(void) {
+    blink_state = !blink_state;
+    watch_display_character(blink_state ? blink_character : ' ', 7);
+    watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+    // the SLCD animates on its own, so the change is visible right away and is not a face's write.
+    pending_writes = 0;
+    watch_display_commit();
+}
+
+void watch_start_character_blink(char character, uint32_t duration) {
+    if (blink_timer != -1) return;
+    watch_display_character(character, 7);
+    watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+
+    blink_state = true;
+    blink_character = character;
+    blink_indicator = -1;
+    // the SLCD blinks on its own, so this timer does not wake the core.
+    blink_timer = _watch_native_timer_start(watch_invoke_blink_callback, (duration * 128 + 500) / 1000, false);
+}
+
+static void watch_invoke_indicator_blink_callback(void) {
+    blink_state = !blink_state;
+    if (blink_state) watch_set_indicator((watch_indicator_t)blink_indicator);
+    else watch_clear_indicator((watch_indicator_t)blink_indicator);
+    pending_writes = 0;
+    watch_display_commit();
+}
+
+void watch_start_indicator_blink_if_possible(watch_indicator_t indicator, uint32_t duration) {
+    // like the hardware, only the custom LCD can blink these four indicators.
+    if (watch_get_lcd_type() != WATCH_LCD_TYPE_CUSTOM) return;
+    switch (indicator) {
+        case WATCH_INDICATOR_COLON:
+        case WATCH_INDICATOR_LAP:
+        case WATCH_INDICATOR_ARROWS:
+        case WATCH_INDICATOR_SLEEP:
+            break;
+        default:
+            return;
+    }
+    if (blink_timer != -1) return;
+    watch_set_indicator(indicator);
+    watch_display_commit();
+
+    blink_state = true;
+    blink_indicator = indicator;
+    // the SLCD blinks on its own, so this timer does not wake the core.
+    blink_timer = _watch_native_timer_start(watch_invoke_indicator_blink_callback, (duration * 128 + 500) / 1000, false);
+}
+
+void watch_stop_blink(void) {
+    _watch_native_timer_stop(blink_timer);
+    // the hardware keeps showing the indicator once it stops blinking it.
+    if (blink_indicator != -1 && !blink_state) {
+        watch_set_indicator((watch_indicator_t)blink_indicator);
+        watch_display_commit();
+    }
+    blink_timer = -1;
+    blink_state = false;
+    blink_indicator = -1;
+}
+
+static void watch_invoke_tick_callback(void) {
+    tick_state = !tick_state;
+    if (tick_state) {
+        watch_clear_pixel(0, 2);
+        watch_set_pixel(0, 3);
+    } else {
+        watch_clear_pixel(0, 3);
+        watch_set_pixel(0, 2);
+    }
+    pending_writes = 0;
+    watch_display_commit();
+}
+
+void watch_start_sleep_animation(uint32_t duration) {
+    if (tick_timer != -1) return;
+    watch_display_character(' ', 8);
+
+    tick_state = true;
+    tick_timer = _watch_native_timer_start(watch_invoke_tick_callback, (duration * 128 + 500) / 1000, false);
+}
+
+bool watch_sleep_animation_is_running(void) {
+    return tick_timer != -1;
+}
+
+void watch_stop_sleep_animation(void) {
+    _watch_native_timer_stop(tick_timer);
+    tick_timer = -1;
+    tick_state = false;
+
+    watch_display_character(' ', 8);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Frame decoding, so that the simulator can print what the display shows.
+
+#define SLCD_NUM_POSITIONS 10
+
+static const char decodable_characters[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz-_=+'\"/\\()[]<>^*#&!@$%:.,;|";
+static const char *indicator_names[] = { "SIG", "BELL", "PM", "24H", "LAP", "ARROWS", "SLEEP", "COLON" };
+
+typedef struct {
+    uint32_t touched[SLCD_NUM_COMS];
+    uint32_t pattern[sizeof(decodable_characters) - 1][SLCD_NUM_COMS];
+} position_decoder_t;
+
+static position_decoder_t position_decoders[SLCD_NUM_POSITIONS];
+static uint32_t indicator_patterns[sizeof(indicator_names) / sizeof(indicator_names[0])][SLCD_NUM_COMS];
+static bool decoders_built;
+
+static void _watch_slcd_build_decoders(void) {
+    uint32_t saved[SLCD_NUM_COMS];
+    uint8_t saved_dirty_coms = dirty_coms;
+    uint32_t saved_pending_writes = pending_writes;
+    memcpy(saved, frame, sizeof(frame));
+
+    // render every character in every position onto a blank frame and remember which pixels it lights.
+    for (uint8_t position = 0; position < SLCD_NUM_POSITIONS; position++) {
+        position_decoder_t *decoder = &position_decoders[position];
+        capture_touched = decoder->touched;
+        for (size_t i = 0; i < sizeof(decodable_characters) - 1; i++) {
+            memset(frame, 0, sizeof(frame));
+            watch_display_character(decodable_characters[i], position);
+            memcpy(decoder->pattern[i], frame, sizeof(frame));
+        }
+    }
+    capture_touched = NULL;
+
+    for (size_t i = 0; i < sizeof(indicator_names) / sizeof(indicator_names[0]); i++) {
+        memset(frame, 0, sizeof(frame));
+        watch_set_indicator((watch_indicator_t)i);
+        memcpy(indicator_patterns[i], frame, sizeof(frame));
+    }
+
+    memcpy(frame, saved, sizeof(frame));
+    dirty_coms = saved_dirty_coms;
+    pending_writes = saved_pending_writes;
+    decoders_built = true;
+}
+
+bool _watch_slcd_frame_changed(void) {
+    return memcmp(panel, last_described_frame, sizeof(panel)) != 0;
+}
+
+void _watch_slcd_describe(char *buf, size_t size) {
+    if (!decoders_built) _watch_slcd_build_decoders();
+    memcpy(last_described_frame, panel, sizeof(panel));
+
+    if (!display_enabled) {
+        snprintf(buf, size, "[display off]");
+        return;
+    }
+
+    char text[SLCD_NUM_POSITIONS + 1];
+    for (uint8_t position = 0; position < SLCD_NUM_POSITIONS; position++) {
+        position_decoder_t *decoder = &position_decoders[position];
+        text[position] = '?';
+        for (size_t i = 0; i < sizeof(decodable_characters) - 1; i++) {
+            bool match = true;
+            for (uint8_t com = 0; com < SLCD_NUM_COMS && match; com++) {
+                match = (panel[com] & decoder->touched[com]) == decoder->pattern[i][com];
+            }
+            if (match) {
+                text[position] = decodable_characters[i];
+                break;
+            }
+        }
+    }
+    text[SLCD_NUM_POSITIONS] = '\0';
+
+    // Classic layout: weekday, day, then HH MM SS on the main line.
+    int n = snprintf(buf, size, "[%.2s %.2s %.2s%.2s%.2s]", text, text + 2, text + 4, text + 6, text + 8);
+
+    for (size_t i = 0; i < sizeof(indicator_names) / sizeof(indicator_names[0]) && n > 0 && (size_t)n < size; i++) {
+        bool set = false;
+        for (uint8_t com = 0; com < SLCD_NUM_COMS; com++) {
+            if (indicator_patterns[i][com] & panel[com]) set = true;
+        }
+        if (set) n += snprintf(buf + n, size - n, " %s", indicator_names[i]);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Frame trace, so that display output and segment writes can be checked on the host.
+// See utils/lcd_trace/lcd_trace.py for the format and the tools that read it.
+
+#define SLCD_TRACE_VERSION 1
+
+bool _watch_slcd_trace_open(const char *path) {
+    trace_file = fopen(path, "wb");
+    if (!trace_file) return false;
+
+    // header: magic, version, LCD type, COM words per frame and counter ticks per second.
+    fputs("LCDT", trace_file);
+    fputc(SLCD_TRACE_VERSION, trace_file);
+    fputc(watch_get_lcd_type(), trace_file);
+    fputc(SLCD_NUM_COMS, trace_file);
+    fputc(watch_rtc_get_frequency(), trace_file);
+    trace_counter = 0;
+
+    return true;
+}
+
+void _watch_slcd_trace_close(void) {
+    if (!trace_file) return;
+    fclose(trace_file);
+    trace_file = NULL;
+}
@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "watch_storage.h"
+#include "watch_native.h"
+
+// The RWWEE area; erased flash reads as 0xFF.
+static uint8_t storage[NVMCTRL_ROW_SIZE * NVMCTRL_RWWEE_PAGES / 4];
+static const char *storage_path = NULL;
+
+bool _watch_storage_load(const char *path) {
+    storage_path = path;
+    memset(storage, 0xff, sizeof(storage));
+    if (path == NULL) return true;
+
+    FILE *f = fopen(path, "rb");
+    // a missing image is fine, it will be created on the first sync.
+    if (f == NULL) return true;
+    size_t read = fread(storage, 1, sizeof(storage), f);
+    fclose(f);
+
+    return read == sizeof(storage);
+}
+
+bool _watch_storage_save(void) {
+    if (storage_path == NULL) return true;
+
+    FILE *f = fopen(storage_path, "wb");
+    if (f == NULL) return false;
+    size_t written = fwrite(storage, 1, sizeof(storage), f);
+    fclose(f);
+
+    return written == sizeof(storage);
+}
+
+bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t size) {
+    if (row * NVMCTRL_ROW_SIZE + offset + size > sizeof(storage)) return false;
+    memcpy(buffer, storage + row * NVMCTRL_ROW_SIZE + offset, size);
+
+    return true;
+}
+
+bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    if (row * NVMCTRL_ROW_SIZE + offset + size > sizeof(storage)) return false;
+    // like NOR flash, programming can only clear bits.
+    for (uint32_t i = 0; i < size; i++) {
+        storage[row * NVMCTRL_ROW_SIZE + offset + i] &= buffer[i];
+    }
+
+    return true;
+}
+
+bool watch_storage_erase(uint32_t row) {
+    if ((row + 1) * NVMCTRL_ROW_SIZE > sizeof(storage)) return false;
+    memset(storage + row * NVMCTRL_ROW_SIZE, 0xff, NVMCTRL_ROW_SIZE);
+
+    return true;
+}
+
+bool watch_storage_sync(void) {
+    return _watch_storage_save();
+}
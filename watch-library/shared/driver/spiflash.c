@@ -28,7 +28,13 @@
 
 #include "spiflash.h"
 
-#define SPI_FLASH_FAST_READ false
+// Reads at least this long use the fast read command. It costs a dummy byte, but is specified for the
+// chip's full clock rate, so bulk reads keep working when the bus is clocked up.
+#define SPI_FLASH_FAST_READ_MIN_LENGTH 64
+
+// A sector erase takes a few hundred milliseconds at worst. A chip that is still busy after this is not going to
+// finish, and the caller gets an error instead of a hung watch.
+#define SPI_FLASH_READY_TIMEOUT_MS 1000
 
 static void flash_enable(void) {
     HAL_GPIO_A3_clr();
@@ -39,6 +45,7 @@ static void flash_disable(void) {
 }
 
 static bool transfer(uint8_t *command, uint32_t command_length, uint8_t *data_in, uint8_t *data_out, uint32_t data_length) {
+    flash_enable();
     bool status = watch_spi_write(command, command_length);
     if (status) {
         if (data_in != NULL && data_out != NULL) {
@@ -98,7 +105,7 @@ bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length)
 bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
     uint8_t request[5] = {CMD_READ_DATA, 0x00, 0x00, 0x00};
     uint8_t command_length = 4;
-    if (SPI_FLASH_FAST_READ) {
+    if (data_length >= SPI_FLASH_FAST_READ_MIN_LENGTH) {
         request[0] = CMD_FAST_READ_DATA;
         command_length = 5;
     }
@@ -113,8 +120,19 @@ bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length)
     return status;
 }
 
+bool spi_flash_wait_until_ready(void) {
+    uint32_t timeout = SPI_FLASH_READY_TIMEOUT_MS * watch_rtc_get_frequency() / 1000;
+    rtc_counter_t start = watch_rtc_get_counter();
+    uint8_t status;
+    do {
+        if (!spi_flash_read_command(CMD_READ_STATUS, &status, 1)) return false;
+        if (!(status & 0x01)) return true;    // no write in progress
+    } while (watch_rtc_get_counter() - start <= timeout);
+    return false;
+}
+
 void spi_flash_init(void) {
-	gpio_set_pin_level(A3, true);
-	gpio_set_pin_direction(A3, GPIO_DIRECTION_OUT);
+    HAL_GPIO_A3_set();
+    HAL_GPIO_A3_out();
     watch_enable_spi();
 }
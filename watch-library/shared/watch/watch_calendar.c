@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_calendar.h"
+#include "watch_utility.h"
+
+#define WATCH_CALENDAR_SECONDS_PER_DAY (86400)
+#define WATCH_CALENDAR_MAX_YEAR (63)
+
+static bool _watch_calendar_is_leap(uint16_t year) {
+    return !(year % 4) && ((year % 100) || !(year % 400));
+}
+
+static uint8_t _watch_calendar_days_in_month(uint16_t year, uint8_t month) {
+    static const uint8_t days_in_month[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month == 2 && _watch_calendar_is_leap(year)) return 29;
+    return days_in_month[month - 1];
+}
+
+static uint8_t _watch_calendar_iso_weeks_in_year(uint16_t year) {
+    // A year has 53 ISO weeks if it starts on a Thursday, or if it is a leap year starting on a Wednesday.
+    // Equivalently, if December 31st of the year or of the previous year falls on a Thursday / Friday.
+    uint16_t p = (year + year / 4 - year / 100 + year / 400) % 7;
+    uint16_t q = ((year - 1) + (year - 1) / 4 - (year - 1) / 100 + (year - 1) / 400) % 7;
+    return (p == 4 || q == 3) ? 53 : 52;
+}
+
+static void _watch_calendar_update_iso_week(watch_calendar_t *calendar) {
+    uint16_t year = calendar->date_time.unit.year + WATCH_RTC_REFERENCE_YEAR;
+    int16_t week = ((int16_t)calendar->day_of_year - calendar->weekday + 10) / 7;
+
+    if (week < 1) {
+        calendar->iso_year = year - 1;
+        calendar->iso_week = _watch_calendar_iso_weeks_in_year(year - 1);
+    } else if (week > _watch_calendar_iso_weeks_in_year(year)) {
+        calendar->iso_year = year + 1;
+        calendar->iso_week = 1;
+    } else {
+        calendar->iso_year = year;
+        calendar->iso_week = week;
+    }
+}
+
+static bool _watch_calendar_next_day(watch_calendar_t *calendar) {
+    watch_date_time_t *date_time = &calendar->date_time;
+    uint16_t year = date_time->unit.year + WATCH_RTC_REFERENCE_YEAR;
+
+    calendar->weekday = calendar->weekday == 7 ? 1 : calendar->weekday + 1;
+    calendar->day_of_year++;
+
+    if (date_time->unit.day < _watch_calendar_days_in_month(year, date_time->unit.month)) {
+        date_time->unit.day++;
+    } else if (date_time->unit.month < 12) {
+        date_time->unit.day = 1;
+        date_time->unit.month++;
+    } else {
+        if (date_time->unit.year == WATCH_CALENDAR_MAX_YEAR) return false;
+        date_time->unit.day = 1;
+        date_time->unit.month = 1;
+        date_time->unit.year++;
+        calendar->day_of_year = 1;
+    }
+
+    // the week number only changes on Mondays and on the first day of the year.
+    if (calendar->weekday == 1 || calendar->day_of_year == 1) _watch_calendar_update_iso_week(calendar);
+
+    return true;
+}
+
+static bool _watch_calendar_previous_day(watch_calendar_t *calendar) {
+    watch_date_time_t *date_time = &calendar->date_time;
+
+    calendar->weekday = calendar->weekday == 1 ? 7 : calendar->weekday - 1;
+
+    if (date_time->unit.day > 1) {
+        date_time->unit.day--;
+        calendar->day_of_year--;
+    } else if (date_time->unit.month > 1) {
+        date_time->unit.month--;
+        date_time->unit.day = _watch_calendar_days_in_month(date_time->unit.year + WATCH_RTC_REFERENCE_YEAR, date_time->unit.month);
+        calendar->day_of_year--;
+    } else {
+        if (date_time->unit.year == 0) return false;
+        date_time->unit.year--;
+        date_time->unit.month = 12;
+        date_time->unit.day = 31;
+        calendar->day_of_year = _watch_calendar_is_leap(date_time->unit.year + WATCH_RTC_REFERENCE_YEAR) ? 366 : 365;
+    }
+
+    // Sundays and the last day of the year are the days whose week number differs from the following day.
+    if (calendar->weekday == 7 || (date_time->unit.month == 12 && date_time->unit.day == 31)) _watch_calendar_update_iso_week(calendar);
+
+    return true;
+}
+
+void watch_calendar_set(watch_calendar_t *calendar, unix_timestamp_t timestamp, int32_t utc_offset) {
+    calendar->timestamp = timestamp;
+    calendar->utc_offset = utc_offset;
+    calendar->date_time = watch_utility_date_time_from_unix_time(timestamp, utc_offset);
+
+    // watch_utility_date_time_from_unix_time returns all zeros if the date is out of range.
+    calendar->valid = calendar->date_time.reg != 0;
+    if (!calendar->valid) {
+        calendar->day_of_year = 0;
+        calendar->iso_year = 0;
+        calendar->weekday = 0;
+        calendar->iso_week = 0;
+        return;
+    }
+
+    uint16_t year = calendar->date_time.unit.year + WATCH_RTC_REFERENCE_YEAR;
+    uint8_t month = calendar->date_time.unit.month;
+    uint8_t day = calendar->date_time.unit.day;
+
+    calendar->day_of_year = day;
+    for (uint8_t m = 1; m < month; m++) calendar->day_of_year += _watch_calendar_days_in_month(year, m);
+    calendar->weekday = watch_utility_get_iso8601_weekday_number(year, month, day);
+    _watch_calendar_update_iso_week(calendar);
+}
+
+void watch_calendar_update(watch_calendar_t *calendar, unix_timestamp_t timestamp, int32_t utc_offset) {
+    if (!calendar->valid) {
+        watch_calendar_set(calendar, timestamp, utc_offset);
+        return;
+    }
+
+    // how far the local time moved, taking a change of the UTC offset into account.
+    int32_t delta = (int32_t)(timestamp - calendar->timestamp) + (utc_offset - calendar->utc_offset);
+
+    if (delta < -WATCH_CALENDAR_SECONDS_PER_DAY || delta > WATCH_CALENDAR_SECONDS_PER_DAY) {
+        watch_calendar_set(calendar, timestamp, utc_offset);
+        return;
+    }
+
+    calendar->timestamp = timestamp;
+    calendar->utc_offset = utc_offset;
+
+    if (delta == 0) return;
+
+    watch_date_time_t *date_time = &calendar->date_time;
+    bool in_range = true;
+
+    if (delta == 1) {
+        // the common case: one tick of the 1 Hz interrupt. No divisions needed.
+        if (date_time->unit.second < 59) {
+            date_time->unit.second++;
+            return;
+        }
+        date_time->unit.second = 0;
+        if (date_time->unit.minute < 59) {
+            date_time->unit.minute++;
+            return;
+        }
+        date_time->unit.minute = 0;
+        if (date_time->unit.hour < 23) {
+            date_time->unit.hour++;
+            return;
+        }
+        date_time->unit.hour = 0;
+        in_range = _watch_calendar_next_day(calendar);
+    } else {
+        int32_t seconds = date_time->unit.hour * 3600 + date_time->unit.minute * 60 + date_time->unit.second + delta;
+
+        if (seconds >= WATCH_CALENDAR_SECONDS_PER_DAY) {
+            seconds -= WATCH_CALENDAR_SECONDS_PER_DAY;
+            in_range = _watch_calendar_next_day(calendar);
+        } else if (seconds < 0) {
+            seconds += WATCH_CALENDAR_SECONDS_PER_DAY;
+            in_range = _watch_calendar_previous_day(calendar);
+        }
+
+        date_time->unit.hour = seconds / 3600;
+        seconds -= date_time->unit.hour * 3600;
+        date_time->unit.minute = seconds / 60;
+        date_time->unit.second = seconds - date_time->unit.minute * 60;
+    }
+
+    // stepping past either end of the representable range; let the full conversion mark it invalid.
+    if (!in_range) watch_calendar_set(calendar, timestamp, utc_offset);
+}
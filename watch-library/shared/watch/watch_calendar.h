@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_CALENDAR_H_INCLUDED
+#define _WATCH_CALENDAR_H_INCLUDED
+////< @file watch_calendar.h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "watch_rtc.h"
+
+/** @addtogroup calendar Calendar
+  * @brief This section covers an incremental calendar that keeps a broken-down date and time in step
+  *        with a UNIX timestamp.
+  * @details Converting a UNIX timestamp into a date and time takes several 32-bit divisions and a loop
+  *          over the months, which is not cheap on a Cortex-M0+ without a hardware divider. The
+  *          calendar performs this full conversion only once, when it is first used or when the time
+  *          jumps by more than a day. Afterwards, it is advanced incrementally: a one-second step is a
+  *          handful of comparisons, and a day step updates the date together with the derived fields
+  *          (weekday, day of the year, ISO 8601 week). Changes in the UTC offset, e.g. at a daylight
+  *          saving time transition, are applied the same way.
+  */
+/// @{
+
+typedef struct {
+    watch_date_time_t date_time;    // broken-down date and time, offset by utc_offset
+    unix_timestamp_t timestamp;     // UTC timestamp the calendar currently represents
+    int32_t utc_offset;             // offset of date_time from UTC in seconds
+    uint16_t day_of_year;           // 1-366
+    uint16_t iso_year;              // ISO 8601 week-numbering year, e.g. 2026
+    uint8_t weekday;                // ISO 8601 weekday, 1 (Monday) to 7 (Sunday)
+    uint8_t iso_week;               // ISO 8601 week number, 1-53
+    bool valid;                     // false if the date is outside 2020-2083 or not yet set
+} watch_calendar_t;
+
+/** @brief Sets the calendar to the given timestamp using a full conversion.
+  * @param calendar The calendar to set.
+  * @param timestamp The UTC timestamp.
+  * @param utc_offset The number of seconds the calendar's date and time should be offset from UTC.
+  * @note If the date is outside the range representable by watch_date_time_t, the calendar is marked
+  *       invalid and its date_time is set to all zeros, just like watch_utility_date_time_from_unix_time.
+  */
+void watch_calendar_set(watch_calendar_t *calendar, unix_timestamp_t timestamp, int32_t utc_offset);
+
+/** @brief Brings the calendar up to date with the given timestamp and UTC offset.
+  * @details If the calendar is valid and the local time moved by at most one day in either direction,
+  *          the calendar is advanced incrementally. Otherwise, it falls back to watch_calendar_set.
+  * @param calendar The calendar to update.
+  * @param timestamp The UTC timestamp.
+  * @param utc_offset The number of seconds the calendar's date and time should be offset from UTC.
+  */
+void watch_calendar_update(watch_calendar_t *calendar, unix_timestamp_t timestamp, int32_t utc_offset);
+
+/// @}
+#endif
@@ -24,6 +24,7 @@
 
 #include "watch_slcd.h"
 #include "watch_common_display.h"
+#include "watch_common_glyphs.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -42,121 +43,208 @@ uint8_t IndicatorSegments[8] = {
     SLCD_SEGID(4, 0)   // WATCH_INDICATOR_COLON (does not exist, will set in SDATAL4 which is harmless)
 };
 
-void watch_display_character(uint8_t character, uint8_t position) {
+static const glyph_table_t *_glyph_table;
+
+void _watch_update_glyph_table(void) {
     if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        if (character == 'R' && position > 1 && position < 8) character = 'r'; // We can't display uppercase R in these positions
-        else if (character == 'T' && position > 1 && position < 8) character = 't'; // lowercase t is the only option for these positions
+        _glyph_table = &Custom_LCD_Glyph_Table;
     } else {
-        // special cases for positions 4 and 6
-        if (position == 4 || position == 6) {
-            if (character == '7') character = '&'; // "lowercase" 7
-            else if (character == 'A') character = 'a'; // A needs to be lowercase
-            else if (character == 'o') character = 'O'; // O needs to be uppercase
-            else if (character == 'L') character = '!'; // L needs to be in top half
-            else if (character == 'M' || character == 'm' || character == 'N') character = 'n'; // M and uppercase N need to be lowercase n
-            else if (character == 'c') character = 'C'; // C needs to be uppercase
-            else if (character == 'J') character = 'j'; // same
-            else if (character == 'v' || character == 'V' || character == 'U' || character == 'W' || character == 'w') character = 'u'; // bottom segment duplicated, so show in top half
-            else if (character == 't' || character == 'T') character = '+'; // avoid confusion with uppercase E
-        } else {
-            if (character == 'u') character = 'v'; // we can use the bottom segment; move to lower half
-            else if (character == 'j') character = 'J'; // same but just display a normal J
-            else if (character == '.') character = '_'; // we can use the bottom segment; make dot an underscore
-        }
-        if (position > 1) {
-            if (character == 'T') character = 't'; // uppercase T only works in positions 0 and 1
-        }
-        if (position == 1) {
-            if (character == 'a') character = 'A'; // A needs to be uppercase
-            else if (character == 'o') character = 'O'; // O needs to be uppercase
-            else if (character == 'i') character = 'l'; // I needs to be uppercase (use an l, it looks the same)
-            else if (character == 'n') character = 'N'; // N needs to be uppercase
-            else if (character == 'r') character = 'R'; // R needs to be uppercase
-            else if (character == 'd') character = 'D'; // D needs to be uppercase
-            else if (character == 'v' || character == 'V' || character == 'u') character = 'U'; // side segments shared, make uppercase
-            else if (character == 'b') character = 'B'; // B needs to be uppercase
-            else if (character == 'c') character = 'C'; // C needs to be uppercase
-        } else {
-            if (character == 'R') character = 'r'; // R needs to be lowercase almost everywhere
-        }
-        if (position == 0) {
-            watch_clear_pixel(0, 15); // clear funky ninth segment
-        } else {
-            if (character == 'I') character = 'l'; // uppercase I only works in position 0
-        }
+        _glyph_table = &Classic_LCD_Glyph_Table;
     }
+}
 
-    digit_mapping_t segmap;
-    uint8_t segdata;
+// Adds the pixels a character replaces in a position to mask, and the ones it lights to pixels.
+static bool _watch_glyph_pixels(uint8_t character, uint8_t position, uint32_t mask[GLYPH_NUM_COMS], uint32_t pixels[GLYPH_NUM_COMS]) {
+    // The table is normally picked when the LCD is discovered; this covers drawing before that.
+    if (_glyph_table == NULL) _watch_update_glyph_table();
+    if (position >= _glyph_table->num_positions) return false;
+    if (character < 0x20 || character > 0x7e) character = ' ';
 
-    /// TODO: This could be optimized by doing this check once and setting a pointer in watch_discover_lcd_type.
+    const glyph_position_t *glyph_position = &_glyph_table->position[position];
+    const segment_mapping_t *segment = glyph_position->segment;
+    uint16_t segdata = glyph_position->glyph[character - 0x20];
 
-    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        segmap = Custom_LCD_Display_Mapping[position];
-        segdata = Custom_LCD_Character_Set[character - 0x20];
-    } else {
-        segmap = Classic_LCD_Display_Mapping[position];
-        segdata = Classic_LCD_Character_Set[character - 0x20];
+    for (; segdata; segdata >>= 1, segment++) {
+        if (segdata & 1) pixels[segment->address.com] |= 1u << segment->address.seg;
+    }
+    for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) {
+        mask[com] |= glyph_position->mask[com];
     }
 
-    for (int i = 0; i < 8; i++) {
-        if (segmap.segment[i].value == segment_does_not_exist) {
-            // Segment does not exist; skip it.
-            segdata = segdata >> 1;
-            continue;
-        }
-        uint8_t com = segmap.segment[i].address.com;
-        uint8_t seg = segmap.segment[i].address.seg;
+    return true;
+}
 
-        if (segdata & 1) {
-            watch_set_pixel(com, seg);
-        }
-        else {
-            watch_clear_pixel(com, seg);
-        }
+void watch_display_character(uint8_t character, uint8_t position) {
+    uint32_t mask[GLYPH_NUM_COMS] = {0};
+    uint32_t pixels[GLYPH_NUM_COMS] = {0};
 
-        segdata = segdata >> 1;
-    }
+    if (!_watch_glyph_pixels(character, position, mask, pixels)) return;
 
-    if (character == 'T' && position == 1) watch_set_pixel(1, 12); // add descender
-    else if (position == 0 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 15); // add funky ninth segment
-    else if (position == 1 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 12); // add funky ninth segment
+    for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) {
+        if (mask[com] | pixels[com]) watch_update_pixels(com, mask[com], pixels[com]);
+    }
 }
 
 void watch_display_character_lp_seconds(uint8_t character, uint8_t position) {
-    // Will only work for digits and for positions  8 and 9 - but less code & checks to reduce power consumption
+    // With the substitutions baked into the glyph tables, this is as cheap as it gets.
+    watch_display_character(character, position);
+}
 
-    digit_mapping_t segmap;
-    uint8_t segdata;
+//////////////////////////////////////////////////////////////////////////////////////////
+// Animations
 
-    /// TODO: See optimization note above.
+watch_animation_t _watch_animation;
+// set by every frame the backends step, until watch_animation_take_wake is called.
+static volatile bool _watch_animation_stepped;
 
-    if (watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM) {
-        segmap = Custom_LCD_Display_Mapping[position];
-        segdata = Custom_LCD_Character_Set[character - 0x20];
-    } else {
-        segmap = Classic_LCD_Display_Mapping[position];
-        segdata = Classic_LCD_Character_Set[character - 0x20];
+static void _watch_animation_render(void) {
+    watch_animation_t *animation = &_watch_animation;
+
+    memset(animation->pixels, 0, sizeof(animation->pixels));
+    switch (animation->type) {
+        case WATCH_ANIMATION_BLINK:
+            // on in even steps, off in odd ones.
+            if (animation->step & 1) memcpy(animation->mask, animation->owned, sizeof(animation->mask));
+            else memset(animation->mask, 0, sizeof(animation->mask));
+            break;
+        case WATCH_ANIMATION_SPINNER:
+            memcpy(animation->mask, animation->owned, sizeof(animation->mask));
+            _watch_glyph_pixels(animation->text[animation->step], animation->position, animation->mask, animation->pixels);
+            break;
+        case WATCH_ANIMATION_MARQUEE:
+            // the text wraps around with a gap of three blanks; step is the index of the leftmost character.
+            memcpy(animation->mask, animation->owned, sizeof(animation->mask));
+            for (uint8_t i = 0; i < 6; i++) {
+                uint8_t index = (animation->step + i) % animation->num_steps;
+                _watch_glyph_pixels(animation->text[index], 4 + i, animation->mask, animation->pixels);
+            }
+            break;
+        case WATCH_ANIMATION_NONE:
+            memset(animation->mask, 0, sizeof(animation->mask));
+            break;
     }
+}
 
-    for (int i = 0; i < 8; i++) {
-        if (segmap.segment[i].value == segment_does_not_exist) {
-            // Segment does not exist; skip it.
-            segdata = segdata >> 1;
-            continue;
-        }
-        uint8_t com = segmap.segment[i].address.com;
-        uint8_t seg = segmap.segment[i].address.seg;
+void _watch_animation_step(void) {
+    if (_watch_animation.type == WATCH_ANIMATION_NONE) return;
+    _watch_animation.step = (_watch_animation.step + 1) % _watch_animation.num_steps;
+    _watch_animation_render();
+    _watch_animation_stepped = true;
+}
 
-        if (segdata & 1) {
-            watch_set_pixel(com, seg);
-        }
-        else {
-            watch_clear_pixel(com, seg);
-        }
+static void _watch_animation_begin(watch_animation_type_t type, uint8_t num_steps, uint32_t duration) {
+    _watch_animation.type = type;
+    _watch_animation.step = 0;
+    _watch_animation.num_steps = num_steps;
+    _watch_animation_render();
+    _watch_slcd_start_animation(duration);
+}
 
-        segdata = segdata >> 1;
+void watch_start_segment_blink(const uint32_t segments[4], uint32_t duration) {
+    watch_stop_animation();
+    memcpy(_watch_animation.owned, segments, sizeof(_watch_animation.owned));
+    _watch_animation_begin(WATCH_ANIMATION_BLINK, 2, duration);
+}
+
+void watch_start_text_blink(watch_position_t location, uint32_t duration) {
+    uint32_t segments[GLYPH_NUM_COMS] = {0};
+    uint32_t unused[GLYPH_NUM_COMS] = {0};
+    uint8_t first, last;
+    bool custom = watch_get_lcd_type() == WATCH_LCD_TYPE_CUSTOM;
+
+    switch (location) {
+        case WATCH_POSITION_TOP:
+            first = 0; last = 3;
+            break;
+        case WATCH_POSITION_TOP_LEFT:
+            first = 0; last = 1;
+            break;
+        case WATCH_POSITION_TOP_RIGHT:
+            first = 2; last = 3;
+            break;
+        case WATCH_POSITION_BOTTOM:
+            first = 4; last = 9;
+            // the leading 1 of the custom LCD's main line
+            if (custom) segments[0] |= 1u << 22;
+            break;
+        case WATCH_POSITION_HOURS:
+            first = 4; last = 5;
+            break;
+        case WATCH_POSITION_MINUTES:
+            first = 6; last = 7;
+            break;
+        case WATCH_POSITION_SECONDS:
+            first = 8; last = 9;
+            break;
+        case WATCH_POSITION_FULL:
+        default:
+            first = 0; last = 9;
+            break;
+    }
+
+    for (uint8_t position = first; position <= last; position++) {
+        _watch_glyph_pixels(' ', position, segments, unused);
+    }
+    // position 10 is the third character of the top left on the custom LCD.
+    if (custom && (location == WATCH_POSITION_TOP || location == WATCH_POSITION_TOP_LEFT || location == WATCH_POSITION_FULL)) {
+        _watch_glyph_pixels(' ', 10, segments, unused);
     }
+
+    watch_start_segment_blink(segments, duration);
+}
+
+void watch_start_spinner(uint8_t position, const char *frames, uint32_t duration) {
+    uint32_t unused[GLYPH_NUM_COMS] = {0};
+    size_t num_frames = strlen(frames);
+
+    watch_stop_animation();
+    if (num_frames == 0) return;
+    if (num_frames > WATCH_ANIMATION_MAX_FRAMES) num_frames = WATCH_ANIMATION_MAX_FRAMES;
+
+    memcpy(_watch_animation.text, frames, num_frames);
+    _watch_animation.text[num_frames] = 0;
+    _watch_animation.position = position;
+    // the spinner owns the position and anything its characters light outside of it.
+    for (size_t i = 0; i < num_frames; i++) {
+        _watch_glyph_pixels(frames[i], position, _watch_animation.owned, unused);
+    }
+    for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) _watch_animation.owned[com] |= unused[com];
+
+    _watch_animation_begin(WATCH_ANIMATION_SPINNER, num_frames, duration);
+}
+
+void watch_start_marquee(const char *text, uint32_t duration) {
+    uint32_t unused[GLYPH_NUM_COMS] = {0};
+    size_t length = strlen(text);
+
+    watch_stop_animation();
+    if (length > WATCH_ANIMATION_MAX_TEXT) length = WATCH_ANIMATION_MAX_TEXT;
+
+    // three blanks separate the end of the text from its start.
+    memcpy(_watch_animation.text, text, length);
+    memset(_watch_animation.text + length, ' ', 3);
+    _watch_animation.text[length + 3] = 0;
+    for (uint8_t position = 4; position <= 9; position++) {
+        _watch_glyph_pixels(' ', position, _watch_animation.owned, unused);
+    }
+
+    _watch_animation_begin(WATCH_ANIMATION_MARQUEE, length + 3, duration);
+}
+
+void watch_stop_animation(void) {
+    if (_watch_animation.type == WATCH_ANIMATION_NONE) return;
+    _watch_slcd_stop_animation();
+    memset(&_watch_animation, 0, sizeof(_watch_animation));
+}
+
+bool watch_animation_is_running(void) {
+    return _watch_animation.type != WATCH_ANIMATION_NONE;
+}
+
+bool watch_animation_take_wake(void) {
+    bool stepped = _watch_animation_stepped;
+    _watch_animation_stepped = false;
+    return stepped;
 }
 
 void watch_display_string(const char *string, uint8_t position) {
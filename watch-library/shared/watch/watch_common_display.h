@@ -506,7 +506,68 @@ static const digit_mapping_t Classic_LCD_Display_Mapping[] = {
     },
 };
 
+// Glyph tables, one per LCD type. For every position, they list the pixels a character replaces and, for
+// every printable character, the segments that draw it there, with all of the position-specific
+// substitutions (lowercase 7, lowercase r, the funky ninth segment, ...) already applied. The tables live in
+// watch_common_glyphs.h, which utils/glyph_tables generates from the character sets and mappings above.
+#define GLYPH_NUM_COMS (4)
+#define GLYPH_NUM_SEGMENTS (10)
+#define GLYPH_NUM_CHARACTERS (95) // 0x20 to 0x7e
+#define GLYPH_MAX_POSITIONS (11)
+
+typedef struct glyph_position_t {
+    uint32_t mask[GLYPH_NUM_COMS];                  // pixels replaced by any character, per COM
+    segment_mapping_t segment[GLYPH_NUM_SEGMENTS];  // segments A-H, then pixels outside the digit
+    uint16_t glyph[GLYPH_NUM_CHARACTERS];           // bit i lights segment[i]
+} glyph_position_t;
+
+typedef struct glyph_table_t {
+    uint8_t num_positions;
+    glyph_position_t position[GLYPH_MAX_POSITIONS];
+} glyph_table_t;
+
+// State of the animation engine (see watch_start_segment_blink). The frames are rendered by the common display
+// code; the backends step them with _watch_animation_step and merge the current frame over what is drawn.
+#define WATCH_ANIMATION_MAX_TEXT (32)  // marquee text, not counting the three blanks that separate its end from its start
+#define WATCH_ANIMATION_MAX_FRAMES (8)
+
+typedef enum {
+    WATCH_ANIMATION_NONE = 0,
+    WATCH_ANIMATION_BLINK,
+    WATCH_ANIMATION_SPINNER,
+    WATCH_ANIMATION_MARQUEE,
+} watch_animation_type_t;
+
+typedef struct watch_animation_t {
+    watch_animation_type_t type;
+    uint32_t owned[GLYPH_NUM_COMS];     // segments the animation draws on
+    uint32_t mask[GLYPH_NUM_COMS];      // segments the current frame replaces
+    uint32_t pixels[GLYPH_NUM_COMS];    // segments the current frame lights
+    uint8_t position;
+    uint8_t step;
+    uint8_t num_steps;
+    char text[WATCH_ANIMATION_MAX_TEXT + 3 + 1];
+} watch_animation_t;
+
+extern watch_animation_t _watch_animation;
+
+/// @brief Returns what the LCD shows on a COM line for a drawn value, with the current animation frame applied.
+static inline uint32_t _watch_animation_merge(uint8_t com, uint32_t value) {
+    if (com >= GLYPH_NUM_COMS) return value;
+    return (value & ~_watch_animation.mask[com]) | _watch_animation.pixels[com];
+}
+
+/// @brief Advances the running animation to its next frame. Called by the backends, possibly from an interrupt.
+void _watch_animation_step(void);
+
+/// @brief Backend: starts stepping the animation every duration ms. The first frame is already rendered.
+void _watch_slcd_start_animation(uint32_t duration);
+
+/// @brief Backend: stops stepping the animation, so that its segments show what is drawn again.
+void _watch_slcd_stop_animation(void);
+
 void watch_display_character(uint8_t character, uint8_t position);
 void watch_display_character_lp_seconds(uint8_t character, uint8_t position);
 
 void _watch_update_indicator_segments(void);
+void _watch_update_glyph_table(void);
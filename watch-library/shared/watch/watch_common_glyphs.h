@@ -0,0 +1,528 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Generated by utils/glyph_tables from the character sets and mappings in watch_common_display.h and
+// the substitutions in utils/glyph_tables/legacy_display.c. Do not edit; run `make generate` there.
+
+#ifndef _WATCH_COMMON_GLYPHS_H_INCLUDED
+#define _WATCH_COMMON_GLYPHS_H_INCLUDED
+
+#include "watch_common_display.h"
+
+static const glyph_table_t Classic_LCD_Glyph_Table = {
+    .num_positions = 10,
+    .position = {
+        {   // position 0
+            .mask = { 0x0000e000, 0x0000e000, 0x0000e000, 0x00000000 },
+            .segment = {
+                { .address = { .com = 0, .seg = 13 } },
+                { .address = { .com = 1, .seg = 13 } },
+                { .address = { .com = 2, .seg = 13 } },
+                { .address = { .com = 2, .seg = 15 } },
+                { .address = { .com = 2, .seg = 14 } },
+                { .address = { .com = 0, .seg = 14 } },
+                { .address = { .com = 1, .seg = 15 } },
+                { .address = { .com = 1, .seg = 14 } },
+                { .address = { .com = 0, .seg = 15 } },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x060, 0x022, 0x063, 0x02d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x0c0, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x1ff, 0x077, 0x17f, 0x039, 0x13f, 0x079, 0x071, 0x03d, 0x076, 0x089, 0x00e, 0x075, 0x038, 0x0b7, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x081, 0x03e, 0x03e, 0x0be, 0x07e, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x0b7, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x0be, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 1
+            .mask = { 0x00001800, 0x00001800, 0x00001800, 0x00000000 },
+            .segment = {
+                { .address = { .com = 0, .seg = 11 } },
+                { .address = { .com = 1, .seg = 11 } },
+                { .address = { .com = 1, .seg = 11 } },
+                { .address = { .com = 2, .seg = 11 } },
+                { .address = { .com = 1, .seg = 12 } },
+                { .address = { .com = 1, .seg = 12 } },
+                { .address = { .com = 2, .seg = 12 } },
+                { .address = { .com = 0, .seg = 12 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x050, 0x010, 0x051, 0x01b, 0x000, 0x042, 0x010, 0x019, 0x00b, 0x0c0, 0x050, 0x002, 0x040, 0x008, 0x000, // 0x20-0x2f
+                0x01b, 0x002, 0x049, 0x04b, 0x052, 0x05b, 0x05b, 0x003, 0x05b, 0x05b, 0x000, 0x000, 0x048, 0x048, 0x04a, 0x041, // 0x30-0x3f
+                0x0db, 0x053, 0x0db, 0x019, 0x09b, 0x059, 0x051, 0x01b, 0x052, 0x010, 0x00a, 0x053, 0x018, 0x093, 0x013, 0x01b, // 0x40-0x4f
+                0x051, 0x053, 0x0d3, 0x05b, 0x091, 0x01a, 0x01a, 0x09a, 0x05a, 0x05a, 0x009, 0x019, 0x012, 0x00b, 0x011, 0x008, // 0x50-0x5f
+                0x000, 0x053, 0x0db, 0x019, 0x09b, 0x059, 0x051, 0x05b, 0x052, 0x010, 0x00a, 0x053, 0x010, 0x093, 0x013, 0x01b, // 0x60-0x6f
+                0x051, 0x053, 0x0d3, 0x05b, 0x058, 0x01a, 0x01a, 0x09a, 0x05a, 0x05a, 0x009, 0x002, 0x012, 0x012, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 2
+            .mask = { 0x00000600, 0x00000200, 0x00000200, 0x00000000 },
+            .segment = {
+                { .address = { .com = 1, .seg =  9 } },
+                { .address = { .com = 0, .seg =  9 } },
+                { .address = { .com = 2, .seg =  9 } },
+                { .address = { .com = 1, .seg =  9 } },
+                { .address = { .com = 0, .seg = 10 } },
+                { .value = segment_does_not_exist },
+                { .address = { .com = 1, .seg =  9 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x001, 0x002, 0x003, 0x004, 0x000, 0x005, 0x000, 0x010, 0x006, 0x001, 0x011, 0x004, 0x001, 0x000, 0x012, // 0x20-0x2f
+                0x016, 0x006, 0x013, 0x007, 0x007, 0x005, 0x015, 0x006, 0x017, 0x007, 0x000, 0x000, 0x011, 0x001, 0x005, 0x013, // 0x30-0x3f
+                0x017, 0x017, 0x017, 0x010, 0x016, 0x011, 0x011, 0x014, 0x017, 0x010, 0x006, 0x015, 0x010, 0x016, 0x016, 0x016, // 0x40-0x4f
+                0x013, 0x007, 0x011, 0x005, 0x011, 0x016, 0x016, 0x016, 0x017, 0x007, 0x012, 0x010, 0x004, 0x006, 0x002, 0x000, // 0x50-0x5f
+                0x002, 0x017, 0x015, 0x011, 0x017, 0x013, 0x011, 0x007, 0x015, 0x010, 0x006, 0x015, 0x010, 0x016, 0x015, 0x015, // 0x60-0x6f
+                0x013, 0x007, 0x011, 0x005, 0x011, 0x014, 0x014, 0x016, 0x017, 0x007, 0x012, 0x016, 0x016, 0x014, 0x000, // 0x70-0x7e
+            },
+        },
+        {   // position 3
+            .mask = { 0x00000180, 0x00000180, 0x000001c0, 0x00000000 },
+            .segment = {
+                { .address = { .com = 0, .seg =  7 } },
+                { .address = { .com = 1, .seg =  7 } },
+                { .address = { .com = 2, .seg =  7 } },
+                { .address = { .com = 2, .seg =  6 } },
+                { .address = { .com = 2, .seg =  8 } },
+                { .address = { .com = 0, .seg =  8 } },
+                { .address = { .com = 1, .seg =  8 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x060, 0x022, 0x063, 0x02d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x07f, 0x039, 0x03f, 0x079, 0x071, 0x03d, 0x076, 0x030, 0x00e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x07e, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 4
+            .mask = { 0x000c0000, 0x000c0000, 0x000c0000, 0x00000000 },
+            .segment = {
+                { .address = { .com = 1, .seg = 18 } },
+                { .address = { .com = 2, .seg = 19 } },
+                { .address = { .com = 0, .seg = 19 } },
+                { .address = { .com = 1, .seg = 18 } },
+                { .address = { .com = 0, .seg = 18 } },
+                { .address = { .com = 2, .seg = 18 } },
+                { .address = { .com = 1, .seg = 19 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x060, 0x022, 0x062, 0x025, 0x000, 0x044, 0x020, 0x031, 0x007, 0x040, 0x070, 0x004, 0x040, 0x040, 0x012, // 0x20-0x2f
+                0x037, 0x006, 0x053, 0x047, 0x066, 0x065, 0x075, 0x044, 0x077, 0x067, 0x000, 0x000, 0x051, 0x041, 0x045, 0x052, // 0x30-0x3f
+                0x077, 0x057, 0x077, 0x031, 0x037, 0x071, 0x070, 0x035, 0x076, 0x030, 0x042, 0x074, 0x060, 0x054, 0x054, 0x037, // 0x40-0x4f
+                0x072, 0x066, 0x050, 0x065, 0x070, 0x062, 0x062, 0x062, 0x077, 0x067, 0x013, 0x031, 0x024, 0x007, 0x022, 0x001, // 0x50-0x5f
+                0x002, 0x057, 0x075, 0x031, 0x057, 0x073, 0x070, 0x067, 0x074, 0x010, 0x042, 0x074, 0x030, 0x054, 0x054, 0x037, // 0x60-0x6f
+                0x072, 0x066, 0x050, 0x065, 0x070, 0x062, 0x062, 0x062, 0x077, 0x067, 0x013, 0x016, 0x036, 0x034, 0x000, // 0x70-0x7e
+            },
+        },
+        {   // position 5
+            .mask = { 0x00300000, 0x00320000, 0x00300000, 0x00000000 },
+            .segment = {
+                { .address = { .com = 2, .seg = 20 } },
+                { .address = { .com = 2, .seg = 21 } },
+                { .address = { .com = 1, .seg = 21 } },
+                { .address = { .com = 0, .seg = 21 } },
+                { .address = { .com = 0, .seg = 20 } },
+                { .address = { .com = 1, .seg = 17 } },
+                { .address = { .com = 1, .seg = 20 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x060, 0x022, 0x063, 0x02d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x07f, 0x039, 0x03f, 0x079, 0x071, 0x03d, 0x076, 0x030, 0x00e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x07e, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 6
+            .mask = { 0x00c00000, 0x00c00000, 0x00c00000, 0x00000000 },
+            .segment = {
+                { .address = { .com = 0, .seg = 22 } },
+                { .address = { .com = 2, .seg = 23 } },
+                { .address = { .com = 0, .seg = 23 } },
+                { .address = { .com = 0, .seg = 22 } },
+                { .address = { .com = 1, .seg = 22 } },
+                { .address = { .com = 2, .seg = 22 } },
+                { .address = { .com = 1, .seg = 23 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x060, 0x022, 0x062, 0x025, 0x000, 0x044, 0x020, 0x031, 0x007, 0x040, 0x070, 0x004, 0x040, 0x040, 0x012, // 0x20-0x2f
+                0x037, 0x006, 0x053, 0x047, 0x066, 0x065, 0x075, 0x044, 0x077, 0x067, 0x000, 0x000, 0x051, 0x041, 0x045, 0x052, // 0x30-0x3f
+                0x077, 0x057, 0x077, 0x031, 0x037, 0x071, 0x070, 0x035, 0x076, 0x030, 0x042, 0x074, 0x060, 0x054, 0x054, 0x037, // 0x40-0x4f
+                0x072, 0x066, 0x050, 0x065, 0x070, 0x062, 0x062, 0x062, 0x077, 0x067, 0x013, 0x031, 0x024, 0x007, 0x022, 0x001, // 0x50-0x5f
+                0x002, 0x057, 0x075, 0x031, 0x057, 0x073, 0x070, 0x067, 0x074, 0x010, 0x042, 0x074, 0x030, 0x054, 0x054, 0x037, // 0x60-0x6f
+                0x072, 0x066, 0x050, 0x065, 0x070, 0x062, 0x062, 0x062, 0x077, 0x067, 0x013, 0x016, 0x036, 0x034, 0x000, // 0x70-0x7e
+            },
+        },
+        {   // position 7
+            .mask = { 0x00000003, 0x00000003, 0x00000403, 0x00000000 },
+            .segment = {
+                { .address = { .com = 2, .seg =  1 } },
+                { .address = { .com = 2, .seg = 10 } },
+                { .address = { .com = 0, .seg =  1 } },
+                { .address = { .com = 0, .seg =  0 } },
+                { .address = { .com = 1, .seg =  0 } },
+                { .address = { .com = 2, .seg =  0 } },
+                { .address = { .com = 1, .seg =  1 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x060, 0x022, 0x063, 0x02d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x07f, 0x039, 0x03f, 0x079, 0x071, 0x03d, 0x076, 0x030, 0x00e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x07e, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 8
+            .mask = { 0x0000001c, 0x0000000c, 0x0000000c, 0x00000000 },
+            .segment = {
+                { .address = { .com = 2, .seg =  2 } },
+                { .address = { .com = 2, .seg =  3 } },
+                { .address = { .com = 0, .seg =  4 } },
+                { .address = { .com = 0, .seg =  3 } },
+                { .address = { .com = 0, .seg =  2 } },
+                { .address = { .com = 1, .seg =  2 } },
+                { .address = { .com = 1, .seg =  3 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x060, 0x022, 0x063, 0x02d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x07f, 0x039, 0x03f, 0x079, 0x071, 0x03d, 0x076, 0x030, 0x00e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x07e, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 9
+            .mask = { 0x00000060, 0x00000070, 0x00000030, 0x00000000 },
+            .segment = {
+                { .address = { .com = 2, .seg =  4 } },
+                { .address = { .com = 2, .seg =  5 } },
+                { .address = { .com = 1, .seg =  6 } },
+                { .address = { .com = 0, .seg =  6 } },
+                { .address = { .com = 0, .seg =  5 } },
+                { .address = { .com = 1, .seg =  4 } },
+                { .address = { .com = 1, .seg =  5 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x060, 0x022, 0x063, 0x02d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x07f, 0x039, 0x03f, 0x079, 0x071, 0x03d, 0x076, 0x030, 0x00e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x07e, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+    },
+};
+
+static const glyph_table_t Custom_LCD_Glyph_Table = {
+    .num_positions = 11,
+    .position = {
+        {   // position 0
+            .mask = { 0x00180000, 0x00180000, 0x00180000, 0x00180000 },
+            .segment = {
+                { .address = { .com = 0, .seg = 19 } },
+                { .address = { .com = 2, .seg = 19 } },
+                { .address = { .com = 3, .seg = 19 } },
+                { .address = { .com = 3, .seg = 20 } },
+                { .address = { .com = 2, .seg = 20 } },
+                { .address = { .com = 0, .seg = 20 } },
+                { .address = { .com = 1, .seg = 20 } },
+                { .address = { .com = 1, .seg = 19 } },
+                { .address = { .com = 0, .seg = 15 } },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x0ed, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x0c0, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x1ff, 0x077, 0x1cf, 0x039, 0x18f, 0x079, 0x071, 0x03d, 0x076, 0x089, 0x01e, 0x075, 0x038, 0x0b7, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x0c7, 0x06d, 0x081, 0x03e, 0x03e, 0x0be, 0x0f6, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x0b7, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x0be, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 1
+            .mask = { 0x00060000, 0x00060000, 0x00060000, 0x00060000 },
+            .segment = {
+                { .address = { .com = 0, .seg = 17 } },
+                { .address = { .com = 2, .seg = 17 } },
+                { .address = { .com = 3, .seg = 17 } },
+                { .address = { .com = 3, .seg = 18 } },
+                { .address = { .com = 2, .seg = 18 } },
+                { .address = { .com = 0, .seg = 18 } },
+                { .address = { .com = 1, .seg = 18 } },
+                { .address = { .com = 1, .seg = 17 } },
+                { .address = { .com = 0, .seg = 12 } },
+                { .address = { .com = 1, .seg = 12 } },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x0ed, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x0c0, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x1ff, 0x077, 0x1cf, 0x039, 0x18f, 0x079, 0x071, 0x03d, 0x076, 0x089, 0x01e, 0x075, 0x038, 0x0b7, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x0c7, 0x06d, 0x281, 0x03e, 0x03e, 0x0be, 0x0f6, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x0b7, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x0be, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 2
+            .mask = { 0x00000c00, 0x00000c00, 0x00000c00, 0x00000800 },
+            .segment = {
+                { .address = { .com = 0, .seg = 11 } },
+                { .address = { .com = 0, .seg = 10 } },
+                { .address = { .com = 2, .seg = 10 } },
+                { .address = { .com = 3, .seg = 11 } },
+                { .address = { .com = 2, .seg = 11 } },
+                { .address = { .com = 1, .seg = 11 } },
+                { .address = { .com = 1, .seg = 10 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x06d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x04f, 0x039, 0x00f, 0x079, 0x071, 0x03d, 0x076, 0x009, 0x01e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x076, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 3
+            .mask = { 0x00000300, 0x00000300, 0x00000300, 0x00000200 },
+            .segment = {
+                { .address = { .com = 0, .seg =  9 } },
+                { .address = { .com = 0, .seg =  8 } },
+                { .address = { .com = 2, .seg =  8 } },
+                { .address = { .com = 3, .seg =  9 } },
+                { .address = { .com = 2, .seg =  9 } },
+                { .address = { .com = 1, .seg =  9 } },
+                { .address = { .com = 1, .seg =  8 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x06d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x04f, 0x039, 0x00f, 0x079, 0x071, 0x03d, 0x076, 0x009, 0x01e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x076, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 4
+            .mask = { 0x00010000, 0x00410000, 0x00410000, 0x00410000 },
+            .segment = {
+                { .address = { .com = 3, .seg = 16 } },
+                { .address = { .com = 2, .seg = 16 } },
+                { .address = { .com = 1, .seg = 16 } },
+                { .address = { .com = 0, .seg = 16 } },
+                { .address = { .com = 1, .seg = 22 } },
+                { .address = { .com = 3, .seg = 22 } },
+                { .address = { .com = 2, .seg = 22 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x06d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x04f, 0x039, 0x00f, 0x079, 0x071, 0x03d, 0x076, 0x009, 0x01e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x076, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 5
+            .mask = { 0x00008000, 0x0000c000, 0x0000c000, 0x0000c000 },
+            .segment = {
+                { .address = { .com = 3, .seg = 14 } },
+                { .address = { .com = 2, .seg = 14 } },
+                { .address = { .com = 1, .seg = 14 } },
+                { .address = { .com = 0, .seg = 15 } },
+                { .address = { .com = 1, .seg = 15 } },
+                { .address = { .com = 3, .seg = 15 } },
+                { .address = { .com = 2, .seg = 15 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x06d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x04f, 0x039, 0x00f, 0x079, 0x071, 0x03d, 0x076, 0x009, 0x01e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x076, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 6
+            .mask = { 0x00000006, 0x00000006, 0x00000006, 0x00000002 },
+            .segment = {
+                { .address = { .com = 3, .seg =  1 } },
+                { .address = { .com = 2, .seg =  2 } },
+                { .address = { .com = 0, .seg =  2 } },
+                { .address = { .com = 0, .seg =  1 } },
+                { .address = { .com = 1, .seg =  1 } },
+                { .address = { .com = 2, .seg =  1 } },
+                { .address = { .com = 1, .seg =  2 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x06d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x04f, 0x039, 0x00f, 0x079, 0x071, 0x03d, 0x076, 0x009, 0x01e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x076, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 7
+            .mask = { 0x00000018, 0x00000018, 0x00000018, 0x00000008 },
+            .segment = {
+                { .address = { .com = 3, .seg =  3 } },
+                { .address = { .com = 2, .seg =  4 } },
+                { .address = { .com = 0, .seg =  4 } },
+                { .address = { .com = 0, .seg =  3 } },
+                { .address = { .com = 1, .seg =  3 } },
+                { .address = { .com = 2, .seg =  3 } },
+                { .address = { .com = 1, .seg =  4 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x06d, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x040, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x07f, 0x077, 0x04f, 0x039, 0x00f, 0x079, 0x071, 0x03d, 0x076, 0x009, 0x01e, 0x075, 0x038, 0x037, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x03e, 0x03e, 0x03e, 0x076, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x037, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x03e, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 8
+            .mask = { 0x00000020, 0x00000020, 0x00000020, 0x00000534 },
+            .segment = {
+                { .address = { .com = 3, .seg = 10 } },
+                { .address = { .com = 3, .seg =  8 } },
+                { .address = { .com = 0, .seg =  5 } },
+                { .address = { .com = 1, .seg =  5 } },
+                { .address = { .com = 3, .seg =  4 } },
+                { .address = { .com = 3, .seg =  2 } },
+                { .address = { .com = 2, .seg =  5 } },
+                { .address = { .com = 3, .seg =  5 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x0ed, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x0c0, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x0ff, 0x077, 0x0cf, 0x039, 0x08f, 0x079, 0x071, 0x03d, 0x076, 0x089, 0x01e, 0x075, 0x038, 0x0b7, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x0c7, 0x06d, 0x081, 0x03e, 0x03e, 0x0be, 0x0f6, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x0b7, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x0be, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 9
+            .mask = { 0x000000c0, 0x000000c0, 0x000000c0, 0x000000c0 },
+            .segment = {
+                { .address = { .com = 3, .seg =  6 } },
+                { .address = { .com = 3, .seg =  7 } },
+                { .address = { .com = 2, .seg =  7 } },
+                { .address = { .com = 0, .seg =  7 } },
+                { .address = { .com = 0, .seg =  6 } },
+                { .address = { .com = 2, .seg =  6 } },
+                { .address = { .com = 1, .seg =  6 } },
+                { .address = { .com = 1, .seg =  7 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x0ed, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x0c0, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x0ff, 0x077, 0x0cf, 0x039, 0x08f, 0x079, 0x071, 0x03d, 0x076, 0x089, 0x01e, 0x075, 0x038, 0x0b7, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x0c7, 0x06d, 0x081, 0x03e, 0x03e, 0x0be, 0x0f6, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x0b7, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x0be, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+        {   // position 10
+            .mask = { 0x00003000, 0x00003000, 0x00003000, 0x00003000 },
+            .segment = {
+                { .address = { .com = 0, .seg = 12 } },
+                { .address = { .com = 2, .seg = 12 } },
+                { .address = { .com = 3, .seg = 12 } },
+                { .address = { .com = 3, .seg = 13 } },
+                { .address = { .com = 2, .seg = 13 } },
+                { .address = { .com = 0, .seg = 13 } },
+                { .address = { .com = 1, .seg = 13 } },
+                { .address = { .com = 1, .seg = 12 } },
+                { .value = segment_does_not_exist },
+                { .value = segment_does_not_exist },
+            },
+            .glyph = {
+                0x000, 0x03c, 0x022, 0x063, 0x0ed, 0x000, 0x044, 0x020, 0x039, 0x00f, 0x0c0, 0x070, 0x004, 0x040, 0x008, 0x012, // 0x20-0x2f
+                0x03f, 0x006, 0x05b, 0x04f, 0x066, 0x06d, 0x07d, 0x007, 0x07f, 0x06f, 0x000, 0x000, 0x058, 0x048, 0x04c, 0x053, // 0x30-0x3f
+                0x0ff, 0x077, 0x0cf, 0x039, 0x08f, 0x079, 0x071, 0x03d, 0x076, 0x089, 0x01e, 0x075, 0x038, 0x0b7, 0x037, 0x03f, // 0x40-0x4f
+                0x073, 0x067, 0x0c7, 0x06d, 0x081, 0x03e, 0x03e, 0x0be, 0x0f6, 0x06e, 0x01b, 0x039, 0x024, 0x00f, 0x023, 0x008, // 0x50-0x5f
+                0x002, 0x05f, 0x07c, 0x058, 0x05e, 0x07b, 0x071, 0x06f, 0x074, 0x010, 0x00e, 0x075, 0x030, 0x0b7, 0x054, 0x05c, // 0x60-0x6f
+                0x073, 0x067, 0x050, 0x06d, 0x078, 0x01c, 0x01c, 0x0be, 0x07e, 0x06e, 0x01b, 0x016, 0x036, 0x034, 0x001, // 0x70-0x7e
+            },
+        },
+    },
+};
+
+#endif
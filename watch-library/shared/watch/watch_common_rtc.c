@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+
+#include "watch_rtc.h"
+
+#if !(__EMSCRIPTEN__ || defined(WATCH_NATIVE))
+#include "sam.h"
+#endif
+
+/* Software timers share the comp callback WATCH_RTC_TIMER_COMP_INDEX. The active timers are kept in an intrusive
+ * list sorted by deadline, so the comparator only ever needs to be armed for the head of the list. Timers are
+ * owned by the caller, so there is no limit on how many can be active at once.
+ */
+static watch_rtc_timer_t *_timers;
+
+// timers are started and stopped from the main loop as well as from the RTC interrupt.
+typedef uint32_t _watch_rtc_timer_lock_t;
+
+#if __EMSCRIPTEN__ || defined(WATCH_NATIVE)
+static inline _watch_rtc_timer_lock_t _watch_rtc_timer_lock(void) { return 0; }
+static inline void _watch_rtc_timer_unlock(_watch_rtc_timer_lock_t lock) { (void)lock; }
+#else
+static inline _watch_rtc_timer_lock_t _watch_rtc_timer_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+static inline void _watch_rtc_timer_unlock(_watch_rtc_timer_lock_t lock) {
+    __set_PRIMASK(lock);
+}
+#endif
+
+static void _watch_rtc_timer_fire(void);
+
+static inline bool _watch_rtc_timer_is_due(rtc_counter_t deadline, rtc_counter_t counter) {
+    return (int32_t)(deadline - counter) <= 0;
+}
+
+static void _watch_rtc_timer_arm(void) {
+    if (_timers != NULL) {
+        watch_rtc_register_comp_callback(_watch_rtc_timer_fire, _timers->deadline, WATCH_RTC_TIMER_COMP_INDEX);
+    } else {
+        watch_rtc_disable_comp_callback(WATCH_RTC_TIMER_COMP_INDEX);
+    }
+}
+
+static void _watch_rtc_timer_unlink(watch_rtc_timer_t *timer) {
+    for (watch_rtc_timer_t **link = &_timers; *link != NULL; link = &(*link)->next) {
+        if (*link == timer) {
+            *link = timer->next;
+            break;
+        }
+    }
+    timer->next = NULL;
+    timer->active = false;
+}
+
+static void _watch_rtc_timer_insert(watch_rtc_timer_t *timer) {
+    watch_rtc_timer_t **link = &_timers;
+
+    // timers with the same deadline fire in the order in which they were started.
+    while (*link != NULL && (int32_t)((*link)->deadline - timer->deadline) <= 0) {
+        link = &(*link)->next;
+    }
+    timer->next = *link;
+    *link = timer;
+    timer->active = true;
+}
+
+static void _watch_rtc_timer_fire(void) {
+    rtc_counter_t counter = watch_rtc_get_counter();
+
+    while (_timers != NULL && _watch_rtc_timer_is_due(_timers->deadline, counter)) {
+        watch_rtc_timer_t *timer = _timers;
+        _timers = timer->next;
+        timer->next = NULL;
+        timer->active = false;
+
+        if (timer->period) {
+            // if we fell behind, skip the missed periods instead of firing in a burst.
+            do {
+                timer->deadline += timer->period;
+            } while (_watch_rtc_timer_is_due(timer->deadline, counter));
+            _watch_rtc_timer_insert(timer);
+        }
+
+        // the callback may stop or restart this or any other timer.
+        if (timer->callback != NULL) timer->callback(timer);
+    }
+
+    _watch_rtc_timer_arm();
+}
+
+void watch_rtc_timer_start(watch_rtc_timer_t *timer, watch_rtc_timer_cb_t callback, void *context, rtc_counter_t deadline, rtc_counter_t period) {
+    _watch_rtc_timer_lock_t lock = _watch_rtc_timer_lock();
+
+    if (timer->active) _watch_rtc_timer_unlink(timer);
+
+    // the comparator cannot fire in the past, so anything that is already due fires on the next tick.
+    rtc_counter_t counter = watch_rtc_get_counter();
+    if (_watch_rtc_timer_is_due(deadline, counter)) deadline = counter + 1;
+
+    timer->callback = callback;
+    timer->context = context;
+    timer->deadline = deadline;
+    timer->period = period;
+    _watch_rtc_timer_insert(timer);
+
+    if (_timers == timer) _watch_rtc_timer_arm();
+
+    _watch_rtc_timer_unlock(lock);
+}
+
+void watch_rtc_timer_stop(watch_rtc_timer_t *timer) {
+    _watch_rtc_timer_lock_t lock = _watch_rtc_timer_lock();
+
+    if (timer->active) {
+        bool was_first = _timers == timer;
+        _watch_rtc_timer_unlink(timer);
+        if (was_first) _watch_rtc_timer_arm();
+    }
+
+    _watch_rtc_timer_unlock(lock);
+}
+
+bool watch_rtc_timer_is_active(watch_rtc_timer_t *timer) {
+    return timer->active;
+}
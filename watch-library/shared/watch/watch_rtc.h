@@ -146,6 +146,50 @@ void watch_rtc_disable_comp_callback_no_schedule(uint8_t index);
   */
 void watch_rtc_schedule_next_comp(void);
 
+/** @brief The comp callback index used by the software timers below. Do not register other callbacks on it.
+  */
+#define WATCH_RTC_TIMER_COMP_INDEX 7
+
+typedef struct watch_rtc_timer watch_rtc_timer_t;
+
+/** @brief Typedef for a software timer callback. The timer is passed back, so one callback can serve several timers.
+  */
+typedef void (*watch_rtc_timer_cb_t)(watch_rtc_timer_t *timer);
+
+/** @brief A software timer. The storage is owned by the caller and must stay valid while the timer is active.
+  *        A zeroed timer is a valid, stopped timer. Do not modify the fields directly.
+  */
+struct watch_rtc_timer {
+    watch_rtc_timer_t *next;
+    watch_rtc_timer_cb_t callback;
+    void *context;                  ///< Free for use by the owner of the timer.
+    volatile rtc_counter_t deadline;
+    rtc_counter_t period;
+    volatile bool active;
+};
+
+/** @brief Starts a one-shot or periodic software timer.
+  * @param timer The timer to start. If it is already active, it is restarted with the new parameters.
+  * @param callback The function to call when the timer expires. It is called from the RTC interrupt.
+  * @param context A pointer that is stored in the timer for use by the callback.
+  * @param deadline The counter value at which the timer should first expire. Deadlines that have already passed
+  *                 expire on the next tick.
+  * @param period The period in counter ticks for a periodic timer, or 0 for a one-shot timer.
+  * @details Any number of software timers can be active at the same time. They are kept sorted by deadline and
+  *          share a single comp callback, so each expiration costs one comparator interrupt, and starting or
+  *          stopping a timer does not touch the other comp callbacks. A periodic timer that falls behind skips
+  *          the missed periods rather than firing several times in a row.
+  */
+void watch_rtc_timer_start(watch_rtc_timer_t *timer, watch_rtc_timer_cb_t callback, void *context, rtc_counter_t deadline, rtc_counter_t period);
+
+/** @brief Stops a software timer. Stopping a timer that is not active has no effect.
+  */
+void watch_rtc_timer_stop(watch_rtc_timer_t *timer);
+
+/** @brief Returns true if the timer is waiting to expire.
+  */
+bool watch_rtc_timer_is_active(watch_rtc_timer_t *timer);
+
 /** @brief Disables the alarm callback.
   */
 // void watch_rtc_disable_alarm_callback(void);
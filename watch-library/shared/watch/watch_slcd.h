@@ -104,6 +104,8 @@ void watch_disable_display(void);
 
 /** @brief Sets a pixel. Use this to manually set a pixel with a given common and segment number.
   *        See <a href="segmap.html">segmap.html</a>.
+  * @note This and all other display functions only draw into a RAM copy of the display. The LCD shows the
+  *       changes after the next call to watch_display_commit, which Movement makes after every app loop.
   * @param com the common pin, numbered from 0-2.
   * @param seg the segment pin, numbered from 0-23.
   */
@@ -116,10 +118,26 @@ void watch_set_pixel(uint8_t com, uint8_t seg);
   */
 void watch_clear_pixel(uint8_t com, uint8_t seg);
 
+/** @brief Replaces several pixels on one common line at once.
+  * @details The pixels selected by mask are cleared, then the pixels in value are set. This is what the
+  *          glyph tables use to draw a character with one update per common line.
+  * @param com the common pin, numbered from 0-2.
+  * @param mask the segments to replace, one bit per segment pin.
+  * @param value the segments to set, one bit per segment pin.
+  */
+void watch_update_pixels(uint8_t com, uint32_t mask, uint32_t value);
+
 /** @brief Clears all segments of the display, including incicators and the colon.
   */
 void watch_clear_display(void);
 
+/** @brief Pushes the segments that changed since the last commit to the LCD.
+  * @details Only the COM lines that were drawn to and actually differ from what the LCD shows are written.
+  *          You only need to call this yourself if you want a change to become visible before your loop
+  *          function returns, e.g. when animating with delay_ms.
+  */
+void watch_display_commit(void);
+
 /** @brief Displays a string at the given position, starting from the top left. There are ten digits.
            A space in any position will clear that digit.
   * @deprecated Use `watch_display_text` and `watch_display_text_with_fallback` instead.
@@ -284,4 +302,59 @@ bool watch_sleep_animation_is_running(void);
   *          On the custom LCD, it will turn off the crescent moon indicator.
   */
 void watch_stop_sleep_animation(void);
+
+/** @brief Blinks a set of segments until the animation is stopped.
+  * @details The segments show whatever is drawn there for one period and are blank for the next, so you
+  *          can keep drawing while they blink. If all segments are on SEG0 or SEG1, the SLCD blinks them on
+  *          its own without waking the CPU at all. Anything else is stepped by the overflow interrupt of the
+  *          SLCD's frame counter, which wakes the CPU once per frame: 1000 / duration times a second, i.e.
+  *          4 wakes a second for a 250 ms blink. The interrupt writes the frame itself, and Movement goes
+  *          back to sleep right after it without calling the face, so a wake costs a few microseconds
+  *          instead of a pass of the face's loop. This replaces any character or indicator blink, since
+  *          they share the blink hardware.
+  * @param segments The segments to blink, one word for each of COM0-COM3 with one bit per segment pin.
+  *                 See <a href="segmap.html">segmap.html</a>.
+  * @param duration The time the segments stay on and off, in milliseconds, from ~30 ms to ~8 s.
+  * @note Only one animation can run at a time; starting another one replaces it. Movement stops the
+  *       animation when the watch face changes and when the watch enters low energy mode.
+  */
+void watch_start_segment_blink(const uint32_t segments[4], uint32_t duration);
+
+/** @brief Blinks all segments of a location, like a setting that is being edited.
+  * @param location @see watch_position_t, the location you wish to blink.
+  * @param duration The time the location stays on and off, in milliseconds.
+  * @see watch_start_segment_blink
+  */
+void watch_start_text_blink(watch_position_t location, uint32_t duration);
+
+/** @brief Cycles one position through a sequence of characters, e.g. a busy spinner.
+  * @param position The position to animate, from 0-9 (or 10 on the custom LCD).
+  * @param frames The characters to show in turn, up to 8. The string is copied.
+  * @param duration The time each character is shown, in milliseconds. The CPU wakes once per character.
+  * @see watch_start_segment_blink for how animations are run.
+  */
+void watch_start_spinner(uint8_t position, const char *frames, uint32_t duration);
+
+/** @brief Scrolls text through the main line, from right to left, wrapping around.
+  * @param text The text to scroll, up to 32 characters; longer text is cut off. The string is copied.
+  * @param duration The time between two steps, in milliseconds. The CPU wakes once per step.
+  * @see watch_start_segment_blink for how animations are run.
+  */
+void watch_start_marquee(const char *text, uint32_t duration);
+
+/** @brief Stops the running animation, if any. The segments it used show what is drawn there again.
+  */
+void watch_stop_animation(void);
+
+/** @brief Checks if an animation is running.
+  * @return true if a blink, spinner or marquee started with the functions above is running.
+  */
+bool watch_animation_is_running(void);
+
+/** @brief Checks if the animation advanced a frame since the last call.
+  * @details The main loop uses this to tell a wake that only drew an animation frame, which needs no
+  *          further work, from one that has to be handled.
+  * @return true if the animation interrupt ran since the last call; the flag is cleared.
+  */
+bool watch_animation_take_wake(void);
 /// @}
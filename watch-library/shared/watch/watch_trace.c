@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "watch_trace.h"
+#include "watch_rtc.h"
+
+#if !(__EMSCRIPTEN__ || defined(WATCH_NATIVE))
+#include "sam.h"
+#endif
+
+#if WATCH_TRACE_RECORDS & (WATCH_TRACE_RECORDS - 1)
+#error WATCH_TRACE_RECORDS must be a power of two
+#endif
+
+static watch_trace_record_t _watch_trace_records[WATCH_TRACE_RECORDS];
+// free-running indices, so that head - tail is the number of records in the buffer.
+static uint16_t _watch_trace_head;
+static uint16_t _watch_trace_tail;
+static uint32_t _watch_trace_dropped;
+static uint8_t _watch_trace_face = WATCH_TRACE_NO_FACE;
+
+// records are logged from interrupts as well as from the main loop.
+typedef uint32_t _watch_trace_lock_t;
+
+#if __EMSCRIPTEN__ || defined(WATCH_NATIVE)
+static inline _watch_trace_lock_t _watch_trace_lock(void) { return 0; }
+static inline void _watch_trace_unlock(_watch_trace_lock_t lock) { (void)lock; }
+#else
+static inline _watch_trace_lock_t _watch_trace_lock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+static inline void _watch_trace_unlock(_watch_trace_lock_t lock) {
+    __set_PRIMASK(lock);
+}
+#endif
+
+static inline bool _watch_trace_is_full(void) {
+    return (uint16_t)(_watch_trace_head - _watch_trace_tail) >= WATCH_TRACE_RECORDS;
+}
+
+static inline uint16_t _watch_trace_dropped_arg(void) {
+    return _watch_trace_dropped > 0xFFFF ? 0xFFFF : _watch_trace_dropped;
+}
+
+static void _watch_trace_put(watch_trace_type_t type, uint16_t arg) {
+    watch_trace_record_t *record = &_watch_trace_records[_watch_trace_head & (WATCH_TRACE_RECORDS - 1)];
+    record->counter = watch_rtc_get_counter();
+    record->type = type;
+    record->face = _watch_trace_face;
+    record->arg = arg;
+    _watch_trace_head++;
+}
+
+void watch_trace(watch_trace_type_t type, uint16_t arg) {
+    _watch_trace_lock_t lock = _watch_trace_lock();
+
+    // the first record that fits after a gap is preceded by a record of the gap, so that the reader finds it where
+    // the records went missing, no matter how much of the buffer it has taken in the meantime.
+    if (_watch_trace_dropped && !_watch_trace_is_full()) {
+        _watch_trace_put(WATCH_TRACE_DROPPED, _watch_trace_dropped_arg());
+        _watch_trace_dropped = 0;
+    }
+
+    if (_watch_trace_is_full()) {
+        _watch_trace_dropped++;
+    } else {
+        _watch_trace_put(type, arg);
+    }
+
+    _watch_trace_unlock(lock);
+}
+
+void watch_trace_set_face(uint8_t face) {
+    _watch_trace_face = face;
+}
+
+uint16_t watch_trace_take(watch_trace_record_t *records, uint16_t max) {
+    uint16_t count = 0;
+    _watch_trace_lock_t lock = _watch_trace_lock();
+
+    while (count < max && _watch_trace_head != _watch_trace_tail) {
+        records[count++] = _watch_trace_records[_watch_trace_tail & (WATCH_TRACE_RECORDS - 1)];
+        _watch_trace_tail++;
+    }
+
+    // nothing was logged since the last gap, so the reader gets it after the last record, at its place.
+    if (_watch_trace_dropped && count < max && _watch_trace_head == _watch_trace_tail) {
+        records[count].counter = watch_rtc_get_counter();
+        records[count].type = WATCH_TRACE_DROPPED;
+        records[count].face = _watch_trace_face;
+        records[count].arg = _watch_trace_dropped_arg();
+        _watch_trace_dropped = 0;
+        count++;
+    }
+
+    _watch_trace_unlock(lock);
+    return count;
+}
@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2026 Konrad Rieck
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+////< @file watch_trace.h
+
+#include <stdint.h>
+
+/** @addtogroup trace Event Trace
+  * @brief Timestamped records of what the firmware does, for measuring latencies on a watch in the field.
+  * @details Build with TRACE=1 to enable tracing. The watch library and Movement then log compact records
+  *          into a RAM ring buffer, from interrupts as well as from the main loop, and the shell's trace
+  *          command streams them over USB (see utils/watch_trace). Without TRACE=1, WATCH_TRACE_EVENT compiles
+  *          to nothing.
+  *
+  *          Every record holds the RTC counter when it was logged, the face Movement was running at the
+  *          time and an argument that depends on the type. If the buffer is full, new records are dropped
+  *          and counted, and a WATCH_TRACE_DROPPED record takes their place in the stream, in front of the
+  *          next record that fits.
+  */
+/// @{
+
+/// Records in the ring buffer, a power of two. Each takes 8 bytes of RAM.
+#ifndef WATCH_TRACE_RECORDS
+#define WATCH_TRACE_RECORDS 256
+#endif
+
+/// Face index of records that were logged before Movement picked a face.
+#define WATCH_TRACE_NO_FACE 0xFF
+
+typedef enum {
+    WATCH_TRACE_END = 0,            ///< Ends a stream; arg is 0.
+    WATCH_TRACE_BUTTON_EDGE,        ///< A button pin changed; arg is the new level.
+    WATCH_TRACE_BUTTON_EVENT,       ///< The edge became an event; arg is the event type.
+    WATCH_TRACE_FACE_LOOP,          ///< A face's loop was called; arg is the event type.
+    WATCH_TRACE_FACE_LOOP_DONE,     ///< The loop returned; arg is whether the face may sleep.
+    WATCH_TRACE_DISPLAY_COMMIT,     ///< The LCD was updated; arg is the mask of changed COM lines.
+    WATCH_TRACE_TICK,               ///< The tick interrupt fired; arg is the tick frequency in Hz.
+    WATCH_TRACE_COMP,               ///< A comparator callback fired; arg is how many RTC ticks late, at most 0xFFFF.
+    WATCH_TRACE_DROPPED,            ///< Records were lost to a full buffer; arg is how many, at most 0xFFFF.
+} watch_trace_type_t;
+
+typedef struct {
+    uint32_t counter;   ///< RTC counter when the record was logged
+    uint8_t type;       ///< a watch_trace_type_t
+    uint8_t face;       ///< face index, or WATCH_TRACE_NO_FACE
+    uint16_t arg;
+} watch_trace_record_t;
+
+#ifdef WATCH_TRACE
+
+/** @brief Logs a record, stamped with the RTC counter and the current face.
+  * @param type The kind of record.
+  * @param arg The argument, as described for the type.
+  * @note Safe to call from interrupts. Use the WATCH_TRACE_EVENT macro, which compiles to nothing without TRACE=1.
+  */
+void watch_trace(watch_trace_type_t type, uint16_t arg);
+
+/** @brief Sets the face that the following records are logged for.
+  * @param face The face index, or WATCH_TRACE_NO_FACE.
+  */
+void watch_trace_set_face(uint8_t face);
+
+/** @brief Removes the oldest records from the buffer.
+  * @param records Receives the records, oldest first. If records were dropped, a WATCH_TRACE_DROPPED
+  *                record follows the last one that was logged before the buffer filled up.
+  * @param max The most records to take.
+  * @return the number of records taken.
+  */
+uint16_t watch_trace_take(watch_trace_record_t *records, uint16_t max);
+
+#define WATCH_TRACE_EVENT(type, arg) watch_trace((type), (arg))
+#define WATCH_TRACE_SET_FACE(face) watch_trace_set_face(face)
+
+#else
+
+#define WATCH_TRACE_EVENT(type, arg) ((void)0)
+#define WATCH_TRACE_SET_FACE(face) ((void)0)
+
+#endif
+
+/// @}
@@ -28,13 +28,21 @@
 #include "zones.h"
 
 const char * watch_utility_get_weekday(watch_date_time_t date_time) {
-    static const char weekdays[7][3] = {"MO", "TU", "WE", "TH", "FR", "SA", "SU"};
-    return weekdays[watch_utility_get_iso8601_weekday_number(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day) - 1];
+    return watch_utility_get_weekday_name(watch_utility_get_iso8601_weekday_number(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day));
 }
 
 const char * watch_utility_get_long_weekday(watch_date_time_t date_time) {
+    return watch_utility_get_long_weekday_name(watch_utility_get_iso8601_weekday_number(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day));
+}
+
+const char * watch_utility_get_weekday_name(uint8_t weekday) {
+    static const char weekdays[7][3] = {"MO", "TU", "WE", "TH", "FR", "SA", "SU"};
+    return weekdays[weekday - 1];
+}
+
+const char * watch_utility_get_long_weekday_name(uint8_t weekday) {
     static const char weekdays[7][4] = {"MON", "TUE", "WED", "THU", "FRI", "SAT", "SUN"};
-    return weekdays[watch_utility_get_iso8601_weekday_number(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day) - 1];
+    return weekdays[weekday - 1];
 }
 
 // Per ISO8601 week starts on Monday with index 1
@@ -55,6 +55,16 @@ const char * watch_utility_get_weekday(watch_date_time_t date_time);
   */
 const char * watch_utility_get_long_weekday(watch_date_time_t date_time);
 
+/** @brief Returns a two-letter weekday for the given ISO8601 weekday number.
+  * @param weekday The weekday, from 1 (Monday) to 7 (Sunday).
+  */
+const char * watch_utility_get_weekday_name(uint8_t weekday);
+
+/** @brief Returns a three-letter weekday for the given ISO8601 weekday number.
+  * @param weekday The weekday, from 1 (Monday) to 7 (Sunday).
+  */
+const char * watch_utility_get_long_weekday_name(uint8_t weekday);
+
 /** @brief Returns a number between 1-7 representing the weekday according to ISO8601 : week starts on Monday and has index 1, Sunday has index 7
  * @param year The year of the date
  * @param month The month of the date (1-12)
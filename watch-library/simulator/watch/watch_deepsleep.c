@@ -77,6 +77,9 @@ uint32_t watch_get_backup_data(uint8_t reg) {
 void watch_enter_sleep_mode(void) {
     // TODO: (a2) hook to UI
 
+    // the display stays on while we sleep, so make sure it shows what was drawn.
+    watch_display_commit();
+
     // disable tick interrupt
     watch_rtc_disable_all_periodic_callbacks();
 
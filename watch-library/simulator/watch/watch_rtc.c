@@ -27,6 +27,7 @@
 #include "watch_rtc.h"
 #include "watch_main_loop.h"
 #include "watch_utility.h"
+#include "watch_calendar.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -95,7 +96,11 @@ void watch_rtc_set_date_time(rtc_date_time_t date_time) {
 }
 
 rtc_date_time_t watch_rtc_get_date_time(void) {
-    return watch_utility_date_time_from_unix_time(watch_rtc_get_unix_time(), 0);
+    static watch_calendar_t calendar = {0};
+
+    watch_calendar_update(&calendar, watch_rtc_get_unix_time(), 0);
+
+    return calendar.date_time;
 }
 
 void watch_rtc_set_unix_time(unix_timestamp_t unix_time) {
@@ -22,6 +22,8 @@
  * SOFTWARE.
  */
 
+#include <string.h>
+
 #include "watch_slcd.h"
 #include "watch_common_display.h"
 
@@ -31,11 +33,20 @@
 //////////////////////////////////////////////////////////////////////////////////////////
 // Segmented Display
 
+// RAM copy of the display, one word per COM line like the SLCD's SDATA registers. Drawing goes here, and
+// watch_display_commit pushes the segments that changed to the page.
+#define SLCD_NUM_COMS 8
+
+static uint32_t frame[SLCD_NUM_COMS];
+static uint32_t committed[SLCD_NUM_COMS];
+static uint8_t dirty_coms;
+
 static char blink_character;
 static bool blink_state;
 static long blink_interval_id = - 1;
 static bool tick_state;
 static long tick_interval_id = -1;
+static long animation_interval_id = -1;
 
 watch_lcd_type_t watch_get_lcd_type(void) {
 #if defined(FORCE_CUSTOM_LCD_TYPE)
@@ -49,6 +60,7 @@ void watch_enable_display(void) {
 #if defined(FORCE_CUSTOM_LCD_TYPE)
     _watch_update_indicator_segments();
 #endif
+    _watch_update_glyph_table();
 
 #if defined(FORCE_CUSTOM_LCD_TYPE)
     EM_ASM({document.getElementById("custom").style.display = "";});
@@ -58,6 +70,12 @@ void watch_enable_display(void) {
     EM_ASM({document.getElementById("classic").style.display = "";});
 #endif
 
+    // start from a blank page, so that the committed copy matches it.
+    EM_ASM({
+        document.querySelectorAll("[data-com][data-seg]")
+            .forEach((e) => e.style.opacity = 0);
+    });
+    memset(committed, 0, sizeof(committed));
     watch_clear_display();
 }
 
@@ -68,30 +86,79 @@ void watch_disable_display(void) {
 }
 
 void watch_set_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 1);
-    }, com, seg);
+    if (com >= SLCD_NUM_COMS || seg >= 32) return;
+    frame[com] |= 1u << seg;
+    dirty_coms |= 1u << com;
 }
 
 void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 0);
-    }, com, seg);
+    if (com >= SLCD_NUM_COMS || seg >= 32) return;
+    frame[com] &= ~(1u << seg);
+    dirty_coms |= 1u << com;
+}
+
+void watch_update_pixels(uint8_t com, uint32_t mask, uint32_t value) {
+    if (com >= SLCD_NUM_COMS) return;
+    frame[com] = (frame[com] & ~mask) | value;
+    dirty_coms |= 1u << com;
 }
 
 void watch_clear_display(void) {
-    EM_ASM({
-        document.querySelectorAll("[data-com][data-seg]")
-            .forEach((e) => e.style.opacity = 0);
-    });
+    memset(frame, 0, sizeof(frame));
+    dirty_coms = 0xFF;
+}
+
+static void _watch_slcd_show(uint8_t com, uint32_t value) {
+    uint32_t changed = value ^ committed[com];
+    while (changed) {
+        uint8_t seg = __builtin_ctz(changed);
+        changed &= changed - 1;
+        EM_ASM({
+            document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
+                .forEach((e) => e.style.opacity = $2);
+        }, com, seg, (value >> seg) & 1);
+    }
+    committed[com] = value;
+}
+
+void watch_display_commit(void) {
+    while (dirty_coms) {
+        uint8_t com = __builtin_ctz(dirty_coms);
+        dirty_coms &= dirty_coms - 1;
+        _watch_slcd_show(com, _watch_animation_merge(com, frame[com]));
+    }
+}
+
+static void watch_invoke_animation_callback(void *userData) {
+    (void) userData;
+    _watch_animation_step();
+
+    // like the SLCD interrupt, only touch the animated segments.
+    for (uint8_t com = 0; com < GLYPH_NUM_COMS; com++) {
+        uint32_t owned = _watch_animation.owned[com];
+        if (!owned) continue;
+        _watch_slcd_show(com, (committed[com] & ~owned) | (_watch_animation_merge(com, frame[com]) & owned));
+    }
+}
+
+void _watch_slcd_start_animation(uint32_t duration) {
+    if (animation_interval_id != -1) emscripten_clear_interval(animation_interval_id);
+    animation_interval_id = emscripten_set_interval(watch_invoke_animation_callback, (double)duration, NULL);
+    dirty_coms |= (1u << GLYPH_NUM_COMS) - 1;
+}
+
+void _watch_slcd_stop_animation(void) {
+    if (animation_interval_id != -1) emscripten_clear_interval(animation_interval_id);
+    animation_interval_id = -1;
+    dirty_coms |= (1u << GLYPH_NUM_COMS) - 1;
 }
 
 static void watch_invoke_blink_callback(void *userData) {
     blink_state = !blink_state;
     watch_display_character(blink_state ? blink_character : ' ', 7);
     watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
+    // the SLCD animates on its own, so the change is visible right away.
+    watch_display_commit();
 }
 
 void watch_start_character_blink(char character, uint32_t duration) {
@@ -123,6 +190,7 @@ static void watch_invoke_tick_callback(void *userData) {
         watch_clear_pixel(0, 3);
         watch_set_pixel(0, 2);
     }
+    watch_display_commit();
 }
 
 void watch_start_sleep_animation(uint32_t duration) {